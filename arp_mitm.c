@@ -61,10 +61,6 @@ static void* arp_mitm_thread(void* vargp) {
     return NULL;
 }
 
-static int arp_table_key_cmp(const void* key_a, const void* key_b) {
-    return *((uint32_t *)key_a) - *((uint32_t *)key_b);
-}
-
 static void arp_test_stuff(resetter_context* ctx) {
     struct sockaddr_in addr;
     memset(&addr, 0, sizeof(struct sockaddr_in));
@@ -102,7 +98,8 @@ int start_arp_mitm_thread(thread_node* thread, char* device) {
 
     // Init ARP table
     ctx->arp_table = malloc(sizeof(hash_table));
-    if (hash_table_init(ctx->arp_table, 100, arp_table_key_cmp, NULL) != 0) {
+    // IPv4 address (network byte order) => MAC address, both stored inline
+    if (hash_table_init_fixed(ctx->arp_table, 128, sizeof(uint32_t), ETHER_ADDR_LEN) != 0) {
         return -1;
     }
 
@@ -129,13 +126,14 @@ static void unpoison_arp_table_entry(
 ) {
     resetter_context* ctx = (resetter_context *)user_arg;
     struct sockaddr_in addr;
+    char eth_str[NET_UTILS_ETHER_STR_SIZE];
 
     memset(&addr, 0, sizeof(struct sockaddr_in));
     addr.sin_addr.s_addr = *((uint32_t *)entry->key);
 
     printf("Unpoisoning: %s -> %s\n",
            inet_ntoa(addr.sin_addr),
-           net_utils_ether_ntoa((uint8_t *)entry->value));
+           net_utils_ether_format((uint8_t *)entry->value, eth_str));
 
     if (send_arp_reply_packet(ctx, addr, BROADCAST_ETH_ADDR) != 0) {
         fprintf(stderr, "Failed to unpoison!\n");
@@ -188,10 +186,13 @@ int send_arp_reply_packet(
     }
 
     const uint8_t* eth_src = local_mac_addr->ether_addr_octet;
-    printf("Telling %s ", net_utils_ether_ntoa(victim_eth_addr));
-    printf("that %s is-at %s\n",
+    char victim_eth_str[NET_UTILS_ETHER_STR_SIZE];
+    char eth_src_str[NET_UTILS_ETHER_STR_SIZE];
+
+    printf("Telling %s that %s is-at %s\n",
+           net_utils_ether_format(victim_eth_addr, victim_eth_str),
            inet_ntoa(addr.sin_addr),
-           net_utils_ether_ntoa(eth_src));
+           net_utils_ether_format(eth_src, eth_src_str));
 
     // Build ARP packet
     arp_tag = libnet_build_arp(
@@ -356,37 +357,35 @@ static void on_arp_packet_captured(
         return;
     }
 
+    char shost_str[NET_UTILS_ETHER_STR_SIZE];
+    char dhost_str[NET_UTILS_ETHER_STR_SIZE];
+    char sha_str[NET_UTILS_ETHER_STR_SIZE];
+
     // Adding poison
     switch (htons(arp_hdr->ar_op)) {
         case ARPOP_REQUEST:
             // req to resolve address
-            printf("arp %s -> ", net_utils_ether_ntoa(eth_hdr->ether_shost));
-            printf("%s who-has %s ", net_utils_ether_ntoa(eth_hdr->ether_dhost), inet_ntoa(daddr.sin_addr));
-            printf("tell %s (%s)\n", inet_ntoa(saddr.sin_addr), net_utils_ether_ntoa(arp_payload->ar_sha));
+            printf("arp %s -> %s who-has %s ",
+                   net_utils_ether_format(eth_hdr->ether_shost, shost_str),
+                   net_utils_ether_format(eth_hdr->ether_dhost, dhost_str),
+                   inet_ntoa(daddr.sin_addr));
+            printf("tell %s (%s)\n", inet_ntoa(saddr.sin_addr), net_utils_ether_format(arp_payload->ar_sha, sha_str));
 
         // TODO: if IP is in ctx->arp_table, send spoofed reply saying it's from this machine's MAC
             break;
 
         case ARPOP_REPLY:
             // resp to previous request
-            printf("arp %s -> ", net_utils_ether_ntoa(eth_hdr->ether_shost));
-            printf("%s reply %s is-at ",
-                   net_utils_ether_ntoa(eth_hdr->ether_dhost),
-                   inet_ntoa(saddr.sin_addr));
-            printf("%s\n", net_utils_ether_ntoa(arp_payload->ar_sha));
+            printf("arp %s -> %s reply %s is-at %s\n",
+                   net_utils_ether_format(eth_hdr->ether_shost, shost_str),
+                   net_utils_ether_format(eth_hdr->ether_dhost, dhost_str),
+                   inet_ntoa(saddr.sin_addr),
+                   net_utils_ether_format(arp_payload->ar_sha, sha_str));
 
             if (hash_table_get(ctx->arp_table, &saddr.sin_addr.s_addr) == NULL) {
-                hash_table_entry* entry = hash_table_init_entry(
-                    &saddr.sin_addr.s_addr, sizeof(uint32_t),
-                    arp_payload->ar_sha, sizeof(arp_payload->ar_sha));
-                if (entry == NULL) {
-                    return;
-                }
-
-                if (hash_table_set_entry(ctx->arp_table, entry) != 0) {
+                if (hash_table_set(ctx->arp_table, &saddr.sin_addr.s_addr, arp_payload->ar_sha) != 0) {
                     fprintf(stderr, "Error updating ARP table for %s",
                             inet_ntoa(saddr.sin_addr));
-                    hash_table_destroy_entry(entry);
                     return;
                 }
 
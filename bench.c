@@ -0,0 +1,24 @@
+#include <stdlib.h>
+
+#include "benches/array_list_bench.h"
+#include "benches/hash_bench.h"
+#include "benches/hash_table_bench.h"
+#include "benches/linked_list_bench.h"
+#include "benches/net_utils_bench.h"
+#include "benches/prefix_set_bench.h"
+#include "benches/ttl_map_bench.h"
+
+int main(int argc, char** argv) {
+    // Setup
+    srand(0);
+
+    run_array_list_benches();
+    run_hash_table_benches();
+    run_hash_benches();
+    run_linked_list_benches();
+    run_net_utils_benches();
+    run_prefix_set_benches();
+    run_ttl_map_benches();
+
+    return 0;
+}
@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "array_list_bench.h"
+#include "bench_utils.h"
+#include "../utils/array_list.h"
+#include "../utils/typed_array_list.h"
+
+DECLARE_ARRAY_LIST(bench_u32_list, uint32_t)
+
+/**
+ * Number of values in each benchmarked list
+ */
+#define VALUE_COUNT (1 << 20)
+
+/**
+ * Number of passes over each benchmarked list
+ */
+#define PASS_COUNT 8
+
+static uint32_t values[VALUE_COUNT];
+
+/**
+ * Benchmark array_list (values are pointers to separately stored values)
+ */
+static void bench_array_list(void) {
+    array_list lst;
+
+    array_list_init(&lst, sizeof(void *), 16);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < VALUE_COUNT; ++i) {
+        array_list_push_tail(&lst, &values[i]);
+    }
+    bench_report("array_list push_tail", VALUE_COUNT, start);
+
+    start = bench_now_ns();
+    uint64_t sum = 0;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        for (size_t i = 0; i < VALUE_COUNT; ++i) {
+            sum += *(uint32_t *)array_list_get_at(&lst, i);
+        }
+    }
+    bench_report("array_list get_at", (size_t)VALUE_COUNT * PASS_COUNT, start);
+    bench_sink += sum;
+
+    array_list_destroy(&lst);
+}
+
+/**
+ * Benchmark appending to an array list that starts empty, at increasing sizes
+ * (the time per value stays flat if appending is amortized O(1))
+ */
+static void bench_array_list_growth(void) {
+    static const size_t counts[] = {1250000, 2500000, 5000000, 10000000};
+
+    for (size_t k = 0; k < sizeof(counts) / sizeof(counts[0]); ++k) {
+        array_list lst;
+        char bench_name[64];
+
+        array_list_init(&lst, sizeof(void *), 0);
+
+        const uint64_t start = bench_now_ns();
+        for (size_t i = 0; i < counts[k]; ++i) {
+            array_list_push_tail(&lst, &values[i % VALUE_COUNT]);
+        }
+        snprintf(bench_name, sizeof(bench_name), "array_list push_tail x%zu from empty", counts[k]);
+        bench_report(bench_name, counts[k], start);
+
+        array_list_destroy(&lst);
+    }
+}
+
+/**
+ * Benchmark using an array list as a FIFO queue at increasing queue lengths
+ * (the time per value stays flat if popping the head is O(1))
+ */
+static void bench_array_list_queue(void) {
+    static const size_t lengths[] = {16, 1024, 65536};
+    static void* batch[64];
+
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]); ++k) {
+        array_list lst;
+        char bench_name[64];
+
+        array_list_init(&lst, sizeof(void *), 0);
+        for (size_t i = 0; i < lengths[k]; ++i) {
+            array_list_push_tail(&lst, &values[i]);
+        }
+
+        uint64_t start = bench_now_ns();
+        for (size_t i = 0; i < VALUE_COUNT; ++i) {
+            array_list_push_tail(&lst, &values[i]);
+            bench_sink += *(uint32_t *)array_list_pop_head(&lst);
+        }
+        snprintf(bench_name, sizeof(bench_name), "array_list queue length %zu", lengths[k]);
+        bench_report(bench_name, VALUE_COUNT, start);
+
+        start = bench_now_ns();
+        for (size_t i = 0; i < VALUE_COUNT; i += 64) {
+            for (size_t j = 0; j < 64; ++j) {
+                batch[j] = &values[i + j];
+            }
+            array_list_push_tail_n(&lst, batch, 64);
+            array_list_pop_head_n(&lst, batch, 64);
+            bench_sink += *(uint32_t *)batch[63];
+        }
+        snprintf(bench_name, sizeof(bench_name), "array_list queue length %zu (x64 batches)", lengths[k]);
+        bench_report(bench_name, VALUE_COUNT, start);
+
+        array_list_destroy(&lst);
+    }
+}
+
+/**
+ * Small struct stored by the value storage benchmark
+ */
+typedef struct bench_record {
+    uint32_t key;
+    uint32_t count;
+    uint64_t total;
+} bench_record;
+
+/**
+ * Benchmark summing a field of small structs held by pointer (allocated one
+ * by one, so scattered over the heap) against held inline (ARRAY_LIST_VALUES)
+ */
+static void bench_array_list_values(void) {
+    array_list pointers;
+    array_list records;
+    array_list_span spans[2];
+
+    array_list_init(&pointers, sizeof(bench_record), 0);
+    array_list_init_values(&records, sizeof(bench_record), 0);
+
+    for (uint32_t i = 0; i < VALUE_COUNT; ++i) {
+        bench_record* p_record = malloc(sizeof(bench_record));
+        p_record->key = i;
+        p_record->count = 1;
+        p_record->total = i;
+        array_list_push_tail(&pointers, p_record);
+    }
+
+    // Heap objects of a long-lived program are rarely allocated in list order
+    for (size_t i = VALUE_COUNT - 1; i > 0; --i) {
+        const size_t j = (i * 2654435761U) % (i + 1);
+        void* tmp = pointers.array[i];
+        pointers.array[i] = pointers.array[j];
+        pointers.array[j] = tmp;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < VALUE_COUNT; ++i) {
+        bench_record* p_record = array_list_emplace_tail(&records);
+        p_record->key = i;
+        p_record->count = 1;
+        p_record->total = i;
+    }
+    bench_report("array_list values emplace_tail", VALUE_COUNT, start);
+
+    start = bench_now_ns();
+    uint64_t sum = 0;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        const size_t span_count = array_list_get_spans(&pointers, spans);
+        for (size_t k = 0; k < span_count; ++k) {
+            for (size_t i = 0; i < spans[k].size; ++i) {
+                sum += ((bench_record *)spans[k].values[i])->total;
+            }
+        }
+    }
+    bench_report("array_list pointers sum 16B structs", (size_t)VALUE_COUNT * PASS_COUNT, start);
+
+    start = bench_now_ns();
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        const size_t span_count = array_list_get_spans(&records, spans);
+        for (size_t k = 0; k < span_count; ++k) {
+            const bench_record* p_records = spans[k].data;
+            for (size_t i = 0; i < spans[k].size; ++i) {
+                sum += p_records[i].total;
+            }
+        }
+    }
+    bench_report("array_list values sum 16B structs", (size_t)VALUE_COUNT * PASS_COUNT, start);
+    bench_sink += sum;
+
+    for (size_t i = 0; i < pointers.size; ++i) {
+        free(pointers.array[i]);
+    }
+    array_list_destroy(&pointers);
+    array_list_destroy(&records);
+}
+
+static int cmp_u32(const void* value_a, const void* value_b) {
+    const uint32_t a = *(const uint32_t *)value_a;
+    const uint32_t b = *(const uint32_t *)value_b;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * Benchmark sorting random 32-bit values stored inline, and looking them up
+ * once sorted
+ */
+static void bench_array_list_sort(void) {
+    static uint32_t shuffled[VALUE_COUNT];
+    array_list lst;
+    uint32_t state = 2463534242U;
+
+    for (size_t i = 0; i < VALUE_COUNT; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        shuffled[i] = state;
+    }
+
+    array_list_init_values(&lst, sizeof(uint32_t), VALUE_COUNT);
+
+    memcpy(lst.data, shuffled, sizeof(shuffled));
+    uint64_t start = bench_now_ns();
+    qsort(lst.data, VALUE_COUNT, sizeof(uint32_t), cmp_u32);
+    bench_report("qsort (reference)", VALUE_COUNT, start);
+
+    array_list_push_tail_n(&lst, shuffled, VALUE_COUNT);
+    start = bench_now_ns();
+    array_list_sort(&lst, cmp_u32);
+    bench_report("array_list_sort", VALUE_COUNT, start);
+
+    lst.size = 0;
+    array_list_push_tail_n(&lst, shuffled, VALUE_COUNT);
+    start = bench_now_ns();
+    array_list_radix_sort(&lst, 0, sizeof(uint32_t));
+    bench_report("array_list_radix_sort", VALUE_COUNT, start);
+
+    start = bench_now_ns();
+    size_t found = 0;
+    for (size_t i = 0; i < VALUE_COUNT; ++i) {
+        found += array_list_binary_search(&lst, &shuffled[i], cmp_u32) != (size_t)-1;
+    }
+    bench_report("array_list_binary_search 1M values", VALUE_COUNT, start);
+    bench_sink += found;
+
+    array_list_destroy(&lst);
+}
+
+/**
+ * Benchmark the macro-generated typed array list
+ */
+static void bench_typed_array_list(void) {
+    bench_u32_list lst;
+
+    bench_u32_list_init(&lst, 16);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < VALUE_COUNT; ++i) {
+        bench_u32_list_push_tail(&lst, values[i]);
+    }
+    bench_report("typed_array_list push_tail", VALUE_COUNT, start);
+
+    start = bench_now_ns();
+    uint64_t sum = 0;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        for (size_t i = 0; i < VALUE_COUNT; ++i) {
+            sum += *bench_u32_list_get_at(&lst, i);
+        }
+    }
+    bench_report("typed_array_list get_at", (size_t)VALUE_COUNT * PASS_COUNT, start);
+    bench_sink += sum;
+
+    bench_u32_list_destroy(&lst);
+}
+
+void run_array_list_benches(void) {
+    for (uint32_t i = 0; i < VALUE_COUNT; ++i) {
+        values[i] = i;
+    }
+
+    bench_array_list();
+    bench_array_list_growth();
+    bench_array_list_queue();
+    bench_array_list_values();
+    bench_array_list_sort();
+    bench_typed_array_list();
+}
@@ -0,0 +1,11 @@
+#ifndef __ARRAY_LIST_BENCH_H__
+#define __ARRAY_LIST_BENCH_H__
+
+/**
+ * Compare push/get of array_list against the macro-generated typed array list
+ * and measure array_list used as a queue, with values stored inline, and
+ * sorted
+ */
+void run_array_list_benches(void);
+
+#endif
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_utils.h"
+
+volatile uint64_t bench_sink;
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void bench_report(const char* name, const size_t ops, const uint64_t start_ns) {
+    const uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+    printf("%-40s %10zu ops %10.2f ns/op\n", name, ops, (double)elapsed_ns / ops);
+}
@@ -0,0 +1,28 @@
+#ifndef __BENCH_UTILS_H__
+#define __BENCH_UTILS_H__
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+/**
+ * Results are accumulated here so the compiler can't drop benchmarked work
+ */
+extern volatile uint64_t bench_sink;
+
+/**
+ * Get current time of a monotonic clock
+ *
+ * @return Time in nanoseconds
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * Print the time per operation of a benchmark
+ *
+ * @param name Benchmark name
+ * @param ops Number of operations that were timed
+ * @param start_ns Start time (from bench_now_ns())
+ */
+void bench_report(const char* name, size_t ops, uint64_t start_ns);
+
+#endif
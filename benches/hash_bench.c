@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "hash_bench.h"
+#include "bench_utils.h"
+#include "../utils/murmur3.h"
+#include "../utils/wyhash.h"
+
+/**
+ * Total number of bytes hashed by each benchmark
+ */
+#define BYTE_COUNT (1 << 28)
+
+/**
+ * Short key: a dotted IPv4 address
+ */
+static const char short_key[] = "192.168.100.200";
+
+/**
+ * Long key (filled with a pattern)
+ */
+static char long_key[4096];
+
+/**
+ * Benchmark names
+ */
+static const char* name_short = "hash %s (16 B)";
+static const char* name_long = "hash %s (4 KiB)";
+
+/**
+ * Report the throughput of a benchmark
+ *
+ * @param format Benchmark name format
+ * @param hash_name Hash function name
+ * @param ops Number of keys hashed
+ * @param start_ns Start time
+ */
+static void report(const char* format, const char* hash_name, const size_t ops, const uint64_t start_ns) {
+    char bench_name[64];
+
+    snprintf(bench_name, sizeof(bench_name), format, hash_name);
+    bench_report(bench_name, ops, start_ns);
+}
+
+void run_hash_benches(void) {
+    const size_t short_ops = BYTE_COUNT / sizeof(short_key);
+    const size_t long_ops = BYTE_COUNT / sizeof(long_key);
+    uint64_t out[2];
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < sizeof(long_key) - 1; ++i) {
+        long_key[i] = 'a' + i % 26;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < short_ops; ++i) {
+        sum += murmur3((const uint8_t *)short_key, strlen(short_key), i);
+    }
+    report(name_short, "murmur3 + strlen", short_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < short_ops; ++i) {
+        sum += murmur3_str(short_key, i);
+    }
+    report(name_short, "murmur3_str", short_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < short_ops; ++i) {
+        sum += wyhash(short_key, strlen(short_key), i);
+    }
+    report(name_short, "wyhash + strlen", short_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < short_ops; ++i) {
+        sum += wyhash_str(short_key, i);
+    }
+    report(name_short, "wyhash_str", short_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < long_ops; ++i) {
+        sum += murmur3((const uint8_t *)long_key, sizeof(long_key), i);
+    }
+    report(name_long, "murmur3", long_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < long_ops; ++i) {
+        murmur3_x64_128(long_key, sizeof(long_key), i, out);
+        sum += out[0];
+    }
+    report(name_long, "murmur3_x64_128", long_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < long_ops; ++i) {
+        sum += wyhash(long_key, sizeof(long_key), i);
+    }
+    report(name_long, "wyhash", long_ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < long_ops; ++i) {
+        sum += wyhash_str(long_key, i);
+    }
+    report(name_long, "wyhash_str", long_ops, start);
+
+    bench_sink += sum;
+}
@@ -0,0 +1,9 @@
+#ifndef __HASH_BENCH_H__
+#define __HASH_BENCH_H__
+
+/**
+ * Compare the throughput of hash functions on short and long keys
+ */
+void run_hash_benches(void);
+
+#endif
@@ -0,0 +1,349 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hash_table_bench.h"
+#include "bench_utils.h"
+#include "../utils/hash_table.h"
+#include "../utils/typed_hash_table.h"
+
+#define u32_eq(a, b) ((a) == (b))
+
+DECLARE_HASH_TABLE(bench_u32_table, uint32_t, uint32_t, typed_hash_u32, u32_eq)
+
+/**
+ * Number of entries in each benchmarked table
+ */
+#define ENTRY_COUNT (1 << 18)
+
+/**
+ * Number of lookups in each benchmarked table
+ */
+#define LOOKUP_COUNT (1 << 22)
+
+/**
+ * Number of entries in the tables of the batch benchmarks (much larger than
+ * the last level cache)
+ */
+#define BATCH_ENTRY_COUNT (1 << 23)
+
+/**
+ * Number of keys per hash_table_get_many() / hash_table_set_many() call
+ */
+#define BATCH_KEYS 64
+
+/**
+ * Number of times the iteration benchmark walks each table
+ */
+#define ITER_ROUNDS 64
+
+static uint32_t keys[ENTRY_COUNT];
+static uint32_t values[ENTRY_COUNT];
+
+/**
+ * Keys that are never set
+ */
+static uint32_t missing_keys[ENTRY_COUNT];
+
+static int u32_key_cmp(const void* key_a, const void* key_b) {
+    return *(const uint32_t *)key_a != *(const uint32_t *)key_b;
+}
+
+static uint32_t u32_key_hash(const void* key) {
+    return typed_hash_u32(*(const uint32_t *)key);
+}
+
+/**
+ * Key looked up by the i-th lookup (spread over the whole table)
+ */
+static size_t lookup_index(const size_t i) {
+    return (i * 40503) & (ENTRY_COUNT - 1);
+}
+
+/**
+ * Benchmark a hash_table that was initialized (but is still empty)
+ *
+ * @param ht Hash table
+ * @param name Benchmark name prefix
+ */
+static void bench_hash_table(hash_table* ht, const char* name) {
+    char bench_name[64];
+
+    snprintf(bench_name, sizeof(bench_name), "%s set", name);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        hash_table_set(ht, &keys[i], &values[i]);
+    }
+    bench_report(bench_name, ENTRY_COUNT, start);
+
+    snprintf(bench_name, sizeof(bench_name), "%s get", name);
+    start = bench_now_ns();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        sum += *(uint32_t *)hash_table_get(ht, &keys[lookup_index(i)]);
+    }
+    bench_report(bench_name, LOOKUP_COUNT, start);
+    bench_sink += sum;
+
+    hash_table_destroy(ht);
+}
+
+/**
+ * Benchmark the macro-generated typed hash table
+ */
+static void bench_typed_hash_table(void) {
+    bench_u32_table ht;
+
+    bench_u32_table_init(&ht, 16);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        bench_u32_table_set(&ht, keys[i], values[i]);
+    }
+    bench_report("typed_hash_table set", ENTRY_COUNT, start);
+
+    start = bench_now_ns();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        sum += *bench_u32_table_get(&ht, keys[lookup_index(i)]);
+    }
+    bench_report("typed_hash_table get", LOOKUP_COUNT, start);
+    bench_sink += sum;
+
+    bench_u32_table_destroy(&ht);
+}
+
+/**
+ * Benchmark lookups of missing keys, then of present keys, in a hash_table
+ *
+ * @param ht Hash table
+ * @param name Benchmark name
+ */
+static void bench_lookups(hash_table* ht, const char* name) {
+    char bench_name[64];
+    uint64_t found = 0;
+
+    snprintf(bench_name, sizeof(bench_name), "%s get (missing)", name);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        found += hash_table_get(ht, &missing_keys[lookup_index(i)]) != NULL;
+    }
+    bench_report(bench_name, LOOKUP_COUNT, start);
+
+    snprintf(bench_name, sizeof(bench_name), "%s get", name);
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        found += hash_table_get(ht, &keys[lookup_index(i)]) != NULL;
+    }
+    bench_report(bench_name, LOOKUP_COUNT, start);
+    bench_sink += found;
+}
+
+/**
+ * Benchmark a hash_table that was initialized (but is still empty) without,
+ * then with, an attached Bloom filter
+ *
+ * @param ht Hash table
+ * @param name Benchmark name prefix
+ */
+static void bench_filter(hash_table* ht, const char* name) {
+    char bench_name[64];
+    bloom_filter filter;
+
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        hash_table_set(ht, &keys[i], &values[i]);
+    }
+
+    bench_lookups(ht, name);
+
+    bloom_filter_init(&filter, ENTRY_COUNT, 10);
+    hash_table_attach_filter(ht, &filter);
+
+    snprintf(bench_name, sizeof(bench_name), "%s + filter", name);
+    bench_lookups(ht, bench_name);
+
+    hash_table_destroy(ht);
+    bloom_filter_destroy(&filter);
+}
+
+/**
+ * Benchmark batch sets and gets against single ones, on a large table
+ *
+ * @param init Hash table initializer (uint32_t keys)
+ * @param name Benchmark name prefix
+ */
+static void bench_batch(int (*init)(hash_table* ht), const char* name) {
+    char bench_name[64];
+    hash_table ht;
+    uint32_t* batch_keys = malloc(BATCH_ENTRY_COUNT * sizeof(uint32_t));
+    void** key_ptrs = malloc(BATCH_ENTRY_COUNT * sizeof(void*));
+    void** lookup_ptrs = malloc(LOOKUP_COUNT * sizeof(void*));
+    void* found[BATCH_KEYS];
+    uint64_t sum = 0;
+
+    if (batch_keys == NULL || key_ptrs == NULL || lookup_ptrs == NULL) {
+        perror("bench_batch: malloc() failed");
+        free(batch_keys);
+        free(key_ptrs);
+        free(lookup_ptrs);
+        return;
+    }
+
+    for (uint32_t i = 0; i < BATCH_ENTRY_COUNT; ++i) {
+        batch_keys[i] = i * 2654435761u;
+        key_ptrs[i] = &batch_keys[i];
+    }
+
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        lookup_ptrs[i] = &batch_keys[(i * 40503) & (BATCH_ENTRY_COUNT - 1)];
+    }
+
+    init(&ht);
+    snprintf(bench_name, sizeof(bench_name), "%s set", name);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < BATCH_ENTRY_COUNT; ++i) {
+        hash_table_set(&ht, key_ptrs[i], key_ptrs[i]);
+    }
+    bench_report(bench_name, BATCH_ENTRY_COUNT, start);
+    hash_table_destroy(&ht);
+
+    init(&ht);
+    snprintf(bench_name, sizeof(bench_name), "%s set_many", name);
+    start = bench_now_ns();
+    for (size_t i = 0; i < BATCH_ENTRY_COUNT; i += BATCH_KEYS) {
+        hash_table_set_many(&ht, key_ptrs + i, key_ptrs + i, BATCH_KEYS);
+    }
+    bench_report(bench_name, BATCH_ENTRY_COUNT, start);
+
+    snprintf(bench_name, sizeof(bench_name), "%s get", name);
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        sum += hash_table_get(&ht, lookup_ptrs[i]) != NULL;
+    }
+    bench_report(bench_name, LOOKUP_COUNT, start);
+
+    snprintf(bench_name, sizeof(bench_name), "%s get_many", name);
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUP_COUNT; i += BATCH_KEYS) {
+        sum += hash_table_get_many(&ht, (const void* const*)lookup_ptrs + i, BATCH_KEYS, found);
+    }
+    bench_report(bench_name, LOOKUP_COUNT, start);
+    bench_sink += sum;
+
+    hash_table_destroy(&ht);
+    free(batch_keys);
+    free(key_ptrs);
+    free(lookup_ptrs);
+}
+
+/**
+ * Iterator callback function that sums uint32_t values
+ *
+ * @param entry Iterated hash table entry
+ * @param _index Iteration index (ignored)
+ * @param sum Sum (uint64_t)
+ */
+static void sum_iter_func(const hash_table_entry* entry, const size_t _index, void* sum) {
+    *(uint64_t *)sum += *(const uint32_t *)entry->value;
+}
+
+/**
+ * Benchmark iterating a table that grew to ENTRY_COUNT entries, then had 7 in
+ * 8 of them deleted, with the callback and cursor APIs
+ *
+ * @param init Hash table initializer (uint32_t keys)
+ * @param name Benchmark name prefix
+ */
+static void bench_iter(int (*init)(hash_table* ht), const char* name) {
+    char bench_name[64];
+    hash_table ht;
+    hash_table_cursor cursor;
+    const hash_table_entry* p_entry;
+    uint64_t sum = 0;
+
+    init(&ht);
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        hash_table_set(&ht, &keys[i], &values[i]);
+    }
+
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        if (i % 8 != 0) {
+            hash_table_del(&ht, &keys[i]);
+        }
+    }
+
+    snprintf(bench_name, sizeof(bench_name), "%s iter (sparse)", name);
+    uint64_t start = bench_now_ns();
+    for (int round = 0; round < ITER_ROUNDS; ++round) {
+        hash_table_iter(&ht, sum_iter_func, &sum);
+    }
+    bench_report(bench_name, ITER_ROUNDS * hash_table_size(&ht), start);
+
+    snprintf(bench_name, sizeof(bench_name), "%s cursor (sparse)", name);
+    start = bench_now_ns();
+    for (int round = 0; round < ITER_ROUNDS; ++round) {
+        hash_table_cursor_init(&cursor, &ht);
+        while ((p_entry = hash_table_cursor_next(&cursor)) != NULL) {
+            sum += *(const uint32_t *)p_entry->value;
+        }
+    }
+    bench_report(bench_name, ITER_ROUNDS * hash_table_size(&ht), start);
+    bench_sink += sum;
+
+    hash_table_destroy(&ht);
+}
+
+static int init_chained(hash_table* ht) {
+    return hash_table_init(ht, 16, u32_key_cmp, u32_key_hash);
+}
+
+static int init_open(hash_table* ht) {
+    return hash_table_init_open(ht, 16, u32_key_cmp, u32_key_hash);
+}
+
+static int init_fixed(hash_table* ht) {
+    return hash_table_init_fixed(ht, 16, sizeof(uint32_t), sizeof(uint32_t));
+}
+
+static int init_compact(hash_table* ht) {
+    return hash_table_init_compact(ht, 16, u32_key_cmp, u32_key_hash);
+}
+
+void run_hash_table_benches(void) {
+    hash_table ht;
+
+    for (uint32_t i = 0; i < ENTRY_COUNT; ++i) {
+        // Odd multiplier: keys are unique
+        keys[i] = i * 2654435761u;
+        missing_keys[i] = (i + ENTRY_COUNT) * 2654435761u;
+        values[i] = i;
+    }
+
+    hash_table_init(&ht, 16, u32_key_cmp, u32_key_hash);
+    bench_hash_table(&ht, "hash_table (chained)");
+
+    hash_table_init_open(&ht, 16, u32_key_cmp, u32_key_hash);
+    bench_hash_table(&ht, "hash_table (open)");
+
+    hash_table_init_fixed(&ht, 16, sizeof(uint32_t), sizeof(uint32_t));
+    bench_hash_table(&ht, "hash_table (fixed)");
+
+    hash_table_init_compact(&ht, 16, u32_key_cmp, u32_key_hash);
+    bench_hash_table(&ht, "hash_table (compact)");
+
+    bench_typed_hash_table();
+
+    hash_table_init(&ht, 16, u32_key_cmp, u32_key_hash);
+    bench_filter(&ht, "hash_table (chained)");
+
+    hash_table_init_open(&ht, 16, u32_key_cmp, u32_key_hash);
+    bench_filter(&ht, "hash_table (open)");
+
+    bench_batch(init_chained, "hash_table (chained, 8M)");
+    bench_batch(init_open, "hash_table (open, 8M)");
+    bench_batch(init_fixed, "hash_table (fixed, 8M)");
+    bench_batch(init_compact, "hash_table (compact, 8M)");
+
+    bench_iter(init_chained, "hash_table (chained)");
+    bench_iter(init_open, "hash_table (open)");
+    bench_iter(init_compact, "hash_table (compact)");
+}
@@ -0,0 +1,10 @@
+#ifndef __HASH_TABLE_BENCH_H__
+#define __HASH_TABLE_BENCH_H__
+
+/**
+ * Compare set/get of uint32_t keys across hash_table modes and the
+ * macro-generated typed hash table
+ */
+void run_hash_table_benches(void);
+
+#endif
@@ -0,0 +1,107 @@
+#include "linked_list_bench.h"
+#include "bench_utils.h"
+#include "../utils/intrusive_list.h"
+#include "../utils/linked_list.h"
+
+/**
+ * Number of items in each benchmarked list
+ */
+#define ITEM_COUNT 4096
+
+/**
+ * Number of operations per benchmark (a multiple of ITEM_COUNT)
+ */
+#define OP_COUNT (1 << 20)
+
+/**
+ * Item listed by the intrusive list benchmarks
+ */
+typedef struct bench_item {
+    uint32_t id;
+    intrusive_list_node link;
+} bench_item;
+
+static bench_item items[ITEM_COUNT];
+
+/**
+ * Positions of the items moved to the tail, in random order
+ */
+static uint32_t positions[OP_COUNT];
+
+/**
+ * Benchmark using the lists as FIFO queues (one node per push for linked_list)
+ */
+static void bench_queue(void) {
+    list lst;
+    intrusive_list ilst;
+
+    linked_list_init(&lst);
+    intrusive_list_init(&ilst);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        linked_list_push_tail(&lst, &items[i % ITEM_COUNT]);
+        if (lst.size > 64) {
+            bench_sink += ((bench_item *)linked_list_pop_head(&lst))->id;
+        }
+    }
+    bench_report("linked_list push_tail + pop_head", OP_COUNT, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        intrusive_list_push_tail(&ilst, &items[i % ITEM_COUNT].link);
+        if (ilst.size > 64) {
+            bench_sink += INTRUSIVE_LIST_ENTRY(intrusive_list_pop_head(&ilst), bench_item, link)->id;
+        }
+    }
+    bench_report("intrusive_list push_tail + pop_head", OP_COUNT, start);
+
+    linked_list_destroy(&lst);
+}
+
+/**
+ * Benchmark moving items from anywhere in the lists to their tail (as an LRU
+ * does on every hit): linked_list has to find the item by position first
+ */
+static void bench_move_to_tail(void) {
+    list lst;
+    intrusive_list ilst;
+
+    linked_list_init(&lst);
+    intrusive_list_init(&ilst);
+
+    for (size_t i = 0; i < ITEM_COUNT; ++i) {
+        linked_list_push_tail(&lst, &items[i]);
+        intrusive_list_push_tail(&ilst, &items[i].link);
+    }
+
+    // (Far fewer operations: each one walks half the list on average)
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < OP_COUNT / 64; ++i) {
+        void* value = linked_list_get_at(&lst, positions[i]);
+        linked_list_del_at(&lst, positions[i]);
+        linked_list_push_tail(&lst, value);
+    }
+    bench_report("linked_list move to tail by position", OP_COUNT / 64, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        intrusive_list_move_to_tail(&ilst, &items[positions[i]].link);
+    }
+    bench_report("intrusive_list move to tail by handle", OP_COUNT, start);
+
+    linked_list_destroy(&lst);
+}
+
+void run_linked_list_benches(void) {
+    for (uint32_t i = 0; i < ITEM_COUNT; ++i) {
+        items[i].id = i;
+    }
+
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        positions[i] = rand() % ITEM_COUNT;
+    }
+
+    bench_queue();
+    bench_move_to_tail();
+}
@@ -0,0 +1,9 @@
+#ifndef __LINKED_LIST_BENCH_H__
+#define __LINKED_LIST_BENCH_H__
+
+/**
+ * Compare linked_list (allocated nodes) with intrusive_list (embedded nodes)
+ */
+void run_linked_list_benches(void);
+
+#endif
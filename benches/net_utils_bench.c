@@ -0,0 +1,127 @@
+#include <arpa/inet.h>
+#include <stdio.h>
+
+#include "net_utils_bench.h"
+#include "bench_utils.h"
+#include "../utils/net_utils_batch.h"
+
+/**
+ * Number of distinct addresses converted (a power of 2)
+ */
+#define ADDR_COUNT (1 << 12)
+
+/**
+ * Number of passes over the addresses
+ */
+#define PASS_COUNT 1024
+
+static char addr_strs[ADDR_COUNT][NET_UTILS_IP_STR_SIZE];
+static const char* addr_str_ptrs[ADDR_COUNT];
+static uint32_t long_addrs[ADDR_COUNT];
+
+static char ether_strs[ADDR_COUNT][NET_UTILS_ETHER_STR_SIZE];
+static const char* ether_str_ptrs[ADDR_COUNT];
+static uint8_t ether_addrs[ADDR_COUNT * 6];
+
+/**
+ * Measure the batch conversions of the current implementation
+ *
+ * @param impl_name Implementation name
+ */
+static void bench_batch(const char* impl_name) {
+    const size_t ops = (size_t)ADDR_COUNT * PASS_COUNT;
+    char bench_name[64];
+    uint64_t sum = 0;
+
+    uint64_t start = bench_now_ns();
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        sum += net_utils_ip_parse_many(addr_str_ptrs, ADDR_COUNT, long_addrs);
+    }
+    snprintf(bench_name, sizeof(bench_name), "net_utils_ip_parse_many (%s)", impl_name);
+    bench_report(bench_name, ops, start);
+
+    start = bench_now_ns();
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        net_utils_ip_format_many(long_addrs, ADDR_COUNT, addr_strs);
+    }
+    snprintf(bench_name, sizeof(bench_name), "net_utils_ip_format_many (%s)", impl_name);
+    bench_report(bench_name, ops, start);
+
+    start = bench_now_ns();
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        sum += net_utils_ether_parse_many(ether_str_ptrs, ADDR_COUNT, ether_addrs);
+    }
+    snprintf(bench_name, sizeof(bench_name), "net_utils_ether_parse_many (%s)", impl_name);
+    bench_report(bench_name, ops, start);
+
+    start = bench_now_ns();
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        net_utils_ether_format_many(ether_addrs, ADDR_COUNT, ether_strs);
+    }
+    snprintf(bench_name, sizeof(bench_name), "net_utils_ether_format_many (%s)", impl_name);
+    bench_report(bench_name, ops, start);
+
+    bench_sink += sum;
+}
+
+void run_net_utils_benches(void) {
+    const size_t ops = (size_t)ADDR_COUNT * PASS_COUNT;
+    char ip_addr[NET_UTILS_IP_STR_SIZE];
+    uint64_t sum = 0;
+
+    // Mix of short and long octets
+    for (size_t i = 0; i < ADDR_COUNT; ++i) {
+        net_utils_ip_format((uint32_t)rand() ^ (uint32_t)rand() << 16, addr_strs[i]);
+        addr_str_ptrs[i] = addr_strs[i];
+    }
+
+    for (size_t i = 0; i < ADDR_COUNT * 6; ++i) {
+        ether_addrs[i] = rand();
+    }
+    net_utils_ether_format_many(ether_addrs, ADDR_COUNT, ether_strs);
+    for (size_t i = 0; i < ADDR_COUNT; ++i) {
+        ether_str_ptrs[i] = ether_strs[i];
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        uint32_t long_addr;
+        net_utils_ip_parse(addr_strs[i & (ADDR_COUNT - 1)], &long_addr);
+        sum += long_addr;
+    }
+    bench_report("net_utils_ip_parse", ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        struct in_addr addr;
+        inet_pton(AF_INET, addr_strs[i & (ADDR_COUNT - 1)], &addr);
+        sum += addr.s_addr;
+    }
+    bench_report("inet_pton", ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        sum += net_utils_ip_format((uint32_t)(i * 0x9E3779B9U), ip_addr);
+    }
+    bench_report("net_utils_ip_format", ops, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        struct in_addr addr = {.s_addr = (uint32_t)(i * 0x9E3779B9U)};
+        sum += inet_ntop(AF_INET, &addr, ip_addr, sizeof(ip_addr)) != NULL;
+    }
+    bench_report("inet_ntop", ops, start);
+
+    bench_sink += sum;
+
+    const net_utils_batch_impl default_impl = net_utils_batch_get_impl();
+
+    net_utils_batch_set_impl(NET_UTILS_BATCH_SCALAR);
+    bench_batch("scalar");
+
+    if (net_utils_batch_set_impl(NET_UTILS_BATCH_SSE41) == 0) {
+        bench_batch("sse4.1");
+    }
+
+    net_utils_batch_set_impl(default_impl);
+}
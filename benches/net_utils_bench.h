@@ -0,0 +1,9 @@
+#ifndef __NET_UTILS_BENCH_H__
+#define __NET_UTILS_BENCH_H__
+
+/**
+ * Measure IPv4 address parsing and formatting
+ */
+void run_net_utils_benches(void);
+
+#endif
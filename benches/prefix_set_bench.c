@@ -0,0 +1,106 @@
+#include <stdio.h>
+
+#include "prefix_set_bench.h"
+#include "bench_utils.h"
+#include "../utils/net_utils.h"
+#include "../utils/prefix_set.h"
+
+/**
+ * Number of prefixes in the set
+ */
+#define PREFIX_COUNT 10000
+
+/**
+ * Number of addresses looked up (a power of 2)
+ */
+#define ADDR_COUNT (1 << 20)
+
+/**
+ * Number of addresses looked up by scanning all prefixes (much slower)
+ */
+#define SCAN_ADDR_COUNT (1 << 10)
+
+static uint32_t networks[PREFIX_COUNT];
+static uint8_t net_bits[PREFIX_COUNT];
+static char network_strs[PREFIX_COUNT][NET_UTILS_IP_STR_SIZE];
+
+static uint32_t addrs[ADDR_COUNT];
+static char addr_strs[SCAN_ADDR_COUNT][NET_UTILS_IP_STR_SIZE];
+static void* values[ADDR_COUNT];
+
+void run_prefix_set_benches(void) {
+    prefix_set set;
+    uint64_t sum = 0;
+
+    prefix_set_init(&set);
+
+    // Realistic lengths: mostly /16 to /24, some hosts
+    for (size_t i = 0; i < PREFIX_COUNT; ++i) {
+        net_bits[i] = 16 + rand() % 17;
+        networks[i] = ((uint32_t)rand() ^ (uint32_t)rand() << 16) & ~0U << (32 - net_bits[i]);
+
+        net_utils_ip_format(networks[i], network_strs[i]);
+        prefix_set_add(&set, networks[i], net_bits[i], &networks[i]);
+    }
+
+    // Half of the addresses inside a prefix
+    for (size_t i = 0; i < ADDR_COUNT; ++i) {
+        const size_t p = rand() % PREFIX_COUNT;
+        addrs[i] = rand() % 2 ? networks[p] | ((uint32_t)rand() & ~(~0U << (32 - net_bits[p])))
+            : (uint32_t)rand() ^ (uint32_t)rand() << 16;
+
+        if (i < SCAN_ADDR_COUNT) {
+            net_utils_ip_format(addrs[i], addr_strs[i]);
+        }
+    }
+
+    uint64_t start = bench_now_ns();
+    prefix_set_build(&set);
+    bench_report("prefix_set_build (10000 prefixes)", 1, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < SCAN_ADDR_COUNT; ++i) {
+        int longest = -1;
+
+        for (size_t p = 0; p < PREFIX_COUNT; ++p) {
+            if (net_bits[p] > longest && net_utils_ip_matches(addr_strs[i], network_strs[p], net_bits[p])) {
+                longest = net_bits[p];
+            }
+        }
+
+        sum += longest;
+    }
+    bench_report("net_utils_ip_matches scan", SCAN_ADDR_COUNT, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < SCAN_ADDR_COUNT; ++i) {
+        int longest = -1;
+
+        for (size_t p = 0; p < PREFIX_COUNT; ++p) {
+            const uint32_t mask = ~0U << (32 - net_bits[p]);
+            if (net_bits[p] > longest && (addrs[i] & mask) == networks[p]) {
+                longest = net_bits[p];
+            }
+        }
+
+        sum += longest;
+    }
+    bench_report("binary prefix scan", SCAN_ADDR_COUNT, start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < ADDR_COUNT; ++i) {
+        sum += prefix_set_lookup(&set, addrs[i]) != NULL;
+    }
+    bench_report("prefix_set_lookup", ADDR_COUNT, start);
+
+    start = bench_now_ns();
+    prefix_set_lookup_many(&set, addrs, ADDR_COUNT, values);
+    for (size_t i = 0; i < ADDR_COUNT; ++i) {
+        sum += values[i] != NULL;
+    }
+    bench_report("prefix_set_lookup_many", ADDR_COUNT, start);
+
+    bench_sink += sum;
+
+    prefix_set_destroy(&set);
+}
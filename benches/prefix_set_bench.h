@@ -0,0 +1,9 @@
+#ifndef __PREFIX_SET_BENCH_H__
+#define __PREFIX_SET_BENCH_H__
+
+/**
+ * Compare prefix_set lookups with scanning a list of networks
+ */
+void run_prefix_set_benches(void);
+
+#endif
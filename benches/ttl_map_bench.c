@@ -0,0 +1,96 @@
+#include "ttl_map_bench.h"
+#include "bench_utils.h"
+#include "../utils/hash_table.h"
+#include "../utils/ttl_map.h"
+#include "../utils/typed_hash_table.h"
+
+/**
+ * Number of entries set in each benchmark
+ */
+#define ENTRY_COUNT (1 << 20)
+
+/**
+ * Time to live of the entries are spread up to this (in ticks)
+ */
+#define MAX_TTL (1 << 16)
+
+/**
+ * Ticks between expiry passes
+ */
+#define STEP 1024
+
+static uint32_t keys[ENTRY_COUNT];
+static uint64_t deadlines[ENTRY_COUNT];
+
+/**
+ * Current time of the benchmark clock
+ */
+static uint64_t bench_time;
+
+static int u32_key_cmp(const void* key_a, const void* key_b) {
+    return *(const uint32_t *)key_a != *(const uint32_t *)key_b;
+}
+
+static uint32_t u32_key_hash(const void* key) {
+    return typed_hash_u32(*(const uint32_t *)key);
+}
+
+static uint64_t bench_clock(void* user_arg) {
+    return *(const uint64_t *)user_arg;
+}
+
+/**
+ * Delete an entry of the scanned table if its deadline passed
+ *
+ * @param entry Entry
+ * @param index Iteration index
+ * @param ht Hash table
+ */
+static void delete_if_expired(const hash_table_entry* entry, size_t index, void* ht) {
+    if (*(const uint64_t *)entry->value <= bench_time) {
+        hash_table_del(ht, entry->key);
+    }
+}
+
+void run_ttl_map_benches(void) {
+    ttl_map map;
+    hash_table ht;
+
+    for (uint32_t i = 0; i < ENTRY_COUNT; ++i) {
+        keys[i] = i;
+        deadlines[i] = 1 + (i * 40503) % MAX_TTL;
+    }
+
+    ttl_map_init(&map, ENTRY_COUNT, u32_key_cmp, u32_key_hash);
+    bench_time = 0;
+    ttl_map_set_clock(&map, bench_clock, &bench_time);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        ttl_map_set(&map, &keys[i], NULL, deadlines[i]);
+    }
+    bench_report("ttl_map set", ENTRY_COUNT, start);
+
+    start = bench_now_ns();
+    for (bench_time = STEP; bench_time <= MAX_TTL; bench_time += STEP) {
+        bench_sink += ttl_map_expire(&map);
+    }
+    bench_report("ttl_map expire (per pass)", MAX_TTL / STEP, start);
+
+    ttl_map_destroy(&map);
+
+    // Baseline: every pass scans the whole table for expired entries
+    hash_table_init_open(&ht, ENTRY_COUNT, u32_key_cmp, u32_key_hash);
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        hash_table_set(&ht, &keys[i], &deadlines[i]);
+    }
+
+    start = bench_now_ns();
+    for (bench_time = STEP; bench_time <= MAX_TTL; bench_time += STEP) {
+        hash_table_iter(&ht, delete_if_expired, &ht);
+    }
+    bench_report("hash_table scan expire (per pass)", MAX_TTL / STEP, start);
+    bench_sink += hash_table_size(&ht);
+
+    hash_table_destroy(&ht);
+}
@@ -0,0 +1,10 @@
+#ifndef __TTL_MAP_BENCH_H__
+#define __TTL_MAP_BENCH_H__
+
+/**
+ * Compare expiring entries through ttl_map's timing wheel with scanning a
+ * hash_table of deadlines
+ */
+void run_ttl_map_benches(void);
+
+#endif
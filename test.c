@@ -1,11 +1,23 @@
 #include <CUnit/Basic.h>
 #include <stdlib.h>
 
+#include "tests/bloom_filter_test.h"
 #include "tests/linked_list_test.h"
 #include "tests/murmur3_test.h"
 #include "tests/array_list_test.h"
 #include "tests/hash_table_test.h"
+#include "tests/intrusive_list_test.h"
+#include "tests/lru_cache_test.h"
+#include "tests/concurrent_hash_table_test.h"
+#include "tests/epoch_test.h"
 #include "tests/net_utils_test.h"
+#include "tests/net_utils_batch_test.h"
+#include "tests/prefix_set_test.h"
+#include "tests/slab_test.h"
+#include "tests/timing_wheel_test.h"
+#include "tests/ttl_map_test.h"
+#include "tests/typed_containers_test.h"
+#include "tests/wyhash_test.h"
 
 int main(int argc, char** argv) {
     // Initialize the CUnit test registry
@@ -18,7 +30,19 @@ int main(int argc, char** argv) {
         {"murmur3", NULL, NULL, NULL, NULL, get_murmur3_tests()},
         {"array_list", NULL, NULL, NULL, NULL, get_array_list_tests()},
         {"hash_table", NULL, NULL, NULL, NULL, get_hash_table_tests()},
+        {"concurrent_hash_table", NULL, NULL, NULL, NULL, get_concurrent_hash_table_tests()},
+        {"epoch", NULL, NULL, NULL, NULL, get_epoch_tests()},
+        {"intrusive_list", NULL, NULL, NULL, NULL, get_intrusive_list_tests()},
+        {"lru_cache", NULL, NULL, NULL, NULL, get_lru_cache_tests()},
+        {"timing_wheel", NULL, NULL, NULL, NULL, get_timing_wheel_tests()},
+        {"ttl_map", NULL, NULL, NULL, NULL, get_ttl_map_tests()},
+        {"bloom_filter", NULL, NULL, NULL, NULL, get_bloom_filter_tests()},
         {"net_utils", NULL, NULL, NULL, NULL, get_net_utils_tests()},
+        {"net_utils_batch", NULL, NULL, NULL, NULL, get_net_utils_batch_tests()},
+        {"prefix_set", NULL, NULL, NULL, NULL, get_prefix_set_tests()},
+        {"slab", NULL, NULL, NULL, NULL, get_slab_tests()},
+        {"typed_containers", NULL, NULL, NULL, NULL, get_typed_containers_tests()},
+        {"wyhash", NULL, NULL, NULL, NULL, get_wyhash_tests()},
         CU_SUITE_INFO_NULL,
     };
 
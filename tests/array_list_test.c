@@ -1,3 +1,8 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "array_list_test.h"
 #include "../utils/array_list.h"
 
@@ -5,6 +10,16 @@ CU_TestInfo* get_array_list_tests() {
     static CU_TestInfo tests[] = {
         {"test_array_list_init_and_destroy", test_array_list_init_and_destroy},
         {"test_array_list", test_array_list},
+        {"test_array_list_growth", test_array_list_growth},
+        {"test_array_list_deque", test_array_list_deque},
+        {"test_array_list_bulk_and_spans", test_array_list_bulk_and_spans},
+        {"test_array_list_random", test_array_list_random},
+        {"test_array_list_values", test_array_list_values},
+        {"test_array_list_values_from_list", test_array_list_values_from_list},
+        {"test_array_list_sort", test_array_list_sort},
+        {"test_array_list_radix_sort", test_array_list_radix_sort},
+        {"test_array_list_binary_search", test_array_list_binary_search},
+        {"test_array_list_set_ops", test_array_list_set_ops},
         CU_TEST_INFO_NULL,
     };
 
@@ -66,3 +81,633 @@ void test_array_list() {
 
     CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
 }
+
+void test_array_list_growth() {
+    array_list lst;
+    int values[1000];
+    size_t resizes = 0;
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(int), 0), 0)
+    CU_ASSERT_PTR_NULL(lst.array)
+
+    // Appending grows the capacity geometrically
+    for (int i = 0; i < 1000; ++i) {
+        const size_t capacity = lst.capacity;
+
+        values[i] = i;
+        CU_ASSERT_EQUAL(array_list_push_tail(&lst, &values[i]), 0)
+
+        if (lst.capacity != capacity) {
+            CU_ASSERT(lst.capacity >= capacity * 2)
+            ++resizes;
+        }
+    }
+    CU_ASSERT(resizes <= 10)
+
+    // Inserting in the middle shifts the tail
+    CU_ASSERT_EQUAL(array_list_insert_at(&lst, &values[7], 500), 0)
+    CU_ASSERT_EQUAL(array_list_insert_at(&lst, &values[8], 1001), 0)
+    CU_ASSERT_EQUAL(array_list_insert_at(&lst, &values[9], 1003), -1)
+    CU_ASSERT_EQUAL(lst.size, 1002)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 499), 499)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 500), 7)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 501), 500)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 1000), 999)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 1001), 8)
+
+    CU_ASSERT_EQUAL(*(int *)array_list_del_at(&lst, 500), 7)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 500), 500)
+    CU_ASSERT_EQUAL(*(int *)array_list_pop_tail(&lst), 8)
+
+    for (int i = 0; i < 1000; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, i), i)
+    }
+
+    // Reserving never shrinks
+    CU_ASSERT_EQUAL(array_list_reserve(&lst, 4000), 0)
+    CU_ASSERT_EQUAL(lst.capacity, 4000)
+    CU_ASSERT_EQUAL(array_list_reserve(&lst, 10), 0)
+    CU_ASSERT_EQUAL(lst.capacity, 4000)
+
+    CU_ASSERT_EQUAL(array_list_shrink_to_fit(&lst), 0)
+    CU_ASSERT_EQUAL(lst.capacity, 1000)
+    CU_ASSERT_EQUAL(array_list_resize(&lst, 999), -1)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 999), 999)
+
+    // Custom growth factor
+    CU_ASSERT_EQUAL(array_list_set_growth_factor(&lst, 1.0), -1)
+    CU_ASSERT_EQUAL(array_list_set_growth_factor(&lst, 1.5), 0)
+    CU_ASSERT_EQUAL(array_list_push_tail(&lst, &values[0]), 0)
+    CU_ASSERT_EQUAL(lst.capacity, 1500)
+
+    // Emptied lists release their array
+    while (lst.size > 0) {
+        array_list_pop_head(&lst);
+    }
+    CU_ASSERT_EQUAL(array_list_shrink_to_fit(&lst), 0)
+    CU_ASSERT_PTR_NULL(lst.array)
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[3]), 0)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 0), 3)
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+void test_array_list_deque() {
+    array_list lst;
+    int values[16];
+
+    for (int i = 0; i < 16; ++i) {
+        values[i] = i;
+    }
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(int), 4), 0)
+
+    // Queue: the values wrap around without the array growing
+    for (int i = 0; i < 12; ++i) {
+        CU_ASSERT_EQUAL(array_list_push_tail(&lst, &values[i]), 0)
+        if (i >= 2) {
+            CU_ASSERT_EQUAL(*(int *)array_list_pop_head(&lst), i - 2)
+        }
+    }
+    CU_ASSERT_EQUAL(lst.size, 2)
+    CU_ASSERT_EQUAL(lst.capacity, 4)
+
+    // Pushing to the head goes around the start of the array
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[9]), 0) // [9, 10, 11]
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[8]), 0) // [8, 9, 10, 11]
+    CU_ASSERT_EQUAL(lst.capacity, 4)
+
+    // Growing while wrapped keeps the order
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[7]), 0) // [7, 8, 9, 10, 11]
+    CU_ASSERT_EQUAL(array_list_push_tail(&lst, &values[12]), 0) // [7, 8, 9, 10, 11, 12]
+    CU_ASSERT_EQUAL(lst.size, 6)
+    for (int i = 0; i < 6; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, i), i + 7)
+    }
+
+    CU_ASSERT_EQUAL(array_list_index_of(&lst, &values[12]), 5)
+    CU_ASSERT_EQUAL(*(int *)array_list_pop_tail(&lst), 12)
+    CU_ASSERT_EQUAL(*(int *)array_list_pop_head(&lst), 7)
+
+    // Shrinking while wrapped keeps the order
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[7]), 0)
+    CU_ASSERT_EQUAL(array_list_shrink_to_fit(&lst), 0)
+    CU_ASSERT_EQUAL(lst.capacity, 5)
+    for (int i = 0; i < 5; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, i), i + 7)
+    }
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+void test_array_list_bulk_and_spans() {
+    array_list lst;
+    int values[100];
+    void* ptrs[100];
+    void* popped[100];
+    array_list_span spans[2];
+
+    for (int i = 0; i < 100; ++i) {
+        values[i] = i;
+        ptrs[i] = &values[i];
+    }
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(int), 8), 0)
+    CU_ASSERT_EQUAL(array_list_get_spans(&lst, spans), 0)
+
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, ptrs, 6), 0) // [0-5]
+    CU_ASSERT_EQUAL(array_list_pop_head_n(&lst, popped, 4), 4) // [4, 5]
+    CU_ASSERT_PTR_EQUAL(popped[0], &values[0])
+    CU_ASSERT_PTR_EQUAL(popped[3], &values[3])
+
+    // Wraps around the end of the array
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, &ptrs[6], 5), 0) // [4-10]
+    CU_ASSERT_EQUAL(lst.capacity, 8)
+
+    CU_ASSERT_EQUAL(array_list_get_spans(&lst, spans), 2)
+    CU_ASSERT_EQUAL(spans[0].size, 4)
+    CU_ASSERT_EQUAL(spans[1].size, 3)
+    CU_ASSERT_PTR_EQUAL(spans[0].values[0], &values[4])
+    CU_ASSERT_PTR_EQUAL(spans[1].values[0], &values[8])
+    CU_ASSERT_PTR_EQUAL(spans[1].values[2], &values[10])
+
+    // Grows once, to fit everything
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, &ptrs[11], 89), 0) // [4-99]
+    CU_ASSERT_EQUAL(lst.size, 96)
+    for (int i = 0; i < 96; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, i), i + 4)
+    }
+
+    CU_ASSERT_EQUAL(array_list_pop_head_n(&lst, NULL, 90), 90) // [94-99]
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[93]), 0) // [93-99]
+
+    void** array = array_list_make_contiguous(&lst);
+    CU_ASSERT_PTR_EQUAL(array, lst.array)
+    CU_ASSERT_EQUAL(lst.head, 0)
+    for (int i = 0; i < 7; ++i) {
+        CU_ASSERT_PTR_EQUAL(array[i], &values[i + 93])
+    }
+
+    CU_ASSERT_EQUAL(array_list_get_spans(&lst, spans), 1)
+    CU_ASSERT_EQUAL(spans[0].size, 7)
+
+    CU_ASSERT_EQUAL(array_list_pop_head_n(&lst, popped, 100), 7)
+    CU_ASSERT_PTR_EQUAL(popped[6], &values[99])
+    CU_ASSERT_EQUAL(lst.size, 0)
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+/**
+ * Apply random inserts and deletes to an empty array list, comparing it with
+ * a plain array (the list holds int values, either by pointer or by value)
+ *
+ * @param lst Empty array list
+ */
+static void check_random_ops(array_list* lst) {
+    enum { OP_COUNT = 20000, MAX_SIZE = 200 };
+    static int values[OP_COUNT];
+    static int expected[OP_COUNT];
+    size_t expected_size = 0;
+    uint32_t state = 2463534242U; // Local xorshift32, the global rand() sequence seeds the hash tables
+
+    for (int i = 0; i < OP_COUNT; ++i) {
+        values[i] = i;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        // Insert more often while small, delete more often while large
+        if ((size_t)(state % MAX_SIZE) >= expected_size) {
+            const size_t pos = (state >> 8) % (expected_size + 1);
+
+            CU_ASSERT_EQUAL(array_list_insert_at(lst, &values[i], pos), 0)
+            memmove(&expected[pos + 1], &expected[pos], (expected_size - pos) * sizeof(int));
+            expected[pos] = i;
+            ++expected_size;
+        }
+        else {
+            const size_t pos = (state >> 8) % expected_size;
+
+            CU_ASSERT_EQUAL(*(int *)array_list_del_at(lst, pos), expected[pos])
+            memmove(&expected[pos], &expected[pos + 1], (expected_size - pos - 1) * sizeof(int));
+            --expected_size;
+        }
+
+        if (i % 1000 == 0) {
+            array_list_shrink_to_fit(lst);
+        }
+    }
+
+    CU_ASSERT_EQUAL(lst->size, expected_size)
+    for (size_t i = 0; i < expected_size; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(lst, i), expected[i])
+    }
+}
+
+void test_array_list_random() {
+    array_list lst;
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(int), 0), 0)
+    check_random_ops(&lst);
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, sizeof(int), 0), 0)
+    check_random_ops(&lst);
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+/**
+ * Value stored inline by the ARRAY_LIST_VALUES tests
+ */
+typedef struct test_point {
+    int32_t x;
+    int32_t y;
+    uint8_t tag[4];
+} test_point;
+
+void test_array_list_values() {
+    array_list lst;
+    test_point points[8];
+    test_point popped[8];
+    array_list_span spans[2];
+
+    memset(points, 0, sizeof(points));
+    for (int i = 0; i < 8; ++i) {
+        points[i].x = i;
+        points[i].y = -i;
+        points[i].tag[0] = (uint8_t)('a' + i);
+    }
+
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, 0, 4), -1)
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, sizeof(test_point), 2), 0)
+    CU_ASSERT_EQUAL(lst.type, ARRAY_LIST_VALUES)
+    CU_ASSERT_EQUAL(lst.value_size, sizeof(test_point))
+
+    // Values are copied in
+    CU_ASSERT_EQUAL(array_list_push_tail(&lst, &points[1]), 0) // [1]
+    CU_ASSERT_EQUAL(array_list_push_tail(&lst, &points[3]), 0) // [1, 3]
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &points[0]), 0) // [0, 1, 3]
+    CU_ASSERT_EQUAL(array_list_insert_at(&lst, &points[2], 2), 0) // [0, 1, 2, 3]
+    points[1].x = 100;
+    CU_ASSERT_EQUAL(((test_point *)array_list_get_at(&lst, 1))->x, 1)
+    points[1].x = 1;
+
+    // ... and live next to each other in the array
+    test_point* first = array_list_make_contiguous(&lst);
+    for (int i = 0; i < 4; ++i) {
+        test_point* p_point = array_list_get_at(&lst, i);
+
+        CU_ASSERT_PTR_EQUAL(p_point, first + i)
+        CU_ASSERT_EQUAL(p_point->x, i)
+        CU_ASSERT_EQUAL(p_point->y, -i)
+        CU_ASSERT_EQUAL(p_point->tag[0], 'a' + i)
+    }
+
+    // Values can be changed in place
+    ((test_point *)array_list_get_at(&lst, 3))->y = 42;
+    CU_ASSERT_EQUAL(((test_point *)array_list_get_at(&lst, 3))->y, 42)
+    ((test_point *)array_list_get_at(&lst, 3))->y = -3;
+
+    CU_ASSERT_EQUAL(array_list_index_of(&lst, &points[2]), 2)
+    CU_ASSERT_EQUAL(array_list_index_of(&lst, &points[7]), -1)
+
+    // Deleted values are returned as copies
+    test_point* p_deleted = array_list_del_at(&lst, 1); // [0, 2, 3]
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_deleted)
+    CU_ASSERT_EQUAL(memcmp(p_deleted, &points[1], sizeof(test_point)), 0)
+    p_deleted = array_list_del_value(&lst, &points[2]); // [0, 3]
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_deleted)
+    CU_ASSERT_EQUAL(p_deleted->x, 2)
+    CU_ASSERT_PTR_NULL(array_list_del_value(&lst, &points[2]))
+    CU_ASSERT_EQUAL(((test_point *)array_list_pop_head(&lst))->x, 0) // [3]
+    CU_ASSERT_EQUAL(((test_point *)array_list_pop_tail(&lst))->x, 3) // []
+    CU_ASSERT_PTR_NULL(array_list_pop_tail(&lst))
+
+    // Written in place
+    test_point* p_slot = array_list_emplace_tail(&lst); // [5]
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_slot)
+    *p_slot = points[5];
+    p_slot = array_list_emplace_at(&lst, 0); // [4, 5]
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_slot)
+    *p_slot = points[4];
+    CU_ASSERT_PTR_NULL(array_list_emplace_at(&lst, 3))
+    CU_ASSERT_EQUAL(lst.size, 2)
+    CU_ASSERT_EQUAL(((test_point *)array_list_get_at(&lst, 0))->x, 4)
+    CU_ASSERT_EQUAL(((test_point *)array_list_get_at(&lst, 1))->x, 5)
+
+    // Copied in and out in bulk, wrapping around the end of the array
+    CU_ASSERT_EQUAL(array_list_pop_head_n(&lst, popped, 1), 1) // [5]
+    CU_ASSERT_EQUAL(popped[0].x, 4)
+    CU_ASSERT_EQUAL(array_list_resize(&lst, 4), 0)
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, &points[6], 2), 0) // [5, 6, 7]
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &points[4]), 0) // [4, 5, 6, 7]
+    CU_ASSERT_EQUAL(lst.capacity, 4)
+
+    CU_ASSERT_EQUAL(array_list_get_spans(&lst, spans), 2)
+    CU_ASSERT_EQUAL(spans[0].size, 1)
+    CU_ASSERT_EQUAL(((test_point *)spans[0].data)[0].x, 4)
+    CU_ASSERT_EQUAL(spans[1].size, 3)
+    CU_ASSERT_EQUAL(((test_point *)spans[1].data)[2].x, 7)
+
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, points, 4), 0) // [4, 5, 6, 7, 0, 1, 2, 3]
+    test_point* array = array_list_make_contiguous(&lst);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(array)
+    for (int i = 0; i < 8; ++i) {
+        CU_ASSERT_EQUAL(array[i].x, (i + 4) % 8)
+    }
+
+    CU_ASSERT_EQUAL(array_list_pop_head_n(&lst, popped, 8), 8)
+    CU_ASSERT_EQUAL(memcmp(&popped[4], points, 4 * sizeof(test_point)), 0)
+    CU_ASSERT_EQUAL(memcmp(popped, &points[4], 4 * sizeof(test_point)), 0)
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+void test_array_list_values_from_list() {
+    array_list lst;
+    const uint64_t values[3] = {1, 2, 3};
+    uint64_t zero = 0;
+
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, sizeof(uint64_t), 4), 0)
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, values, 3), 0)
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, &zero), 0) // [0, 1, 2, 3], wrapped and full
+
+    // Pushed values may come from the list itself, even when it grows
+    CU_ASSERT_EQUAL(array_list_push_tail(&lst, array_list_get_at(&lst, 0)), 0) // [0, 1, 2, 3, 0]
+    CU_ASSERT_EQUAL(*(uint64_t *)array_list_get_at(&lst, 4), 0)
+
+    while (lst.size < lst.capacity) {
+        CU_ASSERT_EQUAL(array_list_push_tail(&lst, &zero), 0)
+    }
+
+    CU_ASSERT_EQUAL(array_list_push_head(&lst, array_list_get_at(&lst, 3)), 0) // [3, 0, 1, 2, 3, 0...]
+    CU_ASSERT_EQUAL(*(uint64_t *)array_list_get_at(&lst, 0), 3)
+
+    // ... or be shifted to make room
+    CU_ASSERT_EQUAL(array_list_insert_at(&lst, array_list_get_at(&lst, 0), 2), 0) // [3, 0, 3, 1, 2, 3, 0...]
+    CU_ASSERT_EQUAL(*(uint64_t *)array_list_get_at(&lst, 2), 3)
+    CU_ASSERT_EQUAL(*(uint64_t *)array_list_get_at(&lst, 3), 1)
+
+    // Same for bulk appends
+    const size_t size = lst.size;
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&lst, array_list_make_contiguous(&lst), size), 0)
+    CU_ASSERT_EQUAL(lst.size, size * 2)
+    for (size_t i = 0; i < size; ++i) {
+        CU_ASSERT_EQUAL(*(uint64_t *)array_list_get_at(&lst, size + i), *(uint64_t *)array_list_get_at(&lst, i))
+    }
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+static int cmp_int(const void* value_a, const void* value_b) {
+    const int a = *(const int *)value_a;
+    const int b = *(const int *)value_b;
+
+    return (a > b) - (a < b);
+}
+
+static int cmp_point_x(const void* value_a, const void* value_b) {
+    const test_point* a = value_a;
+    const test_point* b = value_b;
+
+    return (a->x > b->x) - (a->x < b->x);
+}
+
+void test_array_list_sort() {
+    enum { VALUE_COUNT = 5000, PATTERN_COUNT = 6 };
+    static int values[VALUE_COUNT];
+    static int expected[VALUE_COUNT];
+    uint32_t state = 88172645U;
+    array_list pointers;
+    array_list ints;
+
+    for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+        for (int i = 0; i < VALUE_COUNT; ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            switch (pattern) {
+                case 0: values[i] = (int)(state % 1000000); break; // Random
+                case 1: values[i] = (int)(state % 8); break; // Many duplicates
+                case 2: values[i] = i; break; // Sorted
+                case 3: values[i] = VALUE_COUNT - i; break; // Reversed
+                case 4: values[i] = i < VALUE_COUNT / 2 ? i : VALUE_COUNT - i; break; // Organ pipe
+                default: values[i] = 7; break; // All equal
+            }
+        }
+
+        memcpy(expected, values, sizeof(values));
+        qsort(expected, VALUE_COUNT, sizeof(int), cmp_int);
+
+        // Pointers, with the values wrapped around the end of the array
+        CU_ASSERT_EQUAL(array_list_init(&pointers, sizeof(int), VALUE_COUNT), 0)
+        for (int i = 0; i < VALUE_COUNT; ++i) {
+            CU_ASSERT_EQUAL(array_list_push_head(&pointers, &values[i]), 0)
+        }
+        CU_ASSERT_EQUAL(array_list_sort(&pointers, cmp_int), 0)
+        CU_ASSERT_EQUAL(pointers.size, VALUE_COUNT)
+        for (int i = 0; i < VALUE_COUNT; ++i) {
+            CU_ASSERT_EQUAL(*(int *)array_list_get_at(&pointers, i), expected[i])
+        }
+        CU_ASSERT_EQUAL(array_list_destroy(&pointers), 0)
+
+        // Values
+        CU_ASSERT_EQUAL(array_list_init_values(&ints, sizeof(int), 0), 0)
+        CU_ASSERT_EQUAL(array_list_push_tail_n(&ints, values, VALUE_COUNT), 0)
+        CU_ASSERT_EQUAL(array_list_sort(&ints, cmp_int), 0)
+        CU_ASSERT_EQUAL(memcmp(array_list_make_contiguous(&ints), expected, sizeof(expected)), 0)
+        CU_ASSERT_EQUAL(array_list_destroy(&ints), 0)
+    }
+
+    // Values larger than the swap buffer
+    typedef struct { int key; char padding[100]; } big_value;
+    array_list bigs;
+    big_value big;
+    memset(&big, 0, sizeof(big));
+
+    CU_ASSERT_EQUAL(array_list_init_values(&bigs, sizeof(big_value), 0), 0)
+    for (int i = 0; i < 100; ++i) {
+        big.key = (i * 37) % 100;
+        big.padding[99] = (char)big.key;
+        CU_ASSERT_EQUAL(array_list_push_tail(&bigs, &big), 0)
+    }
+    CU_ASSERT_EQUAL(array_list_sort(&bigs, cmp_int), 0)
+    for (int i = 0; i < 100; ++i) {
+        const big_value* p_big = array_list_get_at(&bigs, i);
+        CU_ASSERT_EQUAL(p_big->key, i)
+        CU_ASSERT_EQUAL(p_big->padding[99], (char)i)
+    }
+    CU_ASSERT_EQUAL(array_list_destroy(&bigs), 0)
+}
+
+void test_array_list_radix_sort() {
+    enum { VALUE_COUNT = 3000 };
+    array_list lst;
+    test_point point;
+    uint32_t state = 123456789U;
+
+    memset(&point, 0, sizeof(point));
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(test_point), 0), 0)
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, 0, 4), -1) // Not values
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, sizeof(test_point), 0), 0)
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, 0, 3), -1) // Bad key size
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, 10, 4), -1) // Key past the value
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, 0, 4), 0) // Empty
+
+    for (int i = 0; i < VALUE_COUNT; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        point.x = (int32_t)(state & 0x7FFFFFFF);
+        point.y = i;
+        point.tag[0] = (uint8_t)(state % 16);
+        CU_ASSERT_EQUAL(array_list_push_head(&lst, &point), 0)
+    }
+
+    // 32-bit key (x)
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, 0, 4), 0)
+    for (int i = 1; i < VALUE_COUNT; ++i) {
+        CU_ASSERT(((test_point *)array_list_get_at(&lst, i - 1))->x <= ((test_point *)array_list_get_at(&lst, i))->x)
+    }
+
+    // By y, then by the 8-bit tag: being stable keeps y ascending within each tag
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, offsetof(test_point, y), 4), 0)
+    CU_ASSERT_EQUAL(array_list_radix_sort(&lst, offsetof(test_point, tag), 1), 0)
+    for (int i = 1; i < VALUE_COUNT; ++i) {
+        const test_point* p_prev = array_list_get_at(&lst, i - 1);
+        const test_point* p_point = array_list_get_at(&lst, i);
+
+        CU_ASSERT(p_prev->tag[0] <= p_point->tag[0])
+        if (p_prev->tag[0] == p_point->tag[0]) {
+            CU_ASSERT(p_prev->y < p_point->y)
+        }
+    }
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+void test_array_list_binary_search() {
+    array_list lst;
+    int values[] = {1, 3, 3, 3, 5, 8, 13};
+    int missing[] = {0, 2, 4, 14};
+    test_point point;
+
+    CU_ASSERT_EQUAL(array_list_init(&lst, sizeof(int), 0), 0)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &values[0], cmp_int), 0)
+    CU_ASSERT_EQUAL(array_list_binary_search(&lst, &values[0], cmp_int), -1)
+
+    // Wrapped around the end of the array
+    CU_ASSERT_EQUAL(array_list_resize(&lst, 8), 0)
+    for (int i = 6; i >= 0; --i) {
+        CU_ASSERT_EQUAL(array_list_push_head(&lst, &values[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(array_list_binary_search(&lst, &values[0], cmp_int), 0)
+    CU_ASSERT_EQUAL(array_list_binary_search(&lst, &values[2], cmp_int), 1)
+    CU_ASSERT_EQUAL(array_list_binary_search(&lst, &values[6], cmp_int), 6)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &missing[0], cmp_int), 0)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &missing[1], cmp_int), 1)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &missing[2], cmp_int), 4)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &missing[3], cmp_int), 7)
+    for (int i = 0; i < 4; ++i) {
+        CU_ASSERT_EQUAL(array_list_binary_search(&lst, &missing[i], cmp_int), -1)
+    }
+
+    CU_ASSERT_EQUAL(array_list_unique(&lst, cmp_int), 0) // [1, 3, 5, 8, 13]
+    CU_ASSERT_EQUAL(lst.size, 5)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 1), 3)
+    CU_ASSERT_EQUAL(*(int *)array_list_get_at(&lst, 2), 5)
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+
+    // Values, searched by a key field
+    memset(&point, 0, sizeof(point));
+    CU_ASSERT_EQUAL(array_list_init_values(&lst, sizeof(test_point), 0), 0)
+    for (int i = 0; i < 100; ++i) {
+        point.x = i * 2;
+        point.y = i;
+        CU_ASSERT_EQUAL(array_list_push_tail(&lst, &point), 0)
+    }
+
+    point.x = 42;
+    size_t pos = array_list_binary_search(&lst, &point, cmp_point_x);
+    CU_ASSERT_EQUAL(pos, 21)
+    CU_ASSERT_EQUAL(((test_point *)array_list_get_at(&lst, pos))->y, 21)
+    point.x = 43;
+    CU_ASSERT_EQUAL(array_list_binary_search(&lst, &point, cmp_point_x), -1)
+    CU_ASSERT_EQUAL(array_list_lower_bound(&lst, &point, cmp_point_x), 22)
+
+    CU_ASSERT_EQUAL(array_list_destroy(&lst), 0)
+}
+
+/**
+ * Check that an ARRAY_LIST_VALUES list of ints holds the expected values
+ *
+ * @param lst Array list
+ * @param expected Expected values
+ * @param count Number of expected values
+ */
+static void check_ints(array_list* lst, const int* expected, const size_t count) {
+    CU_ASSERT_EQUAL_FATAL(lst->size, count)
+    for (size_t i = 0; i < count; ++i) {
+        CU_ASSERT_EQUAL(*(int *)array_list_get_at(lst, i), expected[i])
+    }
+}
+
+void test_array_list_set_ops() {
+    array_list a;
+    array_list b;
+    array_list dst;
+    array_list pointers;
+    const int a_values[] = {1, 2, 4, 4, 7, 9};
+    const int b_values[] = {0, 2, 4, 8, 9, 9, 10};
+
+    CU_ASSERT_EQUAL(array_list_init_values(&a, sizeof(int), 0), 0)
+    CU_ASSERT_EQUAL(array_list_init_values(&b, sizeof(int), 0), 0)
+    CU_ASSERT_EQUAL(array_list_init_values(&dst, sizeof(int), 0), 0)
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&a, a_values, 6), 0)
+    CU_ASSERT_EQUAL(array_list_push_tail_n(&b, b_values, 7), 0)
+
+    const int merged[] = {0, 1, 2, 2, 4, 4, 4, 7, 8, 9, 9, 9, 10};
+    CU_ASSERT_EQUAL(array_list_merge(&dst, &a, &b, cmp_int), 0)
+    check_ints(&dst, merged, 13);
+
+    const int united[] = {0, 1, 2, 4, 4, 7, 8, 9, 9, 10};
+    dst.size = 0;
+    CU_ASSERT_EQUAL(array_list_union(&dst, &a, &b, cmp_int), 0)
+    check_ints(&dst, united, 10);
+
+    const int intersected[] = {2, 4, 9};
+    dst.size = 0;
+    CU_ASSERT_EQUAL(array_list_intersection(&dst, &a, &b, cmp_int), 0)
+    check_ints(&dst, intersected, 3);
+
+    // Appends to what dst already holds
+    CU_ASSERT_EQUAL(array_list_intersection(&dst, &b, &a, cmp_int), 0)
+    const int appended[] = {2, 4, 9, 2, 4, 9};
+    check_ints(&dst, appended, 6);
+
+    // With an empty list
+    dst.size = 0;
+    a.size = 0;
+    CU_ASSERT_EQUAL(array_list_union(&dst, &a, &b, cmp_int), 0)
+    check_ints(&dst, b_values, 7);
+    dst.size = 0;
+    CU_ASSERT_EQUAL(array_list_intersection(&dst, &a, &b, cmp_int), 0)
+    CU_ASSERT_EQUAL(dst.size, 0)
+
+    // Mismatched lists
+    CU_ASSERT_EQUAL(array_list_init(&pointers, sizeof(int), 0), 0)
+    CU_ASSERT_EQUAL(array_list_merge(&pointers, &a, &b, cmp_int), -1)
+    CU_ASSERT_EQUAL(array_list_merge(&a, &a, &b, cmp_int), -1)
+    CU_ASSERT_EQUAL(array_list_destroy(&pointers), 0)
+
+    CU_ASSERT_EQUAL(array_list_destroy(&a), 0)
+    CU_ASSERT_EQUAL(array_list_destroy(&b), 0)
+    CU_ASSERT_EQUAL(array_list_destroy(&dst), 0)
+}
@@ -9,4 +9,24 @@ void test_array_list_init_and_destroy();
 
 void test_array_list();
 
+void test_array_list_growth();
+
+void test_array_list_deque();
+
+void test_array_list_bulk_and_spans();
+
+void test_array_list_random();
+
+void test_array_list_values();
+
+void test_array_list_values_from_list();
+
+void test_array_list_sort();
+
+void test_array_list_radix_sort();
+
+void test_array_list_binary_search();
+
+void test_array_list_set_ops();
+
 #endif
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "bloom_filter_test.h"
+#include "../utils/bloom_filter.h"
+#include "../utils/murmur3.h"
+
+CU_TestInfo* get_bloom_filter_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_bloom_filter", test_bloom_filter},
+        {"test_bloom_filter_false_positives", test_bloom_filter_false_positives},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_bloom_filter() {
+    bloom_filter filter;
+
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 100, 0), -1)
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 0, 10), 0)
+    CU_ASSERT_EQUAL(filter.block_count, 1)
+    CU_ASSERT_EQUAL((uintptr_t)filter.blocks % 64, 0)
+    bloom_filter_destroy(&filter);
+    CU_ASSERT_PTR_NULL(filter.blocks)
+
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 1000, 10), 0)
+    CU_ASSERT_EQUAL(filter.block_count, 20) // 10000 bits, rounded up to 512-bit blocks
+
+    CU_ASSERT_FALSE(bloom_filter_contains_bytes(&filter, "foo", 3))
+    bloom_filter_add_bytes(&filter, "foo", 3);
+    CU_ASSERT_TRUE(bloom_filter_contains_bytes(&filter, "foo", 3))
+    CU_ASSERT_TRUE(bloom_filter_contains(&filter, murmur3((const uint8_t *)"foo", 3, 0)))
+
+    // Hashes at both ends of the range
+    bloom_filter_add(&filter, 0);
+    bloom_filter_add(&filter, UINT32_MAX);
+    CU_ASSERT_TRUE(bloom_filter_contains(&filter, 0))
+    CU_ASSERT_TRUE(bloom_filter_contains(&filter, UINT32_MAX))
+
+    bloom_filter_clear(&filter);
+    CU_ASSERT_FALSE(bloom_filter_contains_bytes(&filter, "foo", 3))
+    CU_ASSERT_FALSE(bloom_filter_contains(&filter, 0))
+
+    bloom_filter_destroy(&filter);
+}
+
+void test_bloom_filter_false_positives() {
+    enum { KEY_COUNT = 20000, PROBE_COUNT = 100000 };
+    bloom_filter filter;
+    size_t false_positives = 0;
+    char key[32];
+
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, KEY_COUNT, 10), 0)
+
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "added%d", i);
+        bloom_filter_add_bytes(&filter, key, strlen(key));
+    }
+
+    // No false negatives
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "added%d", i);
+        CU_ASSERT_TRUE_FATAL(bloom_filter_contains_bytes(&filter, key, strlen(key)))
+    }
+
+    // About 1% false positives at 10 bits per key
+    for (int i = 0; i < PROBE_COUNT; ++i) {
+        snprintf(key, sizeof(key), "missing%d", i);
+        false_positives += bloom_filter_contains_bytes(&filter, key, strlen(key));
+    }
+    CU_ASSERT(false_positives < PROBE_COUNT / 50)
+
+    bloom_filter_destroy(&filter);
+}
@@ -0,0 +1,12 @@
+#ifndef __BLOOM_FILTER_TEST_H__
+#define __BLOOM_FILTER_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_bloom_filter_tests();
+
+void test_bloom_filter();
+
+void test_bloom_filter_false_positives();
+
+#endif
@@ -0,0 +1,212 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "concurrent_hash_table_test.h"
+#include "../utils/concurrent_hash_table.h"
+
+CU_TestInfo* get_concurrent_hash_table_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_concurrent_hash_table_get_and_set", test_concurrent_hash_table_get_and_set},
+        {"test_concurrent_hash_table_del", test_concurrent_hash_table_del},
+        {"test_concurrent_hash_table_compute_if_absent", test_concurrent_hash_table_compute_if_absent},
+        {"test_concurrent_hash_table_threads", test_concurrent_hash_table_threads},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_concurrent_hash_table_get_and_set() {
+    concurrent_hash_table cht;
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 4, 16, HASH_TABLE_CHAINED, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(cht.shard_count, 4)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "foo"), "one")
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "bar"), "two")
+    CU_ASSERT_PTR_NULL(concurrent_hash_table_get(&cht, "doesnt_exist"))
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "three"), 0) // {"foo": "three", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "foo"), "three")
+    CU_ASSERT_EQUAL(concurrent_hash_table_size(&cht), 2)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+
+    // Default shard count
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 0, 16, HASH_TABLE_OPEN, NULL, NULL), 0)
+    CU_ASSERT(cht.shard_count >= 1)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "one"), 0)
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "foo"), "one")
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 4, 16, HASH_TABLE_COMPACT, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "one"), 0)
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "foo"), "one")
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+
+    // Shards are locked already
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 4, 16, HASH_TABLE_RCU, NULL, NULL), -1)
+    CU_ASSERT_PTR_NULL(cht.shards)
+}
+
+void test_concurrent_hash_table_del() {
+    concurrent_hash_table cht;
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 4, 16, HASH_TABLE_CHAINED, NULL, NULL), 0)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_del(&cht, "bar"), 0) // {"foo": "one"}
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "foo"), "one")
+    CU_ASSERT_PTR_NULL(concurrent_hash_table_get(&cht, "bar"))
+    CU_ASSERT_EQUAL(concurrent_hash_table_del(&cht, "bar"), -1) // Already deleted
+    CU_ASSERT_EQUAL(concurrent_hash_table_size(&cht), 1)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+}
+
+/**
+ * Value factory that counts its calls, and stores nothing for key "none"
+ */
+static void* test_concurrent_hash_table_compute_func(const void* key, void* calls) {
+    ++*(int *)calls;
+    return strcmp(key, "none") == 0 ? NULL : "computed";
+}
+
+void test_concurrent_hash_table_compute_if_absent() {
+    int calls = 0;
+    concurrent_hash_table cht;
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 4, 16, HASH_TABLE_CHAINED, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(concurrent_hash_table_set(&cht, "foo", "one"), 0) // {"foo": "one"}
+
+    // Existing key
+    CU_ASSERT_STRING_EQUAL(
+        concurrent_hash_table_compute_if_absent(&cht, "foo", test_concurrent_hash_table_compute_func, &calls),
+        "one"
+    )
+    CU_ASSERT_EQUAL(calls, 0)
+
+    // Missing key is computed once
+    CU_ASSERT_STRING_EQUAL(
+        concurrent_hash_table_compute_if_absent(&cht, "bar", test_concurrent_hash_table_compute_func, &calls),
+        "computed"
+    )
+    CU_ASSERT_STRING_EQUAL(
+        concurrent_hash_table_compute_if_absent(&cht, "bar", test_concurrent_hash_table_compute_func, &calls),
+        "computed"
+    )
+    CU_ASSERT_EQUAL(calls, 1)
+    CU_ASSERT_STRING_EQUAL(concurrent_hash_table_get(&cht, "bar"), "computed")
+
+    // NULL values aren't stored
+    CU_ASSERT_PTR_NULL(
+        concurrent_hash_table_compute_if_absent(&cht, "none", test_concurrent_hash_table_compute_func, &calls)
+    )
+    CU_ASSERT_EQUAL(calls, 2)
+    CU_ASSERT_EQUAL(concurrent_hash_table_size(&cht), 2)
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+}
+
+#define TEST_THREADS 4
+#define TEST_KEYS_PER_THREAD 2000
+
+static char test_keys[TEST_THREADS][TEST_KEYS_PER_THREAD][32];
+
+static int test_compute_calls[TEST_KEYS_PER_THREAD];
+
+struct test_concurrent_hash_table_thread_arg {
+    concurrent_hash_table* cht;
+    int thread;
+    int errors;
+};
+
+/**
+ * Value factory that counts its calls per key of thread 0
+ */
+static void* test_concurrent_hash_table_count_func(const void* key, void* _user_arg) {
+    __atomic_fetch_add(&test_compute_calls[atoi((const char *)key + 3)], 1, __ATOMIC_RELAXED);
+    return (void *)key;
+}
+
+/**
+ * Worker thread: sets, gets and deletes its own keys, and computes the keys
+ * of thread 0 along with every other thread
+ */
+static void* test_concurrent_hash_table_thread(void* user_arg) {
+    struct test_concurrent_hash_table_thread_arg* arg = user_arg;
+    char (*keys)[32] = test_keys[arg->thread];
+
+    for (int i = 0; i < TEST_KEYS_PER_THREAD; ++i) {
+        if (concurrent_hash_table_set(arg->cht, keys[i], keys[i]) != 0) {
+            ++arg->errors;
+        }
+
+        if (concurrent_hash_table_compute_if_absent(
+                arg->cht, test_keys[0][i], test_concurrent_hash_table_count_func, NULL
+            ) != test_keys[0][i]) {
+            ++arg->errors;
+        }
+    }
+
+    for (int i = 0; i < TEST_KEYS_PER_THREAD; ++i) {
+        if (concurrent_hash_table_get(arg->cht, keys[i]) != keys[i]) {
+            ++arg->errors;
+        }
+
+        if (i % 2 == 1 && arg->thread != 0 && concurrent_hash_table_del(arg->cht, keys[i]) != 0) {
+            ++arg->errors;
+        }
+    }
+
+    return NULL;
+}
+
+void test_concurrent_hash_table_threads() {
+    pthread_t threads[TEST_THREADS];
+    struct test_concurrent_hash_table_thread_arg args[TEST_THREADS];
+    concurrent_hash_table cht;
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_init(&cht, 8, 4, HASH_TABLE_CHAINED, NULL, NULL), 0)
+
+    for (int t = 0; t < TEST_THREADS; ++t) {
+        for (int i = 0; i < TEST_KEYS_PER_THREAD; ++i) {
+            snprintf(test_keys[t][i], sizeof(test_keys[t][i]), "t%d_%d", t, i);
+        }
+    }
+
+    memset(test_compute_calls, 0, sizeof(test_compute_calls));
+
+    for (int t = 0; t < TEST_THREADS; ++t) {
+        args[t].cht = &cht;
+        args[t].thread = t;
+        args[t].errors = 0;
+        CU_ASSERT_EQUAL_FATAL(pthread_create(&threads[t], NULL, test_concurrent_hash_table_thread, &args[t]), 0)
+    }
+
+    for (int t = 0; t < TEST_THREADS; ++t) {
+        pthread_join(threads[t], NULL);
+        CU_ASSERT_EQUAL(args[t].errors, 0)
+    }
+
+    // Thread 0 keeps all keys, other threads delete half of theirs
+    CU_ASSERT_EQUAL(
+        concurrent_hash_table_size(&cht),
+        TEST_KEYS_PER_THREAD + (TEST_THREADS - 1) * TEST_KEYS_PER_THREAD / 2
+    )
+
+    // A key is computed at most once, and never if thread 0 set it first
+    for (int i = 0; i < TEST_KEYS_PER_THREAD; ++i) {
+        CU_ASSERT(test_compute_calls[i] <= 1)
+    }
+
+    CU_ASSERT_EQUAL(concurrent_hash_table_destroy(&cht), 0)
+}
@@ -0,0 +1,16 @@
+#ifndef __CONCURRENT_HASH_TABLE_TEST_H__
+#define __CONCURRENT_HASH_TABLE_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_concurrent_hash_table_tests();
+
+void test_concurrent_hash_table_get_and_set();
+
+void test_concurrent_hash_table_del();
+
+void test_concurrent_hash_table_compute_if_absent();
+
+void test_concurrent_hash_table_threads();
+
+#endif
@@ -0,0 +1,84 @@
+#include <pthread.h>
+
+#include "epoch_test.h"
+#include "../utils/epoch.h"
+
+CU_TestInfo* get_epoch_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_epoch_retire_and_reclaim", test_epoch_retire_and_reclaim},
+        {"test_epoch_read_section", test_epoch_read_section},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+static int test_epoch_freed = 0;
+
+/**
+ * Counts freed pointers instead of freeing them
+ */
+static void test_epoch_free_func(void* ptr) {
+    ++test_epoch_freed;
+}
+
+void test_epoch_retire_and_reclaim() {
+    int value;
+
+    epoch_barrier();
+    test_epoch_freed = 0;
+
+    CU_ASSERT_EQUAL(epoch_retire(&value, test_epoch_free_func), 0)
+    CU_ASSERT_EQUAL(epoch_retire(&value, test_epoch_free_func), 0)
+
+    // Without readers, it only takes a couple of epochs
+    epoch_reclaim();
+    epoch_reclaim();
+    CU_ASSERT_EQUAL(test_epoch_freed, 2)
+    CU_ASSERT_EQUAL(epoch_reclaim(), 0)
+}
+
+/**
+ * Reader thread: holds a read section until released
+ */
+static void* test_epoch_reader(void* user_arg) {
+    pthread_barrier_t* barrier = user_arg;
+
+    epoch_enter();
+    epoch_enter(); // Nested
+
+    pthread_barrier_wait(barrier); // Entered
+    pthread_barrier_wait(barrier); // Released
+
+    epoch_exit();
+    epoch_exit();
+
+    return NULL;
+}
+
+void test_epoch_read_section() {
+    int value;
+    pthread_t reader;
+    pthread_barrier_t barrier;
+
+    epoch_barrier();
+    test_epoch_freed = 0;
+
+    pthread_barrier_init(&barrier, NULL, 2);
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&reader, NULL, test_epoch_reader, &barrier), 0)
+    pthread_barrier_wait(&barrier);
+
+    // Not freed while a reader is in a section that started before it was retired
+    CU_ASSERT_EQUAL(epoch_retire(&value, test_epoch_free_func), 0)
+    for (int i = 0; i < 10; ++i) {
+        epoch_reclaim();
+    }
+    CU_ASSERT_EQUAL(test_epoch_freed, 0)
+
+    pthread_barrier_wait(&barrier);
+    pthread_join(reader, NULL);
+    pthread_barrier_destroy(&barrier);
+
+    epoch_barrier();
+    CU_ASSERT_EQUAL(test_epoch_freed, 1)
+}
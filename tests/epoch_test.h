@@ -0,0 +1,12 @@
+#ifndef __EPOCH_TEST_H__
+#define __EPOCH_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_epoch_tests();
+
+void test_epoch_retire_and_reclaim();
+
+void test_epoch_read_section();
+
+#endif
@@ -1,6 +1,11 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "hash_table_test.h"
+#include "../utils/epoch.h"
 #include "../utils/hash_table.h"
 
 CU_TestInfo* get_hash_table_tests() {
@@ -15,6 +20,32 @@ CU_TestInfo* get_hash_table_tests() {
         {"test_hash_table_has_no_duplicates", test_hash_table_has_no_duplicates},
         {"test_hash_table_iter", test_hash_table_iter},
         {"test_hash_table_size", test_hash_table_size},
+        {"test_hash_table_auto_grow", test_hash_table_auto_grow},
+        {"test_hash_table_incremental_rehash", test_hash_table_incremental_rehash},
+        {"test_hash_table_max_load_factor", test_hash_table_max_load_factor},
+        {"test_hash_table_cached_hash", test_hash_table_cached_hash},
+        {"test_hash_table_open_get_and_set", test_hash_table_open_get_and_set},
+        {"test_hash_table_open_del", test_hash_table_open_del},
+        {"test_hash_table_open_grow", test_hash_table_open_grow},
+        {"test_hash_table_open_set_entry", test_hash_table_open_set_entry},
+        {"test_hash_table_open_iter", test_hash_table_open_iter},
+        {"test_hash_table_fixed_get_and_set", test_hash_table_fixed_get_and_set},
+        {"test_hash_table_fixed_grow", test_hash_table_fixed_grow},
+        {"test_hash_table_fixed_set_entry", test_hash_table_fixed_set_entry},
+        {"test_hash_table_fixed_iter", test_hash_table_fixed_iter},
+        {"test_hash_table_rcu_get_and_set", test_hash_table_rcu_get_and_set},
+        {"test_hash_table_rcu_del_and_grow", test_hash_table_rcu_del_and_grow},
+        {"test_hash_table_rcu_set_entry", test_hash_table_rcu_set_entry},
+        {"test_hash_table_rcu_concurrent_readers", test_hash_table_rcu_concurrent_readers},
+        {"test_hash_table_filter", test_hash_table_filter},
+        {"test_hash_table_fixed_filter", test_hash_table_fixed_filter},
+        {"test_hash_table_get_and_set_many", test_hash_table_get_and_set_many},
+        {"test_hash_table_compact_get_and_set", test_hash_table_compact_get_and_set},
+        {"test_hash_table_compact_order", test_hash_table_compact_order},
+        {"test_hash_table_compact_set_entry", test_hash_table_compact_set_entry},
+        {"test_hash_table_cursor", test_hash_table_cursor},
+        {"test_hash_table_keys_n", test_hash_table_keys_n},
+        {"test_hash_table_caller_entry", test_hash_table_caller_entry},
         CU_TEST_INFO_NULL,
     };
 
@@ -25,7 +56,7 @@ void test_hash_table_init_and_destroy() {
     hash_table ht;
 
     CU_ASSERT_EQUAL(hash_table_init(&ht, 50, NULL, NULL), 0)
-    CU_ASSERT_EQUAL(ht.index_size, 50)
+    CU_ASSERT_EQUAL(ht.index_size, 64) // Rounded up to a power of 2
 
     CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
     CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
@@ -48,7 +79,7 @@ void test_hash_table_rehash() {
 
     // Rehash
     CU_ASSERT_EQUAL(hash_table_rehash(&ht, 3), 0)
-    CU_ASSERT_EQUAL(ht.index_size, 3)
+    CU_ASSERT_EQUAL(ht.index_size, 4) // Rounded up to a power of 2
     CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
 
     CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
@@ -207,3 +238,1171 @@ void test_hash_table_size() {
     CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
     CU_ASSERT_EQUAL(hash_table_size(&ht), 0)
 }
+
+static int int_key_cmp(const void* key_a, const void* key_b) {
+    return *(const int *)key_a - *(const int *)key_b;
+}
+
+static uint32_t int_key_hash(const void* key) {
+    return (uint32_t)*(const int *)key * 2654435761u;
+}
+
+static int counted_key_cmp_calls = 0;
+static int counted_key_hash_calls = 0;
+
+static int counted_key_cmp(const void* key_a, const void* key_b) {
+    ++counted_key_cmp_calls;
+    return int_key_cmp(key_a, key_b);
+}
+
+static uint32_t counted_key_hash(const void* key) {
+    ++counted_key_hash_calls;
+    return int_key_hash(key);
+}
+
+void test_hash_table_auto_grow() {
+    static char keys[1000][16];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 4, NULL, NULL), 0)
+
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1000)
+    CU_ASSERT(ht.index_size >= 512)
+
+    for (int i = 0; i < 1000; ++i) {
+        CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+    }
+
+    for (int i = 0; i < 1000; i += 2) {
+        CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 500)
+    CU_ASSERT_EQUAL(hash_table_keys(&ht, (void *)keys), 500)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_incremental_rehash() {
+    static char keys[64][16];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 64, NULL, NULL), 0)
+
+    for (int i = 0; i < 64; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    // Load factor exceeded: starts migrating into a twice as large index
+    CU_ASSERT_PTR_NULL(ht.rehash_index)
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0)
+    CU_ASSERT_PTR_NOT_NULL(ht.rehash_index)
+    CU_ASSERT_EQUAL(ht.index_size, 128)
+    CU_ASSERT_EQUAL(ht.rehash_index_size, 64)
+
+    // Entries are found in either index while migrating
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
+    CU_ASSERT_PTR_NOT_NULL(ht.rehash_index)
+    CU_ASSERT_EQUAL(hash_table_del(&ht, keys[63]), 0)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, keys[63]))
+
+    // Every operation migrates a few buckets until done
+    for (int i = 0; i < 62; ++i) {
+        CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+    }
+
+    CU_ASSERT_PTR_NULL(ht.rehash_index)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 64)
+
+    // Same for open addressing
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 64, NULL, NULL), 0)
+
+    for (int i = 0; i < 57; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_PTR_NOT_NULL(ht.rehash_ctrl)
+    CU_ASSERT_EQUAL(ht.index_size, 128)
+    CU_ASSERT_EQUAL(hash_table_del(&ht, keys[0]), 0)
+
+    for (int i = 1; i < 57; ++i) {
+        CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+    }
+
+    CU_ASSERT_PTR_NULL(ht.rehash_ctrl)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, keys[0]))
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 56)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_max_load_factor() {
+    static char keys[100][16];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 10, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, -1), -1)
+
+    // Disable automatic growth
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 0), 0)
+
+    for (int i = 0; i < 100; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(ht.index_size, 16)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    // Open addressing always needs free slots
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 0), -1)
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 1), -1)
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 0.5f), 0)
+
+    for (int i = 0; i < 9; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(ht.index_size, 32)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_cached_hash() {
+    static int keys[100];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 4, counted_key_cmp, counted_key_hash), 0)
+
+    counted_key_cmp_calls = 0;
+    counted_key_hash_calls = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        keys[i] = i;
+        CU_ASSERT_EQUAL(hash_table_set(&ht, &keys[i], &keys[i]), 0)
+    }
+
+    // Distinct hashes: chained entries are never compared
+    CU_ASSERT_EQUAL(counted_key_cmp_calls, 0)
+    CU_ASSERT_EQUAL(counted_key_hash_calls, 100)
+
+    // Rehashing reuses stored hashes
+    CU_ASSERT_EQUAL(hash_table_rehash(&ht, 1024), 0)
+    CU_ASSERT_EQUAL(counted_key_hash_calls, 100)
+
+    CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, &keys[5]), &keys[5])
+    CU_ASSERT_EQUAL(counted_key_cmp_calls, 1)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_open_get_and_set() {
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 50, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(ht.type, HASH_TABLE_OPEN)
+    CU_ASSERT_EQUAL(ht.index_size, 64) // Rounded up to a power of 2
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "bar"), "two")
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "doesnt_exist"))
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "three"), 0) // {"foo": "three", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "three")
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 2)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "foo"))
+}
+
+void test_hash_table_open_del() {
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+
+    CU_ASSERT_EQUAL(hash_table_del(&ht, "bar"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_del(&ht, "bar"), -1)
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "bar"))
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    // Deleted slots can be reused
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "three"), 0) // {"foo": "one", "bar": "three"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "bar"), "three")
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 2)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_open_grow() {
+    static char keys[1000][16];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1000)
+    CU_ASSERT(ht.index_size >= 1000)
+
+    for (int i = 0; i < 1000; i += 2) {
+        CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 500)
+
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2 == 0) {
+            CU_ASSERT_PTR_NULL(hash_table_get(&ht, keys[i]))
+        }
+        else {
+            CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_open_set_entry() {
+    int key = 3;
+    int value = 6;
+    int new_value = 7;
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, int_key_cmp, int_key_hash), 0)
+
+    hash_table_entry* entry = hash_table_init_entry(&key, sizeof(int), &value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 6)
+
+    // Replaces (and destroys) the previous entry
+    entry = hash_table_init_entry(&key, sizeof(int), &new_value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 7)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+static void test_hash_table_open_del_iter_func(const hash_table_entry* entry, const size_t index, void* ht) {
+    hash_table_del(ht, entry->key);
+}
+
+void test_hash_table_open_iter() {
+    hash_table ht;
+    char result[500];
+    memset(result, 0, sizeof(result));
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+
+    CU_ASSERT_EQUAL(hash_table_iter(&ht, test_hash_table_iter_func, result), 0)
+    CU_ASSERT(strcmp(result, "(bar=two)(foo=one)") == 0 || strcmp(result, "(foo=one)(bar=two)") == 0)
+
+    // Deleting while iterating is allowed
+    CU_ASSERT_EQUAL(hash_table_iter(&ht, test_hash_table_open_del_iter_func, &ht), 0)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 0)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_fixed_get_and_set() {
+    uint32_t key = 0x0102a8c0;
+    uint8_t value[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t new_value[6] = {0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb};
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 50, 0, 6), -1)
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 50, sizeof(uint32_t), sizeof(value)), 0)
+    CU_ASSERT_EQUAL(ht.type, HASH_TABLE_OPEN)
+    CU_ASSERT_EQUAL(ht.index_size, 64)
+    CU_ASSERT(ht.slot_size <= 16)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, &key, value), 0)
+
+    // Key and value were copied
+    key = 0x0102a8c0;
+    memset(value, 0, sizeof(value));
+    uint8_t* p_value = hash_table_get(&ht, &key);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_value)
+    CU_ASSERT_EQUAL(p_value[0], 0x00)
+    CU_ASSERT_EQUAL(p_value[5], 0x55)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, &key, new_value), 0)
+    CU_ASSERT_EQUAL(memcmp(hash_table_get(&ht, &key), new_value, sizeof(new_value)), 0)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    key = 0x0202a8c0;
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, &key))
+    CU_ASSERT_EQUAL(hash_table_del(&ht, &key), -1)
+
+    key = 0x0102a8c0;
+    CU_ASSERT_EQUAL(hash_table_del(&ht, &key), 0)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, &key))
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 0)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_fixed_grow() {
+    // 6 byte (MAC address) keys, 8 byte values
+    uint8_t key[6] = {0x00, 0x11, 0x22, 0x00, 0x00, 0x00};
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(key), sizeof(uint64_t)), 0)
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        key[4] = i >> 8;
+        key[5] = i & 0xFF;
+        CU_ASSERT_EQUAL(hash_table_set(&ht, key, &i), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1000)
+    CU_ASSERT(ht.index_size >= 1000)
+
+    for (uint64_t i = 0; i < 1000; i += 2) {
+        key[4] = i >> 8;
+        key[5] = i & 0xFF;
+        CU_ASSERT_EQUAL(hash_table_del(&ht, key), 0)
+    }
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        key[4] = i >> 8;
+        key[5] = i & 0xFF;
+
+        const uint64_t* p_value = hash_table_get(&ht, key);
+        if (i % 2 == 0) {
+            CU_ASSERT_PTR_NULL(p_value)
+        }
+        else {
+            CU_ASSERT_PTR_NOT_NULL_FATAL(p_value)
+            CU_ASSERT_EQUAL(*p_value, i)
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 500)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_fixed_set_entry() {
+    uint32_t key = 3;
+    uint32_t value = 6;
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(key), sizeof(value)), 0)
+
+    // The entry is destroyed once copied into the table
+    hash_table_entry* entry = hash_table_init_entry(&key, sizeof(key), &value, sizeof(value));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(uint32_t *)hash_table_get(&ht, &key), 6)
+
+    // So is a caller-allocated entry, whatever its pooled flag holds
+    entry = malloc(sizeof(hash_table_entry));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    memset(entry, 0xA5, sizeof(hash_table_entry));
+    entry->key = malloc(sizeof(key));
+    entry->value = malloc(sizeof(value));
+    memcpy(entry->key, &key, sizeof(key));
+    memcpy(entry->value, &(uint32_t){7}, sizeof(value));
+    entry->must_destroy = 1;
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(uint32_t *)hash_table_get(&ht, &key), 7)
+
+    // A NULL value is stored as zeroes
+    CU_ASSERT_EQUAL(hash_table_set(&ht, &key, NULL), 0)
+    CU_ASSERT_EQUAL(*(uint32_t *)hash_table_get(&ht, &key), 0)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+/**
+ * Sums the fixed-size keys and values of a hash table
+ */
+static void test_hash_table_fixed_sum_iter_func(const hash_table_entry* entry, const size_t index, void* sum) {
+    *(uint64_t *)sum += *(uint64_t *)entry->key * 1000 + *(uint16_t *)entry->value;
+}
+
+void test_hash_table_fixed_iter() {
+    uint64_t sum = 0;
+    void* keys[3];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(uint64_t), sizeof(uint16_t)), 0)
+
+    for (uint64_t key = 1; key <= 3; ++key) {
+        const uint16_t value = key * 2;
+        CU_ASSERT_EQUAL(hash_table_set(&ht, &key, (void *)&value), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_iter(&ht, test_hash_table_fixed_sum_iter_func, &sum), 0)
+    CU_ASSERT_EQUAL(sum, 6000 + 12)
+
+    CU_ASSERT_EQUAL(hash_table_keys(&ht, keys), 3)
+    CU_ASSERT_EQUAL(*(uint64_t *)keys[0] + *(uint64_t *)keys[1] + *(uint64_t *)keys[2], 6)
+
+    // Deleting while iterating is allowed
+    CU_ASSERT_EQUAL(hash_table_iter(&ht, test_hash_table_open_del_iter_func, &ht), 0)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 0)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_rcu_get_and_set() {
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 50, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(ht.type, HASH_TABLE_RCU)
+    CU_ASSERT_EQUAL(ht.index_size, 64) // Rounded up to a power of 2
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "bar"), "two")
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "doesnt_exist"))
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "three"), 0) // {"foo": "three", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "three")
+    CU_ASSERT_STRING_EQUAL(hash_table_lookup(&ht, "foo"), "three")
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 2)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "foo"))
+
+    epoch_barrier();
+}
+
+void test_hash_table_rcu_del_and_grow() {
+    static char keys[100][16];
+    hash_table ht;
+
+    // Every key lands in the same chain, so deletes rebuild chains of all lengths
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 4, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 0), 0)
+
+    for (int i = 0; i < 100; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(ht.index_size, 4)
+
+    for (int i = 0; i < 100; i += 2) {
+        CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_del(&ht, keys[0]), -1) // Already deleted
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 50)
+
+    // Grows as soon as the load factor is set again
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 1.0f), 0)
+    CU_ASSERT_EQUAL(hash_table_set(&ht, keys[0], keys[0]), 0)
+    CU_ASSERT_EQUAL(ht.index_size, 8)
+    CU_ASSERT_EQUAL(hash_table_rehash(&ht, 100), 0)
+    CU_ASSERT_EQUAL(ht.index_size, 128)
+
+    CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[0]), keys[0])
+    for (int i = 1; i < 100; ++i) {
+        if (i % 2 == 0) {
+            CU_ASSERT_PTR_NULL(hash_table_get(&ht, keys[i]))
+        }
+        else {
+            CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+        }
+    }
+
+    // Deleting while iterating is allowed
+    CU_ASSERT_EQUAL(hash_table_iter(&ht, test_hash_table_open_del_iter_func, &ht), 0)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 0)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    epoch_barrier();
+}
+
+void test_hash_table_rcu_set_entry() {
+    int key = 3;
+    int value = 6;
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 16, int_key_cmp, int_key_hash), 0)
+
+    // Copied entries are released once they are replaced and no reader can see them
+    hash_table_entry* entry = hash_table_init_entry(&key, sizeof(int), &value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 6)
+
+    value = 7;
+    entry = hash_table_init_entry(&key, sizeof(int), &value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 7)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    epoch_barrier();
+}
+
+#define RCU_TEST_READERS 4
+#define RCU_TEST_KEYS 256
+#define RCU_TEST_ROUNDS 50
+
+struct test_hash_table_rcu_arg {
+    hash_table* ht;
+    char (*keys)[16];
+    atomic_int* done;
+    int errors;
+};
+
+/**
+ * Reader thread: looks up every key until the writer is done
+ * Keys 0-127 are never deleted, keys 128-255 come and go
+ */
+static void* test_hash_table_rcu_reader(void* user_arg) {
+    struct test_hash_table_rcu_arg* arg = user_arg;
+
+    while (!atomic_load(arg->done)) {
+        for (int i = 0; i < RCU_TEST_KEYS; ++i) {
+            const char* value = hash_table_get(arg->ht, arg->keys[i]);
+            if ((i < RCU_TEST_KEYS / 2 && value != arg->keys[i]) || (value != NULL && value != arg->keys[i])) {
+                ++arg->errors;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void test_hash_table_rcu_concurrent_readers() {
+    static char keys[RCU_TEST_KEYS][16];
+    pthread_t readers[RCU_TEST_READERS];
+    struct test_hash_table_rcu_arg args[RCU_TEST_READERS];
+    atomic_int done = 0;
+    hash_table ht;
+
+    // Small initial index, so that the writer also publishes new indexes
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 4, NULL, NULL), 0)
+
+    for (int i = 0; i < RCU_TEST_KEYS / 2; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    for (int i = RCU_TEST_KEYS / 2; i < RCU_TEST_KEYS; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+    }
+
+    for (int t = 0; t < RCU_TEST_READERS; ++t) {
+        args[t].ht = &ht;
+        args[t].keys = keys;
+        args[t].done = &done;
+        args[t].errors = 0;
+        CU_ASSERT_EQUAL_FATAL(pthread_create(&readers[t], NULL, test_hash_table_rcu_reader, &args[t]), 0)
+    }
+
+    // Writer: replaces stable keys, and adds and deletes the others
+    for (int round = 0; round < RCU_TEST_ROUNDS; ++round) {
+        for (int i = 0; i < RCU_TEST_KEYS; ++i) {
+            CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+        }
+
+        for (int i = RCU_TEST_KEYS / 2; i < RCU_TEST_KEYS; ++i) {
+            CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i]), 0)
+        }
+
+        if (round % 10 == 0) {
+            CU_ASSERT_EQUAL(hash_table_rehash(&ht, ht.index_size * 2), 0)
+        }
+    }
+
+    atomic_store(&done, 1);
+
+    for (int t = 0; t < RCU_TEST_READERS; ++t) {
+        pthread_join(readers[t], NULL);
+        CU_ASSERT_EQUAL(args[t].errors, 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), RCU_TEST_KEYS / 2)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    epoch_barrier();
+}
+
+/**
+ * Check a string-keyed table with an attached filter
+ * Half the keys are set before attaching the filter, half after
+ *
+ * @param ht Empty hash table
+ */
+static void check_filter(hash_table* ht) {
+    static char keys[200][16];
+    static char missing[1000][24];
+    bloom_filter filter;
+    size_t excluded = 0;
+
+    CU_ASSERT_EQUAL_FATAL(bloom_filter_init(&filter, 200, 10), 0)
+
+    for (int i = 0; i < 200; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(missing[i], sizeof(missing[i]), "missing%d", i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_attach_filter(ht, &filter), 0)
+    CU_ASSERT_PTR_EQUAL(ht->filter, &filter)
+
+    for (int i = 100; i < 200; ++i) {
+        if (i % 2 == 0) {
+            CU_ASSERT_EQUAL(hash_table_set(ht, keys[i], keys[i]), 0)
+        }
+        else {
+            hash_table_entry* p_entry = hash_table_init_entry(keys[i], strlen(keys[i]) + 1, "entry", 6);
+            CU_ASSERT_EQUAL(hash_table_set_entry(ht, p_entry), 0)
+        }
+    }
+
+    // No false negatives
+    for (int i = 0; i < 200; ++i) {
+        CU_ASSERT_TRUE(bloom_filter_contains(&filter, hash_table_hash_key(ht, keys[i])))
+        CU_ASSERT_PTR_NOT_NULL(hash_table_get(ht, keys[i]))
+        CU_ASSERT_PTR_NOT_NULL(hash_table_lookup(ht, keys[i]))
+    }
+
+    // Most missing keys never reach the table
+    for (int i = 0; i < 1000; ++i) {
+        excluded += !bloom_filter_contains(&filter, hash_table_hash_key(ht, missing[i]));
+        CU_ASSERT_PTR_NULL(hash_table_get(ht, missing[i]))
+        CU_ASSERT_PTR_NULL(hash_table_lookup(ht, missing[i]))
+        CU_ASSERT_EQUAL(hash_table_del(ht, missing[i]), -1)
+    }
+    CU_ASSERT(excluded > 950)
+
+    // Deleted keys are gone from the table (though still in the filter)
+    for (int i = 0; i < 200; i += 3) {
+        CU_ASSERT_EQUAL(hash_table_del(ht, keys[i]), 0)
+        CU_ASSERT_PTR_NULL(hash_table_get(ht, keys[i]))
+    }
+
+    // Reattaching rebuilds the filter from the remaining keys
+    CU_ASSERT_EQUAL(hash_table_attach_filter(ht, &filter), 0)
+    for (int i = 0; i < 200; ++i) {
+        CU_ASSERT_EQUAL(hash_table_get(ht, keys[i]) != NULL, i % 3 != 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_attach_filter(ht, NULL), 0)
+    CU_ASSERT_PTR_NULL(ht->filter)
+    CU_ASSERT_PTR_NOT_NULL(hash_table_get(ht, keys[1]))
+
+    CU_ASSERT_EQUAL(hash_table_attach_filter(ht, &filter), 0)
+    CU_ASSERT_EQUAL(hash_table_destroy(ht), 0)
+    CU_ASSERT_PTR_NULL(ht->filter)
+
+    bloom_filter_destroy(&filter);
+}
+
+void test_hash_table_filter() {
+    hash_table ht;
+    bloom_filter filter;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 16, NULL, NULL), 0)
+    check_filter(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    check_filter(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, NULL, NULL), 0)
+    check_filter(&ht);
+
+    // RCU readers would race with filter updates
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 16, 10), 0)
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_attach_filter(&ht, &filter), -1)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    bloom_filter_destroy(&filter);
+
+    epoch_barrier();
+}
+
+void test_hash_table_fixed_filter() {
+    hash_table ht;
+    bloom_filter filter;
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(uint32_t), sizeof(uint32_t)), 0)
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 1000, 10), 0)
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(&ht, &i, &i), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_attach_filter(&ht, &filter), 0)
+
+    for (uint32_t i = 500; i < 1000; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(&ht, &i, &i), 0)
+    }
+
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const uint32_t* p_value = hash_table_get(&ht, &i);
+
+        if (i < 1000) {
+            CU_ASSERT_PTR_NOT_NULL_FATAL(p_value)
+            CU_ASSERT_EQUAL(*p_value, i)
+        }
+        else {
+            CU_ASSERT_PTR_NULL(p_value)
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    bloom_filter_destroy(&filter);
+}
+
+/**
+ * Check batch sets and gets against single gets
+ * Batches span several prefetch groups, and don't end on a group boundary
+ *
+ * @param ht Empty hash table (string keys, or fixed-size uint32_t keys and values)
+ */
+static void check_get_and_set_many(hash_table* ht) {
+    enum { KEY_COUNT = 1000 };
+    static char str_keys[2 * KEY_COUNT][16];
+    static uint32_t u32_keys[2 * KEY_COUNT];
+    void* keys[2 * KEY_COUNT];
+    void* even_keys[KEY_COUNT];
+    void* values[2 * KEY_COUNT];
+    const int fixed = ht->key_size != 0;
+
+    for (int i = 0; i < 2 * KEY_COUNT; ++i) {
+        snprintf(str_keys[i], sizeof(str_keys[i]), "key%d", i);
+        u32_keys[i] = i;
+        keys[i] = fixed ? (void *)&u32_keys[i] : (void *)str_keys[i];
+    }
+
+    // Even keys, in one batch
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        even_keys[i] = keys[2 * i];
+    }
+    CU_ASSERT_EQUAL(hash_table_set_many(ht, even_keys, even_keys, KEY_COUNT), 0)
+    CU_ASSERT_EQUAL(hash_table_size(ht), KEY_COUNT)
+
+    // All keys, in order
+    CU_ASSERT_EQUAL(hash_table_get_many(ht, (const void* const*)keys, 2 * KEY_COUNT - 3, values), KEY_COUNT - 1)
+
+    for (int i = 0; i < 2 * KEY_COUNT - 3; ++i) {
+        CU_ASSERT_PTR_EQUAL(values[i], hash_table_get(ht, keys[i]))
+
+        if (i % 2 != 0) {
+            CU_ASSERT_PTR_NULL(values[i])
+        }
+        else if (fixed) {
+            CU_ASSERT_PTR_NOT_NULL_FATAL(values[i])
+            CU_ASSERT_EQUAL(*(uint32_t *)values[i], i)
+        }
+        else {
+            CU_ASSERT_PTR_EQUAL(values[i], keys[i])
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_get_many(ht, (const void* const*)keys, 0, values), 0)
+    CU_ASSERT_EQUAL(hash_table_destroy(ht), 0)
+}
+
+void test_hash_table_get_and_set_many() {
+    hash_table ht;
+    bloom_filter filter;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 16, NULL, NULL), 0)
+    check_get_and_set_many(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    check_get_and_set_many(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(uint32_t), sizeof(uint32_t)), 0)
+    check_get_and_set_many(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, NULL, NULL), 0)
+    check_get_and_set_many(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 16, NULL, NULL), 0)
+    check_get_and_set_many(&ht);
+    epoch_barrier();
+
+    CU_ASSERT_EQUAL(bloom_filter_init(&filter, 1000, 10), 0)
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_attach_filter(&ht, &filter), 0)
+    check_get_and_set_many(&ht);
+    bloom_filter_destroy(&filter);
+}
+
+void test_hash_table_compact_get_and_set() {
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 50, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(ht.type, HASH_TABLE_COMPACT)
+    CU_ASSERT_EQUAL(ht.index_size, 64) // Rounded up to a power of 2
+    CU_ASSERT_EQUAL(ht.compact_index_width, 1)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0) // {"foo": "one"}
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0) // {"foo": "one", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "one")
+    CU_ASSERT_STRING_EQUAL(hash_table_lookup(&ht, "bar"), "two")
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "doesnt_exist"))
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "three"), 0) // {"foo": "three", "bar": "two"}
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "foo"), "three")
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 2)
+
+    CU_ASSERT_EQUAL(hash_table_del(&ht, "foo"), 0) // {"bar": "two"}
+    CU_ASSERT_EQUAL(hash_table_del(&ht, "foo"), -1)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "foo"))
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    CU_ASSERT_EQUAL(hash_table_set_max_load_factor(&ht, 1.0f), -1)
+    CU_ASSERT_EQUAL(hash_table_rehash(&ht, 1000), 0)
+    CU_ASSERT_EQUAL(ht.index_size, 1024)
+    CU_ASSERT_EQUAL(ht.compact_index_width, 2)
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, "bar"), "two")
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    CU_ASSERT_PTR_NULL(hash_table_get(&ht, "bar"))
+}
+
+/**
+ * Check that a compact hash table holds the odd keys of keys, in order
+ *
+ * @param ht Hash table
+ * @param keys Keys
+ * @param key_count Number of keys
+ */
+static void check_compact_odd_keys(hash_table* ht, char (*keys)[16], const int key_count) {
+    static void* table_keys[1000];
+    hash_table_cursor cursor;
+    const hash_table_entry* p_entry;
+    size_t count;
+    int i = 1;
+
+    CU_ASSERT_EQUAL_FATAL(hash_table_keys_n(ht, table_keys, 1000, &count), 0)
+    CU_ASSERT_EQUAL_FATAL(count, key_count / 2)
+
+    CU_ASSERT_EQUAL(hash_table_cursor_init(&cursor, ht), 0)
+    while ((p_entry = hash_table_cursor_next(&cursor)) != NULL) {
+        CU_ASSERT_PTR_EQUAL(p_entry->key, keys[i])
+        CU_ASSERT_PTR_EQUAL(table_keys[i / 2], keys[i])
+        i += 2;
+    }
+
+    CU_ASSERT_EQUAL(i, key_count + 1)
+}
+
+void test_hash_table_compact_order() {
+    static char keys[1000][16];
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 8, NULL, NULL), 0)
+
+    // Grows through 1 and 2-byte indexes
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1000)
+    CU_ASSERT_EQUAL(ht.compact_index_width, 2)
+    CU_ASSERT(ht.entries_used <= ht.entries_capacity)
+    CU_ASSERT(ht.entries_capacity < ht.index_size)
+
+    for (int i = 0; i < 1000; i += 2) {
+        CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i]), 0)
+    }
+
+    // Deletes leave holes, which iteration skips
+    CU_ASSERT_EQUAL(ht.entries_used, 1000)
+    check_compact_odd_keys(&ht, keys, 1000);
+
+    // Replacing a value keeps its position
+    CU_ASSERT_EQUAL(hash_table_set(&ht, keys[1], "first"), 0)
+    CU_ASSERT_STRING_EQUAL(hash_table_get(&ht, keys[1]), "first")
+    check_compact_odd_keys(&ht, keys, 1000);
+
+    // Resizing squeezes the holes out, in order
+    CU_ASSERT_EQUAL(hash_table_rehash(&ht, 16), 0)
+    CU_ASSERT_EQUAL(ht.entries_used, 500)
+    CU_ASSERT(ht.entries_capacity > 500)
+    check_compact_odd_keys(&ht, keys, 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2 == 0) {
+            CU_ASSERT_PTR_NULL(hash_table_get(&ht, keys[i]))
+        }
+        else if (i > 1) {
+            CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    // A few keys added and deleted over and over reuse the same index
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 64, NULL, NULL), 0)
+
+    for (int i = 0; i < 1000; ++i) {
+        CU_ASSERT_EQUAL(hash_table_set(&ht, keys[i], keys[i]), 0)
+        if (i >= 4) {
+            CU_ASSERT_EQUAL(hash_table_del(&ht, keys[i - 4]), 0)
+        }
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 4)
+    CU_ASSERT_EQUAL(ht.index_size, 64)
+
+    for (int i = 996; i < 1000; ++i) {
+        CU_ASSERT_PTR_EQUAL(hash_table_get(&ht, keys[i]), keys[i])
+    }
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+void test_hash_table_compact_set_entry() {
+    int key = 3;
+    int value = 6;
+    int new_value = 7;
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, int_key_cmp, int_key_hash), 0)
+
+    hash_table_entry* entry = hash_table_init_entry(&key, sizeof(int), &value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 6)
+
+    // Replaces (and destroys) the previous entry
+    entry = hash_table_init_entry(&key, sizeof(int), &new_value, sizeof(int));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &key), 7)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    // Entries not from hash_table_init_entry() are copied, then freed
+    entry = calloc(1, sizeof(hash_table_entry));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(entry)
+    entry->key = &new_value;
+    entry->value = &value;
+    CU_ASSERT_EQUAL(hash_table_set_entry(&ht, entry), 0)
+    CU_ASSERT_EQUAL(*(int *)hash_table_get(&ht, &new_value), 6)
+
+    CU_ASSERT_EQUAL(hash_table_del(&ht, &key), 0)
+    CU_ASSERT_EQUAL(hash_table_size(&ht), 1)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+}
+
+/**
+ * Walk a hash table holding keys with a cursor, deleting every other entry
+ * on the way, then walk it again
+ *
+ * @param ht Hash table (string keys, or fixed-size uint32_t keys and values)
+ */
+static void check_cursor(hash_table* ht) {
+    enum { KEY_COUNT = 300 };
+    static char str_keys[KEY_COUNT][16];
+    static uint32_t u32_keys[KEY_COUNT];
+    static uint8_t seen[KEY_COUNT];
+    const int fixed = ht->key_size != 0;
+    hash_table_cursor cursor;
+    const hash_table_entry* p_entry;
+    size_t count = 0;
+
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(str_keys[i], sizeof(str_keys[i]), "%d", i);
+        u32_keys[i] = i;
+        CU_ASSERT_EQUAL(hash_table_set(ht, fixed ? (void *)&u32_keys[i] : str_keys[i], &u32_keys[i]), 0)
+    }
+
+    memset(seen, 0, sizeof(seen));
+
+    CU_ASSERT_EQUAL_FATAL(hash_table_cursor_init(&cursor, ht), 0)
+    while ((p_entry = hash_table_cursor_next(&cursor)) != NULL) {
+        const uint32_t i = fixed ? *(uint32_t *)p_entry->key : (uint32_t)atoi(p_entry->key);
+
+        CU_ASSERT_FATAL(i < KEY_COUNT)
+        CU_ASSERT_EQUAL(*(uint32_t *)p_entry->value, i)
+        CU_ASSERT_EQUAL(p_entry->hash, hash_table_hash_key(ht, p_entry->key))
+        ++seen[i];
+
+        // Deleting the entry just returned is allowed
+        if (++count % 2 == 0) {
+            CU_ASSERT_EQUAL(hash_table_del(ht, fixed ? (void *)&u32_keys[i] : str_keys[i]), 0)
+        }
+    }
+
+    CU_ASSERT_EQUAL(count, KEY_COUNT)
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        CU_ASSERT_EQUAL(seen[i], 1)
+    }
+
+    CU_ASSERT_EQUAL(hash_table_size(ht), KEY_COUNT / 2)
+
+    count = 0;
+    CU_ASSERT_EQUAL_FATAL(hash_table_cursor_init(&cursor, ht), 0)
+    while (hash_table_cursor_next(&cursor) != NULL) {
+        ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, KEY_COUNT / 2)
+    CU_ASSERT_PTR_NULL(hash_table_cursor_next(&cursor))
+
+    CU_ASSERT_EQUAL(hash_table_destroy(ht), 0)
+    CU_ASSERT_EQUAL(hash_table_cursor_init(&cursor, ht), -1)
+}
+
+void test_hash_table_cursor() {
+    hash_table ht;
+    hash_table_cursor cursor;
+
+    // Small initial sizes, so that chained and open tables are mid-rehash
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 16, NULL, NULL), 0)
+    check_cursor(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    check_cursor(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_fixed(&ht, 16, sizeof(uint32_t), sizeof(uint32_t)), 0)
+    check_cursor(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, NULL, NULL), 0)
+    check_cursor(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(hash_table_cursor_init(&cursor, &ht), -1)
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+    epoch_barrier();
+}
+
+void test_hash_table_keys_n() {
+    hash_table ht;
+    void* items[4] = { NULL, NULL, NULL, NULL };
+    size_t count = 1;
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, NULL, NULL), 0)
+
+    CU_ASSERT_EQUAL(hash_table_keys_n(&ht, items, 0, &count), 0)
+    CU_ASSERT_EQUAL(count, 0)
+
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "foo", "one"), 0)
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "bar", "two"), 0)
+    CU_ASSERT_EQUAL(hash_table_set(&ht, "baz", "three"), 0)
+
+    // Truncated: only the first items are written
+    CU_ASSERT_EQUAL(hash_table_keys_n(&ht, items, 2, &count), 0)
+    CU_ASSERT_EQUAL(count, 3)
+    CU_ASSERT_STRING_EQUAL(items[0], "foo")
+    CU_ASSERT_STRING_EQUAL(items[1], "bar")
+    CU_ASSERT_PTR_NULL(items[2])
+
+    CU_ASSERT_EQUAL(hash_table_values_n(&ht, items, 0, &count), 0)
+    CU_ASSERT_EQUAL(count, 3)
+    CU_ASSERT_STRING_EQUAL(items[0], "foo")
+
+    CU_ASSERT_EQUAL(hash_table_values_n(&ht, items, 4, &count), 0)
+    CU_ASSERT_EQUAL(count, 3)
+    CU_ASSERT_STRING_EQUAL(items[0], "one")
+    CU_ASSERT_STRING_EQUAL(items[1], "two")
+    CU_ASSERT_STRING_EQUAL(items[2], "three")
+    CU_ASSERT_PTR_NULL(items[3])
+
+    CU_ASSERT_EQUAL(hash_table_destroy(&ht), 0)
+
+    // Failure is told apart from a truncated array
+    count = 5;
+    CU_ASSERT_EQUAL(hash_table_keys_n(&ht, items, 4, &count), -1)
+    CU_ASSERT_EQUAL(hash_table_values_n(&ht, items, 4, &count), -1)
+    CU_ASSERT_EQUAL(count, 5)
+    CU_ASSERT_EQUAL(hash_table_keys(&ht, items), (size_t)-1)
+}
+
+/**
+ * Allocate a must_destroy entry the way a caller would: key and value apart
+ * from the entry
+ *
+ * @param key Key (copied)
+ * @param value Value (copied)
+ * @return Entry
+ */
+static hash_table_entry* caller_entry(const char* key, const char* value) {
+    hash_table_entry* p_entry = malloc(sizeof(hash_table_entry));
+
+    // Flags the hash table sets itself are left as garbage
+    memset(p_entry, 0xA5, sizeof(hash_table_entry));
+    p_entry->key = strdup(key);
+    p_entry->value = strdup(value);
+    p_entry->must_destroy = 1;
+
+    return p_entry;
+}
+
+/**
+ * Set, replace, delete and destroy caller-allocated and
+ * hash_table_init_entry() entries (leaks and bad frees show under ASan)
+ *
+ * @param ht Empty hash table (string keys)
+ */
+static void check_caller_entry(hash_table* ht) {
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, caller_entry("foo", "one")), 0)
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, caller_entry("bar", "two")), 0)
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, hash_table_init_entry("baz", 4, "three", 6)), 0)
+
+    // Replacing frees the previous key and value
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, caller_entry("foo", "four")), 0)
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, caller_entry("baz", "five")), 0)
+    CU_ASSERT_EQUAL(hash_table_set_entry(ht, hash_table_init_entry("bar", 4, "six", 4)), 0)
+    CU_ASSERT_STRING_EQUAL(hash_table_get(ht, "foo"), "four")
+    CU_ASSERT_STRING_EQUAL(hash_table_get(ht, "bar"), "six")
+    CU_ASSERT_STRING_EQUAL(hash_table_get(ht, "baz"), "five")
+
+    CU_ASSERT_EQUAL(hash_table_del(ht, "foo"), 0)
+    CU_ASSERT_EQUAL(hash_table_del(ht, "bar"), 0)
+    CU_ASSERT_EQUAL(hash_table_size(ht), 1)
+
+    CU_ASSERT_EQUAL(hash_table_destroy(ht), 0)
+}
+
+void test_hash_table_caller_entry() {
+    hash_table ht;
+
+    CU_ASSERT_EQUAL(hash_table_init(&ht, 16, NULL, NULL), 0)
+    check_caller_entry(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_open(&ht, 16, NULL, NULL), 0)
+    check_caller_entry(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_compact(&ht, 16, NULL, NULL), 0)
+    check_caller_entry(&ht);
+
+    CU_ASSERT_EQUAL(hash_table_init_rcu(&ht, 16, NULL, NULL), 0)
+    check_caller_entry(&ht);
+    epoch_barrier();
+}
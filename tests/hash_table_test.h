@@ -25,4 +25,56 @@ void test_hash_table_iter();
 
 void test_hash_table_size();
 
+void test_hash_table_auto_grow();
+
+void test_hash_table_incremental_rehash();
+
+void test_hash_table_max_load_factor();
+
+void test_hash_table_cached_hash();
+
+void test_hash_table_open_get_and_set();
+
+void test_hash_table_open_del();
+
+void test_hash_table_open_grow();
+
+void test_hash_table_open_set_entry();
+
+void test_hash_table_open_iter();
+
+void test_hash_table_fixed_get_and_set();
+
+void test_hash_table_fixed_grow();
+
+void test_hash_table_fixed_set_entry();
+
+void test_hash_table_fixed_iter();
+
+void test_hash_table_rcu_get_and_set();
+
+void test_hash_table_rcu_del_and_grow();
+
+void test_hash_table_rcu_set_entry();
+
+void test_hash_table_rcu_concurrent_readers();
+
+void test_hash_table_filter();
+
+void test_hash_table_fixed_filter();
+
+void test_hash_table_get_and_set_many();
+
+void test_hash_table_compact_get_and_set();
+
+void test_hash_table_compact_order();
+
+void test_hash_table_compact_set_entry();
+
+void test_hash_table_cursor();
+
+void test_hash_table_keys_n();
+
+void test_hash_table_caller_entry();
+
 #endif
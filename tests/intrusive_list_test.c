@@ -0,0 +1,162 @@
+#include <stdlib.h>
+
+#include "intrusive_list_test.h"
+#include "../utils/intrusive_list.h"
+
+/**
+ * Struct listed by the tests
+ */
+typedef struct test_item {
+    int id;
+    intrusive_list_node link;
+} test_item;
+
+CU_TestInfo* get_intrusive_list_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_intrusive_list", test_intrusive_list},
+        {"test_intrusive_list_insert_and_move", test_intrusive_list_insert_and_move},
+        {"test_intrusive_list_foreach_safe", test_intrusive_list_foreach_safe},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+/**
+ * Check the ids of the items of a list, in both directions
+ *
+ * @param lst List
+ * @param ids Expected ids, from head to tail
+ * @param count Number of expected ids
+ */
+static void check_ids(const intrusive_list* lst, const int* ids, const size_t count) {
+    const intrusive_list_node* p_node;
+    size_t i = 0;
+
+    CU_ASSERT_EQUAL(lst->size, count)
+
+    INTRUSIVE_LIST_FOREACH(lst, p_node) {
+        CU_ASSERT_FATAL(i < count)
+        CU_ASSERT_EQUAL(INTRUSIVE_LIST_ENTRY(p_node, test_item, link)->id, ids[i])
+        ++i;
+    }
+    CU_ASSERT_EQUAL(i, count)
+
+    p_node = intrusive_list_tail(lst);
+    for (i = count; i > 0; --i) {
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_node)
+        CU_ASSERT_EQUAL(INTRUSIVE_LIST_ENTRY(p_node, test_item, link)->id, ids[i - 1])
+        p_node = intrusive_list_prev(lst, p_node);
+    }
+    CU_ASSERT_PTR_NULL(p_node)
+}
+
+void test_intrusive_list() {
+    intrusive_list lst;
+    test_item items[4];
+
+    for (int i = 0; i < 4; ++i) {
+        items[i].id = i;
+        intrusive_list_node_init(&items[i].link);
+        CU_ASSERT_FALSE(intrusive_list_is_linked(&items[i].link))
+    }
+
+    intrusive_list_init(&lst);
+    CU_ASSERT_TRUE(intrusive_list_is_empty(&lst))
+    CU_ASSERT_EQUAL(lst.size, 0)
+    CU_ASSERT_PTR_NULL(intrusive_list_head(&lst))
+    CU_ASSERT_PTR_NULL(intrusive_list_tail(&lst))
+    CU_ASSERT_PTR_NULL(intrusive_list_pop_head(&lst))
+    CU_ASSERT_PTR_NULL(intrusive_list_pop_tail(&lst))
+
+    intrusive_list_push_tail(&lst, &items[1].link); // [1]
+    intrusive_list_push_tail(&lst, &items[2].link); // [1, 2]
+    intrusive_list_push_head(&lst, &items[0].link); // [0, 1, 2]
+    intrusive_list_push_tail(&lst, &items[3].link); // [0, 1, 2, 3]
+    CU_ASSERT_FALSE(intrusive_list_is_empty(&lst))
+    CU_ASSERT_TRUE(intrusive_list_is_linked(&items[2].link))
+
+    const int all[] = {0, 1, 2, 3};
+    check_ids(&lst, all, 4);
+    CU_ASSERT_PTR_EQUAL(intrusive_list_head(&lst), &items[0].link)
+    CU_ASSERT_PTR_EQUAL(intrusive_list_tail(&lst), &items[3].link)
+    CU_ASSERT_PTR_EQUAL(intrusive_list_next(&lst, &items[0].link), &items[1].link)
+    CU_ASSERT_PTR_NULL(intrusive_list_next(&lst, &items[3].link))
+    CU_ASSERT_PTR_NULL(intrusive_list_prev(&lst, &items[0].link))
+
+    // Unlink from the middle by handle
+    intrusive_list_unlink(&lst, &items[2].link); // [0, 1, 3]
+    CU_ASSERT_FALSE(intrusive_list_is_linked(&items[2].link))
+    const int without_2[] = {0, 1, 3};
+    check_ids(&lst, without_2, 3);
+
+    CU_ASSERT_PTR_EQUAL(intrusive_list_pop_head(&lst), &items[0].link) // [1, 3]
+    CU_ASSERT_PTR_EQUAL(intrusive_list_pop_tail(&lst), &items[3].link) // [1]
+    CU_ASSERT_PTR_EQUAL(intrusive_list_pop_tail(&lst), &items[1].link) // []
+    CU_ASSERT_TRUE(intrusive_list_is_empty(&lst))
+    CU_ASSERT_EQUAL(lst.size, 0)
+}
+
+void test_intrusive_list_insert_and_move() {
+    intrusive_list lst;
+    test_item items[5];
+
+    for (int i = 0; i < 5; ++i) {
+        items[i].id = i;
+    }
+
+    intrusive_list_init(&lst);
+
+    intrusive_list_push_tail(&lst, &items[2].link); // [2]
+    intrusive_list_insert_before(&lst, &items[2].link, &items[0].link); // [0, 2]
+    intrusive_list_insert_after(&lst, &items[2].link, &items[4].link); // [0, 2, 4]
+    intrusive_list_insert_after(&lst, &items[0].link, &items[1].link); // [0, 1, 2, 4]
+    intrusive_list_insert_before(&lst, &items[4].link, &items[3].link); // [0, 1, 2, 3, 4]
+
+    const int inserted[] = {0, 1, 2, 3, 4};
+    check_ids(&lst, inserted, 5);
+
+    intrusive_list_move_to_head(&lst, &items[3].link); // [3, 0, 1, 2, 4]
+    intrusive_list_move_to_tail(&lst, &items[0].link); // [3, 1, 2, 4, 0]
+    intrusive_list_move_to_tail(&lst, &items[0].link); // [3, 1, 2, 4, 0]
+    intrusive_list_move_to_head(&lst, &items[3].link); // [3, 1, 2, 4, 0]
+
+    const int moved[] = {3, 1, 2, 4, 0};
+    check_ids(&lst, moved, 5);
+}
+
+void test_intrusive_list_foreach_safe() {
+    intrusive_list lst;
+    intrusive_list_node *p_node, *p_next;
+
+    intrusive_list_init(&lst);
+
+    for (int i = 0; i < 10; ++i) {
+        test_item* p_item = malloc(sizeof(test_item));
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_item)
+        p_item->id = i;
+        intrusive_list_push_tail(&lst, &p_item->link);
+    }
+
+    // Free the odd items while iterating
+    INTRUSIVE_LIST_FOREACH_SAFE(&lst, p_node, p_next) {
+        test_item* p_item = INTRUSIVE_LIST_ENTRY(p_node, test_item, link);
+
+        if (p_item->id % 2 != 0) {
+            intrusive_list_unlink(&lst, p_node);
+            free(p_item);
+        }
+    }
+
+    const int even[] = {0, 2, 4, 6, 8};
+    check_ids(&lst, even, 5);
+
+    // Free everything
+    INTRUSIVE_LIST_FOREACH_SAFE(&lst, p_node, p_next) {
+        intrusive_list_unlink(&lst, p_node);
+        free(INTRUSIVE_LIST_ENTRY(p_node, test_item, link));
+    }
+
+    CU_ASSERT_TRUE(intrusive_list_is_empty(&lst))
+    CU_ASSERT_EQUAL(lst.size, 0)
+}
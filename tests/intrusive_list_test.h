@@ -0,0 +1,14 @@
+#ifndef __INTRUSIVE_LIST_TEST_H__
+#define __INTRUSIVE_LIST_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_intrusive_list_tests();
+
+void test_intrusive_list();
+
+void test_intrusive_list_insert_and_move();
+
+void test_intrusive_list_foreach_safe();
+
+#endif
@@ -1,11 +1,15 @@
 #include "linked_list_test.h"
 #include "../utils/linked_list.h"
+#include "../utils/slab.h"
 
 CU_TestInfo* get_list_tests() {
     static CU_TestInfo tests[] = {
         {"test_linked_list_init_and_destroy", test_linked_list_init_and_destroy},
         {"test_linked_list", test_linked_list},
         {"test_linked_list_iter", test_linked_list_iter},
+        {"test_linked_list_insert_at", test_linked_list_insert_at},
+        {"test_linked_list_get_and_del_at", test_linked_list_get_and_del_at},
+        {"test_linked_list_splice", test_linked_list_splice},
         CU_TEST_INFO_NULL,
     };
 
@@ -86,3 +90,174 @@ void test_linked_list_iter() {
 
     CU_ASSERT_EQUAL(linked_list_destroy(&lst), 0)
 }
+
+/**
+ * Check the values of a list of strings, following the links in both
+ * directions
+ *
+ * @param lst List
+ * @param values Expected values, from head to tail
+ * @param count Number of expected values
+ */
+static void check_values(const list* lst, const char* const* values, const size_t count) {
+    CU_ASSERT_EQUAL_FATAL(lst->size, count)
+
+    const list_node* p_node = lst->head;
+    for (size_t i = 0; i < count; ++i) {
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_node)
+        CU_ASSERT_STRING_EQUAL(p_node->value, values[i])
+        p_node = p_node->next;
+    }
+    CU_ASSERT_PTR_NULL(p_node)
+
+    p_node = lst->tail;
+    for (size_t i = count; i > 0; --i) {
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_node)
+        CU_ASSERT_STRING_EQUAL(p_node->value, values[i - 1])
+        p_node = p_node->prev;
+    }
+    CU_ASSERT_PTR_NULL(p_node)
+}
+
+void test_linked_list_insert_at() {
+    list lst;
+
+    CU_ASSERT_EQUAL(linked_list_init(&lst), 0)
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "foo", 1), -1)
+
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "c", 0), 0) // ["c"]
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "a", 0), 0) // ["a", "c"] (head)
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "e", 2), 0) // ["a", "c", "e"] (tail)
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "b", 1), 0) // ["a", "b", "c", "e"] (middle, from the head)
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "d", 3), 0) // ["a", "b", "c", "d", "e"] (middle, from the tail)
+    CU_ASSERT_EQUAL(linked_list_insert_at(&lst, "f", 6), -1)
+
+    const char* const expected[] = {"a", "b", "c", "d", "e"};
+    check_values(&lst, expected, 5);
+
+    CU_ASSERT_EQUAL(linked_list_destroy(&lst), 0)
+}
+
+void test_linked_list_get_and_del_at() {
+    list lst;
+    const char* const values[] = {"0", "1", "2", "3", "4", "5", "6"};
+
+    CU_ASSERT_EQUAL(linked_list_init(&lst), 0)
+    CU_ASSERT_PTR_NULL(linked_list_get_at(&lst, 0))
+
+    for (int i = 0; i < 7; ++i) {
+        CU_ASSERT_EQUAL(linked_list_push_tail(&lst, (void *)values[i]), 0)
+    }
+
+    for (int i = 0; i < 7; ++i) {
+        CU_ASSERT_STRING_EQUAL(linked_list_get_at(&lst, i), values[i])
+    }
+    CU_ASSERT_PTR_NULL(linked_list_get_at(&lst, 7))
+
+    CU_ASSERT_EQUAL(linked_list_del_at(&lst, 5), 0) // ["0", "1", "2", "3", "4", "6"]
+    CU_ASSERT_EQUAL(linked_list_del_at(&lst, 1), 0) // ["0", "2", "3", "4", "6"]
+    CU_ASSERT_EQUAL(linked_list_del_at(&lst, 4), 0) // ["0", "2", "3", "4"]
+    CU_ASSERT_EQUAL(linked_list_del_at(&lst, 4), -1)
+
+    const char* const expected[] = {"0", "2", "3", "4"};
+    check_values(&lst, expected, 4);
+
+    CU_ASSERT_EQUAL(linked_list_destroy(&lst), 0)
+}
+
+void test_linked_list_splice() {
+    list lst;
+    list other;
+    list pooled;
+    list shared;
+    slab pool;
+
+    CU_ASSERT_EQUAL(linked_list_init(&lst), 0)
+    CU_ASSERT_EQUAL(linked_list_init(&other), 0)
+
+    // Concatenating empty lists
+    CU_ASSERT_EQUAL(linked_list_concat(&lst, &other), 0)
+    CU_ASSERT_EQUAL(lst.size, 0)
+
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "a"), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "b"), 0)
+    CU_ASSERT_EQUAL(linked_list_concat(&lst, &other), 0) // ["a", "b"]
+    CU_ASSERT_EQUAL(other.size, 0)
+    CU_ASSERT_PTR_NULL(other.head)
+    CU_ASSERT_PTR_NULL(other.tail)
+
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "e"), 0)
+    CU_ASSERT_EQUAL(linked_list_concat(&lst, &other), 0) // ["a", "b", "e"]
+
+    const char* const concatenated[] = {"a", "b", "e"};
+    check_values(&lst, concatenated, 3);
+
+    // Splicing in the middle, at the head and at the tail
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "c"), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "d"), 0)
+    CU_ASSERT_EQUAL(linked_list_splice(&lst, 2, &other), 0) // ["a", "b", "c", "d", "e"]
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "_"), 0)
+    CU_ASSERT_EQUAL(linked_list_splice(&lst, 0, &other), 0) // ["_", "a", "b", "c", "d", "e"]
+    CU_ASSERT_EQUAL(linked_list_push_tail(&other, "f"), 0)
+    CU_ASSERT_EQUAL(linked_list_splice(&lst, 6, &other), 0) // ["_", "a", "b", "c", "d", "e", "f"]
+    CU_ASSERT_EQUAL(linked_list_splice(&lst, 8, &other), -1)
+    CU_ASSERT_EQUAL(linked_list_splice(&lst, 0, &lst), -1)
+
+    const char* const spliced[] = {"_", "a", "b", "c", "d", "e", "f"};
+    check_values(&lst, spliced, 7);
+
+    // Splitting
+    CU_ASSERT_EQUAL(linked_list_split(&lst, 7, &other), 0) // Nothing moved
+    CU_ASSERT_EQUAL(other.size, 0)
+    CU_ASSERT_EQUAL(linked_list_split(&lst, 8, &other), -1)
+
+    CU_ASSERT_EQUAL(linked_list_split(&lst, 4, &other), 0) // ["_", "a", "b", "c"], ["d", "e", "f"]
+    const char* const split_head[] = {"_", "a", "b", "c"};
+    const char* const split_tail[] = {"d", "e", "f"};
+    check_values(&lst, split_head, 4);
+    check_values(&other, split_tail, 3);
+
+    CU_ASSERT_EQUAL(linked_list_split(&lst, 0, &other), 0) // [], ["d", "e", "f", "_", "a", "b", "c"]
+    const char* const split_all[] = {"d", "e", "f", "_", "a", "b", "c"};
+    CU_ASSERT_PTR_NULL(lst.head)
+    CU_ASSERT_PTR_NULL(lst.tail)
+    check_values(&lst, NULL, 0);
+    check_values(&other, split_all, 7);
+
+    // Nodes can't move to a list releasing them through another allocator
+    CU_ASSERT_EQUAL(slab_init(&pool, sizeof(list_node), 0), 0)
+    CU_ASSERT_EQUAL(linked_list_init_with_allocator(&pooled, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_concat(&pooled, &other), -1)
+    CU_ASSERT_EQUAL(linked_list_split(&other, 0, &pooled), -1)
+    CU_ASSERT_EQUAL(other.size, 7)
+
+    CU_ASSERT_EQUAL(linked_list_destroy(&lst), 0)
+    CU_ASSERT_EQUAL(linked_list_destroy(&other), 0)
+
+    // Lists sharing a slab: destroying one leaves the nodes of the other alone
+    CU_ASSERT_EQUAL(linked_list_init_with_allocator(&shared, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&pooled, "a"), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&shared, "b"), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&shared, "c"), 0)
+
+    CU_ASSERT_EQUAL(linked_list_concat(&pooled, &shared), 0) // ["a", "b", "c"], []
+    CU_ASSERT_EQUAL(linked_list_destroy(&shared), 0)
+    const char* const shared_concat[] = {"a", "b", "c"};
+    check_values(&pooled, shared_concat, 3);
+
+    CU_ASSERT_EQUAL(linked_list_init_with_allocator(&shared, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_split(&pooled, 1, &shared), 0) // ["a"], ["b", "c"]
+    CU_ASSERT_EQUAL(linked_list_destroy(&shared), 0)
+    CU_ASSERT_EQUAL(pool.size, 1)
+    CU_ASSERT_STRING_EQUAL(linked_list_get_at(&pooled, 0), "a")
+
+    // Nor can nodes move to or from a list owning its allocator
+    CU_ASSERT_EQUAL(linked_list_init_with_own_allocator(&shared, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_concat(&shared, &pooled), -1)
+    CU_ASSERT_EQUAL(linked_list_split(&pooled, 0, &shared), -1)
+    CU_ASSERT_EQUAL(pooled.size, 1)
+
+    CU_ASSERT_EQUAL(linked_list_destroy(&pooled), 0)
+    CU_ASSERT_EQUAL(pool.size, 0)
+    CU_ASSERT_EQUAL(slab_destroy(&pool), 0)
+}
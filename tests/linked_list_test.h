@@ -11,4 +11,10 @@ void test_linked_list();
 
 void test_linked_list_iter();
 
+void test_linked_list_insert_at();
+
+void test_linked_list_get_and_del_at();
+
+void test_linked_list_splice();
+
 #endif
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lru_cache_test.h"
+#include "../utils/lru_cache.h"
+
+CU_TestInfo* get_lru_cache_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_lru_cache", test_lru_cache},
+        {"test_lru_cache_release", test_lru_cache_release},
+        {"test_lru_cache_bounded_memory", test_lru_cache_bounded_memory},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+/**
+ * Keys and values passed to the release function
+ */
+typedef struct released {
+    char keys[16][16];
+    char values[16][16];
+    size_t count;
+} released;
+
+/**
+ * Release function recording what it was called with
+ *
+ * @param key Key of the entry (or NULL)
+ * @param value Value of the entry (or NULL)
+ * @param p_released Record
+ */
+static void record_release(void* key, void* value, void* p_released) {
+    released* p_record = p_released;
+
+    if (p_record->count < 16) {
+        snprintf(p_record->keys[p_record->count], 16, "%s", key != NULL ? (char *)key : "(null)");
+        snprintf(p_record->values[p_record->count], 16, "%s", value != NULL ? (char *)value : "(null)");
+    }
+    ++p_record->count;
+}
+
+/**
+ * Release function freeing keys and values
+ *
+ * @param key Key of the entry (or NULL)
+ * @param value Value of the entry (or NULL)
+ * @param p_count Number of released entries
+ */
+static void free_release(void* key, void* value, void* p_count) {
+    free(key);
+    free(value);
+    ++*(size_t *)p_count;
+}
+
+void test_lru_cache() {
+    lru_cache cache;
+
+    CU_ASSERT_EQUAL(lru_cache_init(&cache, 0, NULL, NULL), -1)
+    CU_ASSERT_EQUAL(lru_cache_init(&cache, 3, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 0)
+    CU_ASSERT_PTR_NULL(lru_cache_get(&cache, "a"))
+
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "a", "1"), 0) // [a]
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "b", "2"), 0) // [b, a]
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "c", "3"), 0) // [c, b, a]
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 3)
+
+    // Using "a" makes "b" the least recently used
+    CU_ASSERT_STRING_EQUAL(lru_cache_get(&cache, "a"), "1") // [a, c, b]
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "d", "4"), 0) // [d, a, c]
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 3)
+    CU_ASSERT_PTR_NULL(lru_cache_get(&cache, "b"))
+    CU_ASSERT_EQUAL(cache.evictions, 1)
+
+    // Peeking doesn't count as using
+    CU_ASSERT_STRING_EQUAL(lru_cache_peek(&cache, "c"), "3")
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "e", "5"), 0) // [e, d, a]
+    CU_ASSERT_PTR_NULL(lru_cache_peek(&cache, "c"))
+
+    // Replacing a value makes its entry the most recently used
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "a", "6"), 0) // [a, e, d]
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 3)
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "f", "7"), 0) // [f, a, e]
+    CU_ASSERT_STRING_EQUAL(lru_cache_get(&cache, "a"), "6")
+    CU_ASSERT_PTR_NULL(lru_cache_get(&cache, "d"))
+
+    CU_ASSERT_EQUAL(lru_cache_del(&cache, "e"), 0) // [a, f]
+    CU_ASSERT_EQUAL(lru_cache_del(&cache, "e"), -1)
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 2)
+
+    // 2 hits, 3 misses (peeks don't count)
+    CU_ASSERT_EQUAL(cache.hits, 2)
+    CU_ASSERT_EQUAL(cache.misses, 3)
+    CU_ASSERT_EQUAL(cache.evictions, 3)
+
+    // Shrinking evicts the least recently used entries
+    CU_ASSERT_EQUAL(lru_cache_set_capacity(&cache, 0), -1)
+    CU_ASSERT_EQUAL(lru_cache_set_capacity(&cache, 1), 0) // [a]
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), 1)
+    CU_ASSERT_STRING_EQUAL(lru_cache_peek(&cache, "a"), "6")
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "g", "8"), 0) // [g]
+    CU_ASSERT_PTR_NULL(lru_cache_peek(&cache, "a"))
+
+    CU_ASSERT_EQUAL(lru_cache_destroy(&cache), 0)
+}
+
+void test_lru_cache_release() {
+    lru_cache cache;
+    released record;
+    char key_a[] = "a";
+    char key_a_copy[] = "a";
+
+    memset(&record, 0, sizeof(record));
+
+    CU_ASSERT_EQUAL(lru_cache_init(&cache, 2, NULL, NULL), 0)
+    lru_cache_set_release_func(&cache, record_release, &record);
+
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, key_a, "1"), 0) // [a]
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "b", "2"), 0) // [b, a]
+    CU_ASSERT_EQUAL(record.count, 0)
+
+    // Same key pointer: only the old value is released
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, key_a, "3"), 0) // [a, b]
+    CU_ASSERT_EQUAL(record.count, 1)
+    CU_ASSERT_STRING_EQUAL(record.keys[0], "(null)")
+    CU_ASSERT_STRING_EQUAL(record.values[0], "1")
+
+    // Same value pointer, equal key: only the old key is released
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, key_a_copy, "3"), 0) // [a, b]
+    CU_ASSERT_EQUAL(record.count, 2)
+    CU_ASSERT_STRING_EQUAL(record.keys[1], "a")
+    CU_ASSERT_STRING_EQUAL(record.values[1], "(null)")
+
+    // Same key and value: nothing to release
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, key_a_copy, "3"), 0) // [a, b]
+    CU_ASSERT_EQUAL(record.count, 2)
+
+    // Evicted
+    CU_ASSERT_EQUAL(lru_cache_put(&cache, "c", "4"), 0) // [c, a]
+    CU_ASSERT_EQUAL(record.count, 3)
+    CU_ASSERT_STRING_EQUAL(record.keys[2], "b")
+    CU_ASSERT_STRING_EQUAL(record.values[2], "2")
+
+    // Deleted
+    CU_ASSERT_EQUAL(lru_cache_del(&cache, "a"), 0) // [c]
+    CU_ASSERT_EQUAL(record.count, 4)
+    CU_ASSERT_STRING_EQUAL(record.keys[3], "a")
+    CU_ASSERT_STRING_EQUAL(record.values[3], "3")
+
+    // Left over at destroy time
+    CU_ASSERT_EQUAL(lru_cache_destroy(&cache), 0)
+    CU_ASSERT_EQUAL(record.count, 5)
+    CU_ASSERT_STRING_EQUAL(record.keys[4], "c")
+    CU_ASSERT_STRING_EQUAL(record.values[4], "4")
+}
+
+void test_lru_cache_bounded_memory() {
+    enum { CAPACITY = 64, KEY_COUNT = 20000 };
+    lru_cache cache;
+    size_t released_count = 0;
+
+    CU_ASSERT_EQUAL(lru_cache_init(&cache, CAPACITY, NULL, NULL), 0)
+    lru_cache_set_release_func(&cache, free_release, &released_count);
+
+    const uint32_t index_size = cache.index.table.index_size;
+
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        // A hot set of 8 keys, looked up between distinct cold keys
+        char hot_key[16];
+        snprintf(hot_key, sizeof(hot_key), "hot%d", i % 8);
+
+        if (lru_cache_get(&cache, hot_key) == NULL) {
+            CU_ASSERT_EQUAL(lru_cache_put(&cache, strdup(hot_key), strdup("hot")), 0)
+        }
+
+        char* key = malloc(16);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(key)
+        snprintf(key, 16, "cold%d", i);
+        CU_ASSERT_EQUAL(lru_cache_put(&cache, key, strdup("cold")), 0)
+
+        CU_ASSERT(lru_cache_size(&cache) <= CAPACITY)
+    }
+
+    // The hot keys stayed cached
+    CU_ASSERT_EQUAL(cache.misses, 8)
+    CU_ASSERT_EQUAL(cache.hits, KEY_COUNT - 8)
+    CU_ASSERT_EQUAL(lru_cache_size(&cache), CAPACITY)
+
+    // Deletes were reclaimed rather than growing the index
+    CU_ASSERT(cache.index.table.index_size <= index_size * 2)
+
+    CU_ASSERT_EQUAL(lru_cache_destroy(&cache), 0)
+    CU_ASSERT_EQUAL(released_count, KEY_COUNT + 8)
+}
@@ -0,0 +1,14 @@
+#ifndef __LRU_CACHE_TEST_H__
+#define __LRU_CACHE_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_lru_cache_tests();
+
+void test_lru_cache();
+
+void test_lru_cache_release();
+
+void test_lru_cache_bounded_memory();
+
+#endif
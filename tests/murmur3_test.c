@@ -1,9 +1,14 @@
+#include <string.h>
+
 #include "murmur3_test.h"
 #include "../utils/murmur3.h"
 
 CU_TestInfo* get_murmur3_tests() {
     static CU_TestInfo tests[] = {
         {"test_murmur3", test_murmur3},
+        {"test_murmur3_str", test_murmur3_str},
+        {"test_murmur3_streaming", test_murmur3_streaming},
+        {"test_murmur3_x64_128", test_murmur3_x64_128},
         CU_TEST_INFO_NULL,
     };
 
@@ -24,3 +29,70 @@ void test_murmur3() {
     CU_ASSERT_EQUAL(murmur3((uint8_t *)"The quick brown fox jumps over the lazy dog", 43, 0x00000000), 0x2e4ff723)
     CU_ASSERT_EQUAL(murmur3((uint8_t *)"The quick brown fox jumps over the lazy dog", 43, 0x9747b28c), 0x2fa826cd)
 }
+
+void test_murmur3_str() {
+    const char* strs[] = { "", "a", "ab", "abc", "test", "Hello, world!", "The quick brown fox jumps over the lazy dog" };
+
+    // Same hash as the length-based version
+    for (size_t i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+        CU_ASSERT_EQUAL(murmur3_str(strs[i], 0x9747b28c), murmur3((uint8_t *)strs[i], strlen(strs[i]), 0x9747b28c))
+    }
+
+    CU_ASSERT_EQUAL(murmur3_str("test", 0x00000000), 0xba6bd213)
+}
+
+void test_murmur3_streaming() {
+    const char* str = "The quick brown fox jumps over the lazy dog";
+    murmur3_state state;
+
+    // Every split of the string gives the same hash
+    for (size_t split = 0; split <= 43; ++split) {
+        murmur3_init(&state, 0x9747b28c);
+        murmur3_update(&state, str, split);
+        murmur3_update(&state, str + split, 43 - split);
+        CU_ASSERT_EQUAL(murmur3_final(&state), 0x2fa826cd)
+    }
+
+    // Byte by byte
+    murmur3_init(&state, 0x00000000);
+    for (size_t i = 0; i < 13; ++i) {
+        murmur3_update(&state, "Hello, world!" + i, 1);
+    }
+    CU_ASSERT_EQUAL(murmur3_final(&state), 0xc0363e43)
+
+    // Multi-field key without a temporary buffer
+    const uint32_t ip_addr = 0xC0A80001;
+    const uint16_t port = 443;
+    uint8_t buffer[sizeof(ip_addr) + sizeof(port)];
+    memcpy(buffer, &ip_addr, sizeof(ip_addr));
+    memcpy(buffer + sizeof(ip_addr), &port, sizeof(port));
+
+    murmur3_init(&state, 0x00000000);
+    murmur3_update(&state, &ip_addr, sizeof(ip_addr));
+    murmur3_update(&state, &port, sizeof(port));
+    CU_ASSERT_EQUAL(murmur3_final(&state), murmur3(buffer, sizeof(buffer), 0x00000000))
+}
+
+void test_murmur3_x64_128() {
+    uint64_t out[2];
+
+    murmur3_x64_128("", 0, 0x00000000, out);
+    CU_ASSERT_EQUAL(out[0], 0x0000000000000000ULL)
+    CU_ASSERT_EQUAL(out[1], 0x0000000000000000ULL)
+
+    murmur3_x64_128("", 0, 0x00000001, out);
+    CU_ASSERT_EQUAL(out[0], 0x4610abe56eff5cb5ULL)
+    CU_ASSERT_EQUAL(out[1], 0x51622daa78f83583ULL)
+
+    murmur3_x64_128("test", 4, 0x00000000, out);
+    CU_ASSERT_EQUAL(out[0], 0xac7d28cc74bde19dULL)
+    CU_ASSERT_EQUAL(out[1], 0x9a128231f9bd4d82ULL)
+
+    murmur3_x64_128("Hello, world!", 13, 0x9747b28c, out);
+    CU_ASSERT_EQUAL(out[0], 0xedc485d662a8392eULL)
+    CU_ASSERT_EQUAL(out[1], 0xf85e7e7631d576baULL)
+
+    murmur3_x64_128("The quick brown fox jumps over the lazy dog", 43, 0x00000000, out);
+    CU_ASSERT_EQUAL(out[0], 0xe34bbc7bbc071b6cULL)
+    CU_ASSERT_EQUAL(out[1], 0x7a433ca9c49a9347ULL)
+}
@@ -7,4 +7,10 @@ CU_TestInfo* get_murmur3_tests();
 
 void test_murmur3();
 
+void test_murmur3_str();
+
+void test_murmur3_streaming();
+
+void test_murmur3_x64_128();
+
 #endif
@@ -0,0 +1,337 @@
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net_utils_batch_test.h"
+#include "../utils/net_utils_batch.h"
+
+/**
+ * Number of random inputs per test
+ */
+#define INPUT_COUNT 20000
+
+/**
+ * Implementations compared against the scalar one
+ */
+static const net_utils_batch_impl simd_impls[] = {
+    NET_UTILS_BATCH_SSE41,
+};
+
+CU_TestInfo* get_net_utils_batch_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_net_utils_ip_parse_many", test_net_utils_ip_parse_many},
+        {"test_net_utils_ip_format_many", test_net_utils_ip_format_many},
+        {"test_net_utils_ether_parse_many", test_net_utils_ether_parse_many},
+        {"test_net_utils_ether_format_many", test_net_utils_ether_format_many},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+/**
+ * Randomly break a string (or leave it alone half of the time)
+ *
+ * @param str String
+ * @param size Size of the buffer holding str
+ * @param chars Characters to break it with
+ */
+static void mutate(char* str, const size_t size, const char* chars) {
+    const size_t len = strlen(str);
+
+    switch (rand() % 6) {
+        case 0:
+            // Replace a character (possibly with a terminator)
+            str[rand() % len] = chars[rand() % (strlen(chars) + 1)];
+            break;
+
+        case 1:
+            // Append a character
+            if (len + 1 < size) {
+                str[len] = chars[rand() % strlen(chars)];
+                str[len + 1] = 0;
+            }
+            break;
+
+        case 2:
+            // Drop a character
+            memmove(&str[rand() % len], &str[rand() % len + 1], len);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Copy strings into one buffer back to back, so they start at all kinds of
+ * offsets (including right before a page boundary)
+ *
+ * @param strs Strings to copy (replaced by pointers to the copies)
+ * @param count Number of strings
+ * @return Buffer to free
+ */
+static char* pack_strs(const char** strs, const size_t count) {
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size += strlen(strs[i]) + 1;
+    }
+
+    char* buffer = malloc(size);
+    char* p_str = buffer;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t len = strlen(strs[i]) + 1;
+        memcpy(p_str, strs[i], len);
+        strs[i] = p_str;
+        p_str += len;
+    }
+
+    return buffer;
+}
+
+/**
+ * Parse all IPv4 address strings, resuming after invalid ones
+ *
+ * @param impl Implementation to use
+ * @param strs Strings
+ * @param long_addrs Output for addresses
+ * @param valid Output for whether each string was valid
+ */
+static void parse_all_ips(
+    const net_utils_batch_impl impl,
+    const char** strs,
+    uint32_t* long_addrs,
+    uint8_t* valid
+) {
+    net_utils_batch_set_impl(impl);
+
+    for (size_t i = 0; i < INPUT_COUNT; ) {
+        const size_t n = net_utils_ip_parse_many(&strs[i], INPUT_COUNT - i, &long_addrs[i]);
+        memset(&valid[i], 1, n);
+
+        i += n;
+        if (i < INPUT_COUNT) {
+            valid[i++] = 0;
+        }
+    }
+}
+
+/**
+ * Parse all ethernet address strings, resuming after invalid ones
+ *
+ * @param impl Implementation to use
+ * @param strs Strings
+ * @param ether_addrs Output for addresses
+ * @param valid Output for whether each string was valid
+ */
+static void parse_all_ethers(
+    const net_utils_batch_impl impl,
+    const char** strs,
+    uint8_t* ether_addrs,
+    uint8_t* valid
+) {
+    net_utils_batch_set_impl(impl);
+
+    for (size_t i = 0; i < INPUT_COUNT; ) {
+        const size_t n = net_utils_ether_parse_many(&strs[i], INPUT_COUNT - i, &ether_addrs[i * 6]);
+        memset(&valid[i], 1, n);
+
+        i += n;
+        if (i < INPUT_COUNT) {
+            valid[i++] = 0;
+        }
+    }
+}
+
+void test_net_utils_ip_parse_many() {
+    static const char* strs[INPUT_COUNT];
+    static uint32_t expected[INPUT_COUNT];
+    static uint32_t result[INPUT_COUNT];
+    static uint8_t expected_valid[INPUT_COUNT];
+    static uint8_t result_valid[INPUT_COUNT];
+    static char inputs[INPUT_COUNT][NET_UTILS_IP_STR_SIZE + 1];
+    const net_utils_batch_impl default_impl = net_utils_batch_get_impl();
+
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        // Octets of all lengths
+        static const int octet_limits[] = {10, 100, 256};
+        snprintf(
+            inputs[i], sizeof(inputs[i]), "%d.%d.%d.%d",
+            (uint8_t)(rand() % octet_limits[rand() % 3]),
+            (uint8_t)(rand() % octet_limits[rand() % 3]),
+            (uint8_t)(rand() % octet_limits[rand() % 3]),
+            (uint8_t)(rand() % octet_limits[rand() % 3])
+        );
+        mutate(inputs[i], sizeof(inputs[i]), "0123456789.x");
+        strs[i] = inputs[i];
+    }
+
+    char* buffer = pack_strs(strs, INPUT_COUNT);
+
+    parse_all_ips(NET_UTILS_BATCH_SCALAR, strs, expected, expected_valid);
+
+    // The scalar implementation follows inet_pton()
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        struct in_addr addr;
+        const int valid = inet_pton(AF_INET, strs[i], &addr) == 1;
+
+        CU_ASSERT_EQUAL(expected_valid[i], valid)
+        if (valid) {
+            CU_ASSERT_EQUAL(expected[i], ntohl(addr.s_addr))
+        }
+    }
+
+    for (size_t k = 0; k < sizeof(simd_impls) / sizeof(simd_impls[0]); ++k) {
+        if (net_utils_batch_set_impl(simd_impls[k]) != 0) {
+            continue;
+        }
+
+        parse_all_ips(simd_impls[k], strs, result, result_valid);
+
+        for (size_t i = 0; i < INPUT_COUNT; ++i) {
+            CU_ASSERT_EQUAL(result_valid[i], expected_valid[i])
+            if (expected_valid[i]) {
+                CU_ASSERT_EQUAL(result[i], expected[i])
+            }
+        }
+    }
+
+    net_utils_batch_set_impl(default_impl);
+    free(buffer);
+}
+
+void test_net_utils_ip_format_many() {
+    static uint32_t long_addrs[INPUT_COUNT];
+    static char expected[INPUT_COUNT][NET_UTILS_IP_STR_SIZE];
+    static char result[INPUT_COUNT][NET_UTILS_IP_STR_SIZE];
+    const net_utils_batch_impl default_impl = net_utils_batch_get_impl();
+
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        // Octets of all lengths
+        static const uint32_t octet_limits[] = {10, 100, 256};
+        for (int k = 0; k < 4; ++k) {
+            long_addrs[i] = long_addrs[i] << 8 | rand() % octet_limits[rand() % 3];
+        }
+    }
+
+    net_utils_batch_set_impl(NET_UTILS_BATCH_SCALAR);
+    net_utils_ip_format_many(long_addrs, INPUT_COUNT, expected);
+
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        struct in_addr addr = {.s_addr = htonl(long_addrs[i])};
+        char ntop[INET_ADDRSTRLEN];
+
+        CU_ASSERT_STRING_EQUAL(expected[i], inet_ntop(AF_INET, &addr, ntop, sizeof(ntop)))
+    }
+
+    for (size_t k = 0; k < sizeof(simd_impls) / sizeof(simd_impls[0]); ++k) {
+        if (net_utils_batch_set_impl(simd_impls[k]) != 0) {
+            continue;
+        }
+
+        net_utils_ip_format_many(long_addrs, INPUT_COUNT, result);
+
+        for (size_t i = 0; i < INPUT_COUNT; ++i) {
+            CU_ASSERT_STRING_EQUAL(result[i], expected[i])
+        }
+    }
+
+    net_utils_batch_set_impl(default_impl);
+}
+
+void test_net_utils_ether_parse_many() {
+    static const char* strs[INPUT_COUNT];
+    static uint8_t addrs[INPUT_COUNT * 6];
+    static uint8_t expected[INPUT_COUNT * 6];
+    static uint8_t result[INPUT_COUNT * 6];
+    static uint8_t expected_valid[INPUT_COUNT];
+    static uint8_t result_valid[INPUT_COUNT];
+    static char inputs[INPUT_COUNT][NET_UTILS_ETHER_STR_SIZE + 1];
+    const net_utils_batch_impl default_impl = net_utils_batch_get_impl();
+
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        uint8_t* addr = &addrs[i * 6];
+        for (int k = 0; k < 6; ++k) {
+            addr[k] = rand();
+        }
+
+        snprintf(
+            inputs[i], sizeof(inputs[i]),
+            rand() % 2 ? "%02x:%02x:%02x:%02x:%02x:%02x" : "%02X:%02X:%02X:%02X:%02X:%02X",
+            addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]
+        );
+        mutate(inputs[i], sizeof(inputs[i]), "09afAF:-g/@`G");
+        strs[i] = inputs[i];
+    }
+
+    char* buffer = pack_strs(strs, INPUT_COUNT);
+
+    parse_all_ethers(NET_UTILS_BATCH_SCALAR, strs, expected, expected_valid);
+
+    // Untouched strings are valid and parse back to their address
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        if (strlen(strs[i]) == 17 && strspn(strs[i], "0123456789abcdefABCDEF:") == 17) {
+            if (memcmp(&expected[i * 6], &addrs[i * 6], 6) == 0) {
+                CU_ASSERT_EQUAL(expected_valid[i], 1)
+            }
+        }
+    }
+
+    for (size_t k = 0; k < sizeof(simd_impls) / sizeof(simd_impls[0]); ++k) {
+        if (net_utils_batch_set_impl(simd_impls[k]) != 0) {
+            continue;
+        }
+
+        parse_all_ethers(simd_impls[k], strs, result, result_valid);
+
+        for (size_t i = 0; i < INPUT_COUNT; ++i) {
+            CU_ASSERT_EQUAL(result_valid[i], expected_valid[i])
+            if (expected_valid[i]) {
+                CU_ASSERT_EQUAL(memcmp(&result[i * 6], &expected[i * 6], 6), 0)
+            }
+        }
+    }
+
+    net_utils_batch_set_impl(default_impl);
+    free(buffer);
+}
+
+void test_net_utils_ether_format_many() {
+    static uint8_t addrs[INPUT_COUNT * 6];
+    static char expected[INPUT_COUNT][NET_UTILS_ETHER_STR_SIZE];
+    static char result[INPUT_COUNT][NET_UTILS_ETHER_STR_SIZE];
+    const net_utils_batch_impl default_impl = net_utils_batch_get_impl();
+
+    for (size_t i = 0; i < INPUT_COUNT * 6; ++i) {
+        addrs[i] = rand();
+    }
+
+    net_utils_batch_set_impl(NET_UTILS_BATCH_SCALAR);
+    net_utils_ether_format_many(addrs, INPUT_COUNT, expected);
+
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+        const uint8_t* addr = &addrs[i * 6];
+        char formatted[NET_UTILS_ETHER_STR_SIZE];
+
+        snprintf(
+            formatted, sizeof(formatted), "%02x:%02x:%02x:%02x:%02x:%02x",
+            addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]
+        );
+        CU_ASSERT_STRING_EQUAL(expected[i], formatted)
+    }
+
+    for (size_t k = 0; k < sizeof(simd_impls) / sizeof(simd_impls[0]); ++k) {
+        if (net_utils_batch_set_impl(simd_impls[k]) != 0) {
+            continue;
+        }
+
+        net_utils_ether_format_many(addrs, INPUT_COUNT, result);
+
+        for (size_t i = 0; i < INPUT_COUNT; ++i) {
+            CU_ASSERT_STRING_EQUAL(result[i], expected[i])
+        }
+    }
+
+    net_utils_batch_set_impl(default_impl);
+}
@@ -0,0 +1,16 @@
+#ifndef __NET_UTILS_BATCH_TEST_H__
+#define __NET_UTILS_BATCH_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_net_utils_batch_tests();
+
+void test_net_utils_ip_parse_many();
+
+void test_net_utils_ip_format_many();
+
+void test_net_utils_ether_parse_many();
+
+void test_net_utils_ether_format_many();
+
+#endif
@@ -1,11 +1,18 @@
+#include <stdio.h>
+#include <string.h>
+
 #include "net_utils_test.h"
 #include "../utils/net_utils.h"
 
 CU_TestInfo* get_net_utils_tests() {
     static CU_TestInfo tests[] = {
+        {"test_net_utils_ip_parse", test_net_utils_ip_parse},
+        {"test_net_utils_ip_format", test_net_utils_ip_format},
         {"test_net_utils_ip2long", test_net_utils_ip2long},
         {"test_net_utils_long2ip", test_net_utils_long2ip},
         {"test_net_utils_ip_matches", test_net_utils_ip_matches},
+        {"test_net_utils_ether_format", test_net_utils_ether_format},
+        {"test_net_utils_ether_parse", test_net_utils_ether_parse},
         {"test_net_utils_ether_ntoa", test_net_utils_ether_ntoa},
         CU_TEST_INFO_NULL,
     };
@@ -13,6 +20,82 @@ CU_TestInfo* get_net_utils_tests() {
     return tests;
 }
 
+void test_net_utils_ip_parse() {
+    static const char* invalid[] = {
+        "",
+        "1",
+        "1.2.3",
+        "1.2.3.",
+        "1.2.3.4.",
+        "1.2.3.4.5",
+        "1..3.4",
+        ".1.2.3.4",
+        "256.1.1.1",
+        "1.2.3.999",
+        "1234.1.1.1",
+        "01.2.3.4",
+        "1.2.3.00",
+        "+1.2.3.4",
+        "1.2.3.-4",
+        " 1.2.3.4",
+        "1.2.3.4 ",
+        "1.2.3.4x",
+        "0x1.2.3.4",
+    };
+    uint32_t result;
+
+    CU_ASSERT_EQUAL(net_utils_ip_parse("0.0.0.0", &result), 0)
+    CU_ASSERT_EQUAL(result, 0)
+
+    CU_ASSERT_EQUAL(net_utils_ip_parse("1.2.3.4", &result), 0)
+    CU_ASSERT_EQUAL(result, 16909060)
+
+    CU_ASSERT_EQUAL(net_utils_ip_parse("10.100.200.255", &result), 0)
+    CU_ASSERT_EQUAL(result, 0x0A64C8FF)
+
+    // Distinguishable from a parse error
+    CU_ASSERT_EQUAL(net_utils_ip_parse("255.255.255.255", &result), 0)
+    CU_ASSERT_EQUAL(result, 4294967295)
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        result = 42;
+        CU_ASSERT_EQUAL(net_utils_ip_parse(invalid[i], &result), -1)
+
+        // Output is left untouched on failure
+        CU_ASSERT_EQUAL(result, 42)
+    }
+}
+
+void test_net_utils_ip_format() {
+    char result[NET_UTILS_IP_STR_SIZE];
+    char expected[NET_UTILS_IP_STR_SIZE];
+    uint32_t parsed;
+
+    CU_ASSERT_EQUAL(net_utils_ip_format(0, result), 7)
+    CU_ASSERT_STRING_EQUAL(result, "0.0.0.0")
+
+    CU_ASSERT_EQUAL(net_utils_ip_format(0x0A64C8FF, result), 14)
+    CU_ASSERT_STRING_EQUAL(result, "10.100.200.255")
+
+    CU_ASSERT_EQUAL(net_utils_ip_format(4294967295, result), 15)
+    CU_ASSERT_STRING_EQUAL(result, "255.255.255.255")
+
+    // Every octet value in every position round-trips
+    for (uint32_t octet = 0; octet < 256; ++octet) {
+        const uint32_t long_addr = octet << 24 | (255 - octet) << 16 | octet << 8 | (octet * 7 & 0xFF);
+
+        net_utils_ip_format(long_addr, result);
+        snprintf(
+            expected, sizeof(expected), "%u.%u.%u.%u",
+            long_addr >> 24, (long_addr >> 16) & 0xFF, (long_addr >> 8) & 0xFF, long_addr & 0xFF
+        );
+        CU_ASSERT_STRING_EQUAL(result, expected)
+
+        CU_ASSERT_EQUAL(net_utils_ip_parse(result, &parsed), 0)
+        CU_ASSERT_EQUAL(parsed, long_addr)
+    }
+}
+
 void test_net_utils_ip2long() {
     uint32_t result;
 
@@ -30,7 +113,7 @@ void test_net_utils_ip2long() {
 }
 
 void test_net_utils_long2ip() {
-    char result[16];
+    char result[NET_UTILS_IP_STR_SIZE];
 
     net_utils_long2ip(0, (char *)&result);
     CU_ASSERT_STRING_EQUAL(result, "0.0.0.0")
@@ -70,6 +153,68 @@ void test_net_utils_ip_matches() {
     CU_ASSERT_EQUAL(result, 1);
 }
 
+void test_net_utils_ether_format() {
+    const uint8_t* first = (uint8_t *)"\xab\x57\xd8\x36\xda\x88";
+    const uint8_t* second = (uint8_t *)"\x00\x01\x0f\x10\xf0\xff";
+    char first_str[NET_UTILS_ETHER_STR_SIZE];
+    char second_str[NET_UTILS_ETHER_STR_SIZE];
+    char expected[NET_UTILS_ETHER_STR_SIZE];
+
+    // Both results stay valid
+    CU_ASSERT_PTR_EQUAL(net_utils_ether_format(first, first_str), first_str)
+    CU_ASSERT_PTR_EQUAL(net_utils_ether_format(second, second_str), second_str)
+    CU_ASSERT_STRING_EQUAL(first_str, "ab:57:d8:36:da:88")
+    CU_ASSERT_STRING_EQUAL(second_str, "00:01:0f:10:f0:ff")
+
+    // Every byte value in every position
+    for (unsigned int value = 0; value < 256; ++value) {
+        const uint8_t addr[6] = {value, value ^ 0x5A, 255 - value, value, value * 7, value >> 1};
+
+        net_utils_ether_format(addr, first_str);
+        snprintf(
+            expected, sizeof(expected), "%02x:%02x:%02x:%02x:%02x:%02x",
+            addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]
+        );
+        CU_ASSERT_STRING_EQUAL(first_str, expected)
+    }
+}
+
+void test_net_utils_ether_parse() {
+    static const char* invalid[] = {
+        "",
+        "ab",
+        "ab:57:d8:36:da",
+        "ab:57:d8:36:da:8",
+        "ab:57:d8:36:da:88:",
+        "ab:57:d8:36:da:88:00",
+        "ab-57-d8-36-da-88",
+        "ab:57:d8:36:da:8g",
+        "ab:57:d8:36:da:88 ",
+        " ab:57:d8:36:da:88",
+        "a:57:d8:36:da:88",
+        "ab::d8:36:da:88",
+    };
+    const uint8_t* expected = (uint8_t *)"\xab\x57\xd8\x36\xda\x88";
+    uint8_t result[6];
+
+    CU_ASSERT_EQUAL(net_utils_ether_parse("ab:57:d8:36:da:88", result), 0)
+    CU_ASSERT_EQUAL(memcmp(result, expected, 6), 0)
+
+    CU_ASSERT_EQUAL(net_utils_ether_parse("AB:57:D8:36:Da:88", result), 0)
+    CU_ASSERT_EQUAL(memcmp(result, expected, 6), 0)
+
+    CU_ASSERT_EQUAL(net_utils_ether_parse("00:01:0f:10:F0:ff", result), 0)
+    CU_ASSERT_EQUAL(memcmp(result, "\x00\x01\x0f\x10\xf0\xff", 6), 0)
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        memset(result, 0x42, sizeof(result));
+        CU_ASSERT_EQUAL(net_utils_ether_parse(invalid[i], result), -1)
+
+        // Output is left untouched on failure
+        CU_ASSERT_EQUAL(memcmp(result, "\x42\x42\x42\x42\x42\x42", 6), 0)
+    }
+}
+
 void test_net_utils_ether_ntoa() {
     const uint8_t* input = (uint8_t *)"\xab\x57\xd8\x36\xda\x88";
 
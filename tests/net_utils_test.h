@@ -5,12 +5,20 @@
 
 CU_TestInfo* get_net_utils_tests();
 
+void test_net_utils_ip_parse();
+
+void test_net_utils_ip_format();
+
 void test_net_utils_ip2long();
 
 void test_net_utils_long2ip();
 
 void test_net_utils_ip_matches();
 
+void test_net_utils_ether_format();
+
+void test_net_utils_ether_parse();
+
 void test_net_utils_ether_ntoa();
 
 #endif
@@ -0,0 +1,153 @@
+#include <stdlib.h>
+
+#include "prefix_set_test.h"
+#include "../utils/prefix_set.h"
+
+CU_TestInfo* get_prefix_set_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_prefix_set_lookup", test_prefix_set_lookup},
+        {"test_prefix_set_add_cidr", test_prefix_set_add_cidr},
+        {"test_prefix_set_random", test_prefix_set_random},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_prefix_set_lookup() {
+    prefix_set set;
+    char* any = "any";
+    char* ten = "10/8";
+    char* ten_one = "10.1/16";
+    char* ten_one_two = "10.1.2/24";
+    char* host = "10.1.2.3/32";
+    char* wide = "10.1.128/17";
+    char* narrow = "10.1.2.128/25";
+
+    CU_ASSERT_EQUAL(prefix_set_init(&set), 0)
+
+    // Empty set
+    CU_ASSERT_PTR_NULL(prefix_set_lookup(&set, 0x0A010203))
+
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A000000, 8, ten), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A010203, 32, host), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A010200, 24, ten_one_two), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A010000, 16, ten_one), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A018000, 17, wide), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A010280, 25, narrow), 0)
+
+    // Invalid prefixes
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0, 33, any), -1)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0, 8, NULL), -1)
+
+    // Not built yet
+    CU_ASSERT_PTR_NULL(prefix_set_lookup(&set, 0x0A010203))
+
+    CU_ASSERT_EQUAL(prefix_set_build(&set), 0)
+
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A010203), host)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A010204), ten_one_two)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A0102FF), narrow)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A010300), ten_one)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A01FFFF), wide)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A020000), ten)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0AFFFFFF), ten)
+    CU_ASSERT_PTR_NULL(prefix_set_lookup(&set, 0x0B000000))
+    CU_ASSERT_PTR_NULL(prefix_set_lookup(&set, 0x09FFFFFF))
+
+    // Default route and a duplicate (the last one wins)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x12345678, 0, any), 0)
+    CU_ASSERT_EQUAL(prefix_set_add(&set, 0x0A0102FF, 24, host), 0)
+    CU_ASSERT_EQUAL(prefix_set_build(&set), 0)
+
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0B000000), any)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0xFFFFFFFF), any)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A010204), host)
+    CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, 0x0A010300), ten_one)
+
+    CU_ASSERT_EQUAL(prefix_set_destroy(&set), 0)
+    CU_ASSERT_EQUAL(prefix_set_destroy(&set), -1)
+}
+
+void test_prefix_set_add_cidr() {
+    prefix_set set;
+    char* value = "value";
+
+    CU_ASSERT_EQUAL(prefix_set_init(&set), 0)
+
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "192.168.0.0/16", value), 0)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "172.16.5.4", value), 0)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "0.0.0.0/0", value), 0)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.1.2.3/8", value), 0)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "1.2.3.4/32", value), 0)
+    CU_ASSERT_EQUAL(set.prefix_count, 5)
+
+    CU_ASSERT_EQUAL(set.prefixes[1].network, 0xAC100504)
+    CU_ASSERT_EQUAL(set.prefixes[1].net_bits, 32)
+    CU_ASSERT_EQUAL(set.prefixes[2].net_bits, 0)
+
+    // Host bits are cleared
+    CU_ASSERT_EQUAL(set.prefixes[3].network, 0x0A000000)
+
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "/8", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0/", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0/33", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0/08", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0/8/8", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0/-1", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0/8", value), -1)
+    CU_ASSERT_EQUAL(prefix_set_add_cidr(&set, "10.0.0.0.0.0.0/8", value), -1)
+    CU_ASSERT_EQUAL(set.prefix_count, 5)
+
+    prefix_set_destroy(&set);
+}
+
+void test_prefix_set_random() {
+    enum { PREFIX_COUNT = 2000, LOOKUP_COUNT = 20000 };
+    static uint32_t networks[PREFIX_COUNT];
+    static uint8_t net_bits[PREFIX_COUNT];
+    static uint32_t addrs[LOOKUP_COUNT];
+    static void* values[LOOKUP_COUNT];
+    prefix_set set;
+
+    CU_ASSERT_EQUAL(prefix_set_init(&set), 0)
+
+    // Prefixes clustered under a few /8s, so that they nest
+    for (size_t i = 0; i < PREFIX_COUNT; ++i) {
+        net_bits[i] = 4 + rand() % 29;
+        networks[i] = ((uint32_t)(rand() % 4) << 24 | ((uint32_t)rand() & 0xFFFFFF)) & ~0U << (32 - net_bits[i]);
+
+        CU_ASSERT_EQUAL(prefix_set_add(&set, networks[i], net_bits[i], &networks[i]), 0)
+    }
+
+    CU_ASSERT_EQUAL(prefix_set_build(&set), 0)
+
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        // Half of the addresses inside a prefix
+        const size_t p = rand() % PREFIX_COUNT;
+        addrs[i] = rand() % 2 ? networks[p] | ((uint32_t)rand() & ~(~0U << (32 - net_bits[p])))
+            : (uint32_t)(rand() % 5) << 24 | (uint32_t)rand();
+    }
+
+    prefix_set_lookup_many(&set, addrs, LOOKUP_COUNT, values);
+
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        // Linear scan for the longest match (the last one added among equal prefixes)
+        void* expected = NULL;
+        int expected_bits = -1;
+
+        for (size_t p = 0; p < PREFIX_COUNT; ++p) {
+            const uint32_t mask = ~0U << (32 - net_bits[p]);
+            if ((addrs[i] & mask) == networks[p] && net_bits[p] >= expected_bits) {
+                expected = &networks[p];
+                expected_bits = net_bits[p];
+            }
+        }
+
+        CU_ASSERT_PTR_EQUAL(prefix_set_lookup(&set, addrs[i]), expected)
+        CU_ASSERT_PTR_EQUAL(values[i], expected)
+    }
+
+    prefix_set_destroy(&set);
+}
@@ -0,0 +1,14 @@
+#ifndef __PREFIX_SET_TEST_H__
+#define __PREFIX_SET_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_prefix_set_tests();
+
+void test_prefix_set_lookup();
+
+void test_prefix_set_add_cidr();
+
+void test_prefix_set_random();
+
+#endif
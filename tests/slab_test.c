@@ -0,0 +1,118 @@
+#include "slab_test.h"
+#include "../utils/slab.h"
+#include "../utils/linked_list.h"
+
+CU_TestInfo* get_slab_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_slab_alloc_and_free", test_slab_alloc_and_free},
+        {"test_slab_reset", test_slab_reset},
+        {"test_slab_allocator", test_slab_allocator},
+        {"test_slab_shared_allocator", test_slab_shared_allocator},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_slab_alloc_and_free() {
+    slab pool;
+
+    CU_ASSERT_EQUAL(slab_init(&pool, 3, 2), 0)
+    CU_ASSERT_EQUAL(pool.object_size, sizeof(void *)) // Room for the free list link
+
+    char* a = slab_alloc(&pool);
+    char* b = slab_alloc(&pool);
+    char* c = slab_alloc(&pool); // Second chunk
+    CU_ASSERT_PTR_NOT_NULL_FATAL(a)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(b)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(c)
+    CU_ASSERT_PTR_EQUAL(b, a + pool.object_size)
+    CU_ASSERT_EQUAL(pool.size, 3)
+
+    strcpy(a, "ab");
+    strcpy(b, "cd");
+    strcpy(c, "ef");
+    CU_ASSERT_STRING_EQUAL(a, "ab")
+    CU_ASSERT_STRING_EQUAL(b, "cd")
+
+    // Freed objects are reused first
+    slab_free(&pool, b);
+    CU_ASSERT_EQUAL(pool.size, 2)
+    CU_ASSERT_PTR_EQUAL(slab_alloc(&pool), b)
+
+    CU_ASSERT_EQUAL(slab_destroy(&pool), 0)
+    CU_ASSERT_PTR_NULL(pool.chunks)
+}
+
+void test_slab_reset() {
+    slab pool;
+
+    CU_ASSERT_EQUAL(slab_init(&pool, sizeof(uint64_t), 16), 0)
+
+    for (int i = 0; i < 100; ++i) {
+        uint64_t* p_value = slab_alloc(&pool);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_value)
+        *p_value = i;
+    }
+
+    CU_ASSERT_EQUAL(pool.size, 100)
+
+    // Everything is released at once, and the slab is still usable
+    slab_reset(&pool);
+    CU_ASSERT_EQUAL(pool.size, 0)
+    CU_ASSERT_PTR_NULL(pool.chunks)
+    CU_ASSERT_PTR_NOT_NULL(slab_alloc(&pool))
+
+    CU_ASSERT_EQUAL(slab_destroy(&pool), 0)
+}
+
+void test_slab_allocator() {
+    slab pool;
+    list lst;
+
+    CU_ASSERT_EQUAL(slab_init(&pool, sizeof(list_node), 0), 0)
+
+    // Too large for the slab
+    CU_ASSERT_PTR_NULL(allocator_alloc(&pool.base, sizeof(list_node) + 64))
+
+    CU_ASSERT_EQUAL(linked_list_init_with_own_allocator(&lst, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_push_tail(&lst, "foo"), 0) // ["foo"]
+    CU_ASSERT_EQUAL(linked_list_push_tail(&lst, "bar"), 0) // ["foo", "bar"]
+    CU_ASSERT_EQUAL(linked_list_push_head(&lst, "spangle"), 0) // ["spangle", "foo", "bar"]
+    CU_ASSERT_EQUAL(pool.size, 3)
+
+    CU_ASSERT_STRING_EQUAL(linked_list_pop_tail(&lst), "bar") // ["spangle", "foo"]
+    CU_ASSERT_EQUAL(pool.size, 2)
+
+    // Nodes are released in bulk
+    CU_ASSERT_EQUAL(linked_list_destroy(&lst), 0)
+    CU_ASSERT_EQUAL(pool.size, 0)
+    CU_ASSERT_PTR_NULL(pool.chunks)
+
+    CU_ASSERT_EQUAL(slab_destroy(&pool), 0)
+}
+
+void test_slab_shared_allocator() {
+    slab pool;
+    list a;
+    list b;
+
+    CU_ASSERT_EQUAL(slab_init(&pool, sizeof(list_node), 0), 0)
+    CU_ASSERT_EQUAL(linked_list_init_with_allocator(&a, &pool.base), 0)
+    CU_ASSERT_EQUAL(linked_list_init_with_allocator(&b, &pool.base), 0)
+
+    CU_ASSERT_EQUAL(linked_list_push_tail(&a, "foo"), 0) // a: ["foo"]
+    CU_ASSERT_EQUAL(linked_list_push_tail(&a, "bar"), 0) // a: ["foo", "bar"]
+    CU_ASSERT_EQUAL(linked_list_push_tail(&b, "baz"), 0) // b: ["baz"]
+    CU_ASSERT_EQUAL(pool.size, 3)
+
+    // Only the nodes of b are released
+    CU_ASSERT_EQUAL(linked_list_destroy(&b), 0)
+    CU_ASSERT_EQUAL(pool.size, 2)
+    CU_ASSERT_STRING_EQUAL(linked_list_get_at(&a, 1), "bar")
+
+    CU_ASSERT_EQUAL(linked_list_destroy(&a), 0)
+    CU_ASSERT_EQUAL(pool.size, 0)
+
+    CU_ASSERT_EQUAL(slab_destroy(&pool), 0)
+}
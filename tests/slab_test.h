@@ -0,0 +1,16 @@
+#ifndef __SLAB_TEST_H__
+#define __SLAB_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_slab_tests();
+
+void test_slab_alloc_and_free();
+
+void test_slab_reset();
+
+void test_slab_allocator();
+
+void test_slab_shared_allocator();
+
+#endif
@@ -0,0 +1,179 @@
+#include <stdlib.h>
+
+#include "timing_wheel_test.h"
+#include "../utils/timing_wheel.h"
+
+/**
+ * Timer scheduled by the tests
+ */
+typedef struct test_timer {
+    int id;
+    timing_wheel_timer timer;
+
+    /**
+     * Number of times the timer expired
+     */
+    int expired;
+} test_timer;
+
+/**
+ * State shared with the expire function
+ */
+typedef struct expire_log {
+    timing_wheel* wheel;
+
+    /**
+     * Ids of the expired timers, in order
+     */
+    int ids[16];
+    size_t count;
+
+    /**
+     * Deadline of the last expired timer
+     */
+    uint64_t last_deadline;
+} expire_log;
+
+CU_TestInfo* get_timing_wheel_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_timing_wheel", test_timing_wheel},
+        {"test_timing_wheel_random", test_timing_wheel_random},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+/**
+ * Expire function logging the expired timers
+ *
+ * @param timer Expired timer
+ * @param p_log Log
+ */
+static void log_expired(timing_wheel_timer* timer, void* p_log) {
+    expire_log* p_expire_log = p_log;
+    test_timer* p_timer = INTRUSIVE_LIST_ENTRY(timer, test_timer, timer);
+
+    // Expired exactly at its deadline, in deadline order
+    CU_ASSERT_EQUAL(timer->deadline, p_expire_log->wheel->now)
+    CU_ASSERT(timer->deadline >= p_expire_log->last_deadline)
+    CU_ASSERT_FALSE(timing_wheel_timer_is_pending(timer))
+
+    if (p_expire_log->count < 16) {
+        p_expire_log->ids[p_expire_log->count] = p_timer->id;
+    }
+    ++p_expire_log->count;
+    p_expire_log->last_deadline = timer->deadline;
+    ++p_timer->expired;
+}
+
+void test_timing_wheel() {
+    timing_wheel wheel;
+    test_timer timers[6];
+    expire_log log = {.wheel = &wheel};
+
+    for (int i = 0; i < 6; ++i) {
+        timers[i].id = i;
+        timers[i].expired = 0;
+        timing_wheel_timer_init(&timers[i].timer);
+    }
+
+    timing_wheel_init(&wheel, 1000);
+    timing_wheel_add(&wheel, &timers[0].timer, 1064); // Past the end of level 0
+    timing_wheel_add(&wheel, &timers[1].timer, 1001);
+    timing_wheel_add(&wheel, &timers[2].timer, 900); // Already due: next tick
+    timing_wheel_add(&wheel, &timers[3].timer, 1000000000); // Several levels up
+    timing_wheel_add(&wheel, &timers[4].timer, 1063);
+    timing_wheel_add(&wheel, &timers[5].timer, 5000);
+    CU_ASSERT_EQUAL(wheel.size, 6)
+    CU_ASSERT_TRUE(timing_wheel_timer_is_pending(&timers[5].timer))
+
+    timing_wheel_cancel(&wheel, &timers[5].timer);
+    CU_ASSERT_EQUAL(wheel.size, 5)
+    CU_ASSERT_FALSE(timing_wheel_timer_is_pending(&timers[5].timer))
+
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, 1000, log_expired, &log), 0)
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, 1001, log_expired, &log), 2)
+    CU_ASSERT_EQUAL(log.ids[0], 1)
+    CU_ASSERT_EQUAL(log.ids[1], 2)
+
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, 1063, log_expired, &log), 1)
+    CU_ASSERT_EQUAL(log.ids[2], 4)
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, 999999999, log_expired, &log), 1)
+    CU_ASSERT_EQUAL(log.ids[3], 0)
+    CU_ASSERT_EQUAL(wheel.now, 999999999)
+
+    // Going back is ignored
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, 5, log_expired, &log), 0)
+    CU_ASSERT_EQUAL(wheel.now, 999999999)
+
+    CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, UINT64_MAX, log_expired, &log), 1)
+    CU_ASSERT_EQUAL(log.ids[4], 3)
+    CU_ASSERT_EQUAL(wheel.size, 0)
+
+    for (int i = 0; i < 5; ++i) {
+        CU_ASSERT_EQUAL(timers[i].expired, 1)
+    }
+    CU_ASSERT_EQUAL(timers[5].expired, 0)
+}
+
+void test_timing_wheel_random() {
+    enum { TIMER_COUNT = 2000, ROUNDS = 400 };
+    timing_wheel wheel;
+    test_timer* timers = calloc(TIMER_COUNT, sizeof(test_timer));
+    expire_log log = {.wheel = &wheel};
+    uint32_t state = 2463534242U; // Local xorshift32, the global rand() sequence seeds the hash tables
+
+    CU_ASSERT_PTR_NOT_NULL_FATAL(timers)
+
+    timing_wheel_init(&wheel, 123456789);
+
+    for (int i = 0; i < TIMER_COUNT; ++i) {
+        timers[i].id = i;
+        timing_wheel_timer_init(&timers[i].timer);
+    }
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        // Schedule, reschedule or cancel some timers, at all distances
+        for (int j = 0; j < 50; ++j) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            test_timer* p_timer = &timers[state % TIMER_COUNT];
+            const uint64_t delta = ((uint64_t)state << 20 | state) >> (state % 52);
+
+            if (timing_wheel_timer_is_pending(&p_timer->timer)) {
+                timing_wheel_cancel(&wheel, &p_timer->timer);
+            }
+            if (state & 0x100) {
+                timing_wheel_add(&wheel, &p_timer->timer, wheel.now + delta);
+            }
+        }
+
+        // Advance by a few ticks to huge jumps
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        const uint64_t now = wheel.now + (((uint64_t)state << 8) >> (state % 40));
+        size_t pending = 0, due = 0;
+
+        for (int i = 0; i < TIMER_COUNT; ++i) {
+            if (timing_wheel_timer_is_pending(&timers[i].timer)) {
+                ++pending;
+                due += timers[i].timer.deadline <= now;
+            }
+        }
+        CU_ASSERT_EQUAL(wheel.size, pending)
+
+        log.count = 0;
+        log.last_deadline = 0;
+        CU_ASSERT_EQUAL(timing_wheel_advance(&wheel, now, log_expired, &log), due)
+        CU_ASSERT_EQUAL(log.count, due)
+        CU_ASSERT_EQUAL(wheel.now, now)
+        CU_ASSERT_EQUAL(wheel.size, pending - due)
+    }
+
+    free(timers);
+}
@@ -0,0 +1,12 @@
+#ifndef __TIMING_WHEEL_TEST_H__
+#define __TIMING_WHEEL_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_timing_wheel_tests();
+
+void test_timing_wheel();
+
+void test_timing_wheel_random();
+
+#endif
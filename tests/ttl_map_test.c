@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ttl_map_test.h"
+#include "../utils/ttl_map.h"
+
+CU_TestInfo* get_ttl_map_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_ttl_map", test_ttl_map},
+        {"test_ttl_map_release", test_ttl_map_release},
+        {"test_ttl_map_mass_expiry", test_ttl_map_mass_expiry},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+/**
+ * Clock function reading the time set by the test
+ *
+ * @param p_now Current time
+ * @return Current time
+ */
+static uint64_t test_clock(void* p_now) {
+    return *(uint64_t *)p_now;
+}
+
+/**
+ * Release function counting released entries
+ *
+ * @param key Key of the entry (or NULL)
+ * @param value Value of the entry (or NULL)
+ * @param p_count Number of calls
+ */
+static void count_release(void* key, void* value, void* p_count) {
+    (void)key;
+    (void)value;
+    ++*(size_t *)p_count;
+}
+
+/**
+ * Release function recording the last key and value released
+ *
+ * @param key Key of the entry (or NULL)
+ * @param value Value of the entry (or NULL)
+ * @param p_last Last key and value
+ */
+static void record_release(void* key, void* value, void* p_last) {
+    void** p_record = p_last;
+
+    p_record[0] = key;
+    p_record[1] = value;
+}
+
+static int cmp_uint32(const void* a, const void* b) {
+    return *(const uint32_t *)a != *(const uint32_t *)b;
+}
+
+static uint32_t hash_uint32(const void* key) {
+    return *(const uint32_t *)key * 2654435761U;
+}
+
+void test_ttl_map() {
+    ttl_map map;
+    uint64_t now = 1000, ttl;
+
+    CU_ASSERT_EQUAL(ttl_map_init(&map, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(ttl_map_set_clock(&map, test_clock, &now), 0)
+
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "a", "1", 10), 0)
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "b", "2", 20), 0)
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "c", "3", 0), 0)
+    CU_ASSERT_EQUAL(ttl_map_size(&map), 3)
+    CU_ASSERT_STRING_EQUAL(ttl_map_get(&map, "c"), "3")
+    CU_ASSERT_EQUAL(ttl_map_set_clock(&map, test_clock, &now), -1)
+
+    now = 1001; // c expires
+    CU_ASSERT_PTR_NULL(ttl_map_get(&map, "c"))
+    CU_ASSERT_EQUAL(ttl_map_get_ttl(&map, "c", &ttl), -1)
+    CU_ASSERT_EQUAL(ttl_map_get_ttl(&map, "a", &ttl), 0)
+    CU_ASSERT_EQUAL(ttl, 9)
+
+    now = 1009;
+    CU_ASSERT_STRING_EQUAL(ttl_map_get(&map, "a"), "1")
+    now = 1010; // a expires
+    CU_ASSERT_PTR_NULL(ttl_map_get(&map, "a"))
+    CU_ASSERT_STRING_EQUAL(ttl_map_get(&map, "b"), "2")
+    CU_ASSERT_EQUAL(ttl_map_size(&map), 1)
+
+    // Setting again reschedules, earlier as well as later
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "b", "4", 5), 0)
+    CU_ASSERT_EQUAL(ttl_map_get_ttl(&map, "b", &ttl), 0)
+    CU_ASSERT_EQUAL(ttl, 5)
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "a", "5", 100000), 0)
+    now = 1015; // b expires
+    CU_ASSERT_PTR_NULL(ttl_map_get(&map, "b"))
+    CU_ASSERT_EQUAL(ttl_map_del(&map, "b"), -1)
+    CU_ASSERT_STRING_EQUAL(ttl_map_get(&map, "a"), "5")
+
+    CU_ASSERT_EQUAL(ttl_map_del(&map, "a"), 0)
+    CU_ASSERT_PTR_NULL(ttl_map_get(&map, "a"))
+    CU_ASSERT_EQUAL(ttl_map_size(&map), 0)
+
+    // Deleted entries don't expire
+    now = 200000;
+    CU_ASSERT_EQUAL(ttl_map_expire(&map), 0)
+    CU_ASSERT_EQUAL(map.expirations, 3)
+
+    // Time to live past the end of the clock
+    CU_ASSERT_EQUAL(ttl_map_set(&map, "d", "6", UINT64_MAX), 0)
+    CU_ASSERT_EQUAL(ttl_map_get_ttl(&map, "d", &ttl), 0)
+    CU_ASSERT_EQUAL(ttl, UINT64_MAX - now)
+
+    CU_ASSERT_EQUAL(ttl_map_destroy(&map), 0)
+}
+
+void test_ttl_map_release() {
+    ttl_map map;
+    uint64_t now = 0;
+    void* last[2] = {NULL, NULL};
+    char key_a[] = "a";
+    char key_a_copy[] = "a";
+    char value_1[] = "1";
+    char value_2[] = "2";
+
+    CU_ASSERT_EQUAL(ttl_map_init(&map, 16, NULL, NULL), 0)
+    CU_ASSERT_EQUAL(ttl_map_set_clock(&map, test_clock, &now), 0)
+    ttl_map_set_release_func(&map, record_release, last);
+
+    // Replaced: only what's not held anymore
+    CU_ASSERT_EQUAL(ttl_map_set(&map, key_a, value_1, 10), 0)
+    CU_ASSERT_EQUAL(ttl_map_set(&map, key_a, value_2, 10), 0)
+    CU_ASSERT_PTR_NULL(last[0])
+    CU_ASSERT_PTR_EQUAL(last[1], value_1)
+    CU_ASSERT_EQUAL(ttl_map_set(&map, key_a_copy, value_2, 10), 0)
+    CU_ASSERT_PTR_EQUAL(last[0], key_a)
+    CU_ASSERT_PTR_NULL(last[1])
+
+    // Expired
+    now = 10;
+    CU_ASSERT_EQUAL(ttl_map_expire(&map), 1)
+    CU_ASSERT_PTR_EQUAL(last[0], key_a_copy)
+    CU_ASSERT_PTR_EQUAL(last[1], value_2)
+
+    // Deleted
+    CU_ASSERT_EQUAL(ttl_map_set(&map, key_a, value_1, 10), 0)
+    CU_ASSERT_EQUAL(ttl_map_del(&map, key_a_copy), 0)
+    CU_ASSERT_PTR_EQUAL(last[0], key_a)
+    CU_ASSERT_PTR_EQUAL(last[1], value_1)
+
+    // Left over at destroy time
+    CU_ASSERT_EQUAL(ttl_map_set(&map, key_a_copy, value_2, 10), 0)
+    CU_ASSERT_EQUAL(ttl_map_destroy(&map), 0)
+    CU_ASSERT_PTR_EQUAL(last[0], key_a_copy)
+    CU_ASSERT_PTR_EQUAL(last[1], value_2)
+}
+
+void test_ttl_map_mass_expiry() {
+    enum { KEY_COUNT = 100000, MAX_TTL = 5000 };
+    ttl_map map;
+    uint64_t now = 0;
+    size_t released = 0;
+    uint32_t* keys = malloc(KEY_COUNT * sizeof(uint32_t));
+
+    CU_ASSERT_PTR_NOT_NULL_FATAL(keys)
+    CU_ASSERT_EQUAL(ttl_map_init(&map, 16, cmp_uint32, hash_uint32), 0)
+    CU_ASSERT_EQUAL(ttl_map_set_clock(&map, test_clock, &now), 0)
+    ttl_map_set_release_func(&map, count_release, &released);
+
+    for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+        keys[i] = i;
+        CU_ASSERT_EQUAL(ttl_map_set(&map, &keys[i], NULL, 1 + i % MAX_TTL), 0)
+    }
+    CU_ASSERT_EQUAL(ttl_map_size(&map), KEY_COUNT)
+
+    // Each tick expires exactly the keys due then
+    for (now = 1; now <= MAX_TTL; now += 7) {
+        const size_t due = KEY_COUNT / MAX_TTL * now;
+
+        ttl_map_expire(&map);
+        CU_ASSERT_EQUAL(map.expirations, due)
+        CU_ASSERT_EQUAL(ttl_map_size(&map), KEY_COUNT - due)
+        CU_ASSERT_EQUAL(hash_table_size(&map.index.table), KEY_COUNT - due)
+    }
+
+    now = MAX_TTL;
+    CU_ASSERT_EQUAL(ttl_map_size(&map), 0)
+    CU_ASSERT_EQUAL(released, KEY_COUNT)
+
+    CU_ASSERT_EQUAL(ttl_map_destroy(&map), 0)
+    CU_ASSERT_EQUAL(released, KEY_COUNT)
+
+    free(keys);
+}
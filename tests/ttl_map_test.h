@@ -0,0 +1,14 @@
+#ifndef __TTL_MAP_TEST_H__
+#define __TTL_MAP_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_ttl_map_tests();
+
+void test_ttl_map();
+
+void test_ttl_map_release();
+
+void test_ttl_map_mass_expiry();
+
+#endif
@@ -0,0 +1,162 @@
+#include "typed_containers_test.h"
+#include "../utils/typed_array_list.h"
+#include "../utils/typed_hash_table.h"
+
+#define u32_eq(a, b) ((a) == (b))
+
+DECLARE_ARRAY_LIST(u32_list, uint32_t)
+
+DECLARE_HASH_TABLE(u32_table, uint32_t, uint64_t, typed_hash_u32, u32_eq)
+
+/**
+ * Struct key, hashed and compared by field
+ */
+typedef struct flow_key {
+    uint32_t addr;
+    uint16_t port;
+} flow_key;
+
+static inline uint32_t flow_key_hash(const flow_key key) {
+    return typed_hash_u64((uint64_t)key.addr << 16 | key.port);
+}
+
+static inline int flow_key_eq(const flow_key a, const flow_key b) {
+    return a.addr == b.addr && a.port == b.port;
+}
+
+DECLARE_HASH_TABLE(flow_table, flow_key, int, flow_key_hash, flow_key_eq)
+
+CU_TestInfo* get_typed_containers_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_typed_array_list", test_typed_array_list},
+        {"test_typed_hash_table_get_and_set", test_typed_hash_table_get_and_set},
+        {"test_typed_hash_table_del_and_grow", test_typed_hash_table_del_and_grow},
+        {"test_typed_hash_table_struct_key", test_typed_hash_table_struct_key},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_typed_array_list() {
+    u32_list lst;
+    uint32_t value;
+
+    CU_ASSERT_EQUAL(u32_list_init(&lst, 2), 0)
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        CU_ASSERT_EQUAL(u32_list_push_tail(&lst, i), 0)
+    }
+
+    CU_ASSERT_EQUAL(u32_list_size(&lst), 100)
+    CU_ASSERT(lst.capacity >= 100)
+    CU_ASSERT_EQUAL(*u32_list_get_at(&lst, 42), 42)
+    CU_ASSERT_PTR_NULL(u32_list_get_at(&lst, 100))
+
+    CU_ASSERT_EQUAL(u32_list_insert_at(&lst, 1000, 0), 0) // [1000, 0, 1, ..., 99]
+    CU_ASSERT_EQUAL(u32_list_insert_at(&lst, 1001, 101), 0) // [1000, 0, 1, ..., 99, 1001]
+    CU_ASSERT_EQUAL(u32_list_insert_at(&lst, 1002, 200), -1)
+    CU_ASSERT_EQUAL(*u32_list_get_at(&lst, 0), 1000)
+    CU_ASSERT_EQUAL(*u32_list_get_at(&lst, 1), 0)
+    CU_ASSERT_EQUAL(*u32_list_get_at(&lst, 101), 1001)
+
+    CU_ASSERT_EQUAL(u32_list_del_at(&lst, 0, &value), 0) // [0, 1, ..., 99, 1001]
+    CU_ASSERT_EQUAL(value, 1000)
+    CU_ASSERT_EQUAL(*u32_list_get_at(&lst, 0), 0)
+
+    CU_ASSERT_EQUAL(u32_list_pop_tail(&lst, &value), 0) // [0, 1, ..., 99]
+    CU_ASSERT_EQUAL(value, 1001)
+    CU_ASSERT_EQUAL(u32_list_size(&lst), 100)
+
+    CU_ASSERT_EQUAL(u32_list_resize(&lst, 10), -1) // Can't drop values
+
+    CU_ASSERT_EQUAL(u32_list_destroy(&lst), 0)
+    CU_ASSERT_EQUAL(u32_list_pop_tail(&lst, &value), -1)
+}
+
+void test_typed_hash_table_get_and_set() {
+    u32_table ht;
+
+    CU_ASSERT_EQUAL(u32_table_init(&ht, 50), 0)
+    CU_ASSERT_EQUAL(ht.capacity, 64)
+
+    CU_ASSERT_EQUAL(u32_table_set(&ht, 1, 100), 0) // {1: 100}
+    CU_ASSERT_EQUAL(u32_table_set(&ht, 2, 200), 0) // {1: 100, 2: 200}
+    CU_ASSERT_EQUAL(*u32_table_get(&ht, 1), 100)
+    CU_ASSERT_EQUAL(*u32_table_get(&ht, 2), 200)
+    CU_ASSERT_PTR_NULL(u32_table_get(&ht, 3))
+
+    CU_ASSERT_EQUAL(u32_table_set(&ht, 1, 300), 0) // {1: 300, 2: 200}
+    CU_ASSERT_EQUAL(*u32_table_get(&ht, 1), 300)
+    CU_ASSERT_EQUAL(u32_table_size(&ht), 2)
+
+    // Iterate
+    uint64_t sum = 0;
+    size_t pos = 0;
+    const u32_table_entry* p_entry;
+    while ((p_entry = u32_table_next(&ht, &pos)) != NULL) {
+        sum += p_entry->key + p_entry->value;
+    }
+    CU_ASSERT_EQUAL(sum, 1 + 300 + 2 + 200)
+
+    CU_ASSERT_EQUAL(u32_table_destroy(&ht), 0)
+    CU_ASSERT_EQUAL(u32_table_destroy(&ht), -1)
+}
+
+void test_typed_hash_table_del_and_grow() {
+    u32_table ht;
+
+    CU_ASSERT_EQUAL(u32_table_init(&ht, 8), 0)
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        CU_ASSERT_EQUAL(u32_table_set(&ht, i, i * 2), 0)
+    }
+
+    CU_ASSERT_EQUAL(u32_table_size(&ht), 1000)
+    CU_ASSERT(ht.capacity >= 1000)
+
+    for (uint32_t i = 0; i < 1000; i += 2) {
+        CU_ASSERT_EQUAL(u32_table_del(&ht, i), 0)
+    }
+
+    CU_ASSERT_EQUAL(u32_table_del(&ht, 0), -1)
+    CU_ASSERT_EQUAL(u32_table_size(&ht), 500)
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const uint64_t* p_value = u32_table_get(&ht, i);
+        if (i % 2 == 0) {
+            CU_ASSERT_PTR_NULL(p_value)
+        }
+        else {
+            CU_ASSERT_PTR_NOT_NULL_FATAL(p_value)
+            CU_ASSERT_EQUAL(*p_value, i * 2)
+        }
+    }
+
+    // Churn: tombstones are reclaimed without growing forever
+    const size_t capacity = ht.capacity;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        CU_ASSERT_EQUAL_FATAL(u32_table_set(&ht, 1000 + i, i), 0)
+        CU_ASSERT_EQUAL_FATAL(u32_table_del(&ht, 1000 + i), 0)
+    }
+    CU_ASSERT_EQUAL(ht.capacity, capacity)
+    CU_ASSERT_EQUAL(u32_table_size(&ht), 500)
+
+    CU_ASSERT_EQUAL(u32_table_destroy(&ht), 0)
+}
+
+void test_typed_hash_table_struct_key() {
+    flow_table ht;
+    const flow_key a = { .addr = 0x0100007f, .port = 80 };
+    const flow_key b = { .addr = 0x0100007f, .port = 443 };
+
+    CU_ASSERT_EQUAL(flow_table_init(&ht, 0), 0)
+
+    CU_ASSERT_EQUAL(flow_table_set(&ht, a, 1), 0)
+    CU_ASSERT_EQUAL(flow_table_set(&ht, b, 2), 0)
+    CU_ASSERT_EQUAL(*flow_table_get(&ht, a), 1)
+    CU_ASSERT_EQUAL(*flow_table_get(&ht, b), 2)
+    CU_ASSERT_EQUAL(flow_table_size(&ht), 2)
+
+    CU_ASSERT_EQUAL(flow_table_destroy(&ht), 0)
+}
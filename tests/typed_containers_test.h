@@ -0,0 +1,16 @@
+#ifndef __TYPED_CONTAINERS_TEST_H__
+#define __TYPED_CONTAINERS_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_typed_containers_tests();
+
+void test_typed_array_list();
+
+void test_typed_hash_table_get_and_set();
+
+void test_typed_hash_table_del_and_grow();
+
+void test_typed_hash_table_struct_key();
+
+#endif
@@ -0,0 +1,53 @@
+#include <string.h>
+
+#include "wyhash_test.h"
+#include "../utils/wyhash.h"
+
+CU_TestInfo* get_wyhash_tests() {
+    static CU_TestInfo tests[] = {
+        {"test_wyhash", test_wyhash},
+        {"test_wyhash_str", test_wyhash_str},
+        CU_TEST_INFO_NULL,
+    };
+
+    return tests;
+}
+
+void test_wyhash() {
+    // Reference test vectors (seed = index of vector)
+    CU_ASSERT_EQUAL(wyhash("", 0, 0), 0x93228a4de0eec5a2ULL)
+    CU_ASSERT_EQUAL(wyhash("a", 1, 1), 0xc5bac3db178713c4ULL)
+    CU_ASSERT_EQUAL(wyhash("abc", 3, 2), 0xa97f2f7b1d9b3314ULL)
+    CU_ASSERT_EQUAL(wyhash("message digest", 14, 3), 0x786d1f1df3801df4ULL)
+    CU_ASSERT_EQUAL(wyhash("abcdefghijklmnopqrstuvwxyz", 26, 4), 0xdca5a8138ad37c87ULL)
+    CU_ASSERT_EQUAL(
+        wyhash("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 62, 5),
+        0xb9e734f117cfaf70ULL
+    )
+    CU_ASSERT_EQUAL(
+        wyhash("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 80, 6),
+        0x6cc5eab49a92d617ULL
+    )
+}
+
+void test_wyhash_str() {
+    char str[64];
+    uint64_t hashes[64];
+
+    // Every prefix (including block boundaries) hashes differently
+    for (size_t len = 0; len < sizeof(str); ++len) {
+        memset(str, 'x', len);
+        str[len] = 0;
+        hashes[len] = wyhash_str(str, 0);
+
+        for (size_t i = 0; i < len; ++i) {
+            CU_ASSERT_NOT_EQUAL(hashes[i], hashes[len])
+        }
+    }
+
+    // Depends on every byte and on the seed
+    CU_ASSERT_NOT_EQUAL(wyhash_str("192.168.0.1", 0), wyhash_str("192.168.0.2", 0))
+    CU_ASSERT_NOT_EQUAL(wyhash_str("0123456789abcdefX", 0), wyhash_str("0123456789abcdefY", 0))
+    CU_ASSERT_NOT_EQUAL(wyhash_str("192.168.0.1", 0), wyhash_str("192.168.0.1", 1))
+    CU_ASSERT_EQUAL(wyhash_str("192.168.0.1", 7), wyhash_str("192.168.0.1", 7))
+}
@@ -0,0 +1,12 @@
+#ifndef __WYHASH_TEST_H__
+#define __WYHASH_TEST_H__
+
+#include <CUnit/Basic.h>
+
+CU_TestInfo* get_wyhash_tests();
+
+void test_wyhash();
+
+void test_wyhash_str();
+
+#endif
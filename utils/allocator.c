@@ -0,0 +1,28 @@
+#include "allocator.h"
+
+void* allocator_alloc(allocator* alloc, const size_t size) {
+    if (alloc == NULL) {
+        return malloc(size);
+    }
+
+    return (*alloc->alloc)(alloc, size);
+}
+
+void allocator_free(allocator* alloc, void* ptr) {
+    if (alloc == NULL) {
+        free(ptr);
+        return;
+    }
+
+    (*alloc->free)(alloc, ptr);
+}
+
+int allocator_reset(allocator* alloc) {
+    if (alloc == NULL || alloc->reset == NULL) {
+        return -1;
+    }
+
+    (*alloc->reset)(alloc);
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef __ALLOCATOR_H__
+#define __ALLOCATOR_H__
+
+/**
+ * Pluggable memory allocator interface
+ *
+ * Containers that accept an allocator draw their internal nodes from it
+ * instead of calling malloc() directly. A NULL allocator means malloc()/free().
+ */
+
+#include <stdlib.h>
+
+/**
+ * Allocator
+ * Embed as the first member of an allocator implementation (see slab.h)
+ */
+typedef struct allocator {
+    /**
+     * Allocate memory
+     *
+     * @param self Allocator
+     * @param size Number of bytes
+     * @return Pointer to memory (or NULL on failure)
+     */
+    void* (*alloc)(struct allocator* self, size_t size);
+
+    /**
+     * Return memory to the allocator
+     *
+     * @param self Allocator
+     * @param ptr Pointer previously returned by alloc
+     */
+    void (*free)(struct allocator* self, void* ptr);
+
+    /**
+     * Release everything allocated at once (NULL if unsupported)
+     *
+     * @param self Allocator
+     */
+    void (*reset)(struct allocator* self);
+} allocator;
+
+/**
+ * Allocate memory from allocator
+ *
+ * @param alloc Allocator (or NULL for malloc)
+ * @param size Number of bytes
+ * @return Pointer to memory (or NULL on failure)
+ */
+void* allocator_alloc(allocator* alloc, size_t size);
+
+/**
+ * Return memory to allocator
+ *
+ * @param alloc Allocator (or NULL for free)
+ * @param ptr Pointer previously returned by allocator_alloc()
+ */
+void allocator_free(allocator* alloc, void* ptr);
+
+/**
+ * Release everything allocated from allocator at once
+ *
+ * @param alloc Allocator
+ * @return 0 on success, -1 if the allocator doesn't support bulk release
+ */
+int allocator_reset(allocator* alloc);
+
+#endif
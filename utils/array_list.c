@@ -1,87 +1,396 @@
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "array_list.h"
 
 /**
- * Allocate new array in array list
+ * Capacity of an empty array list once it needs to grow
+ */
+#define MIN_CAPACITY 4
+
+/**
+ * Get the slot of the array holding a position
+ *
+ * @param lst Array list
+ * @param pos Position (at most the capacity)
+ * @return Slot index
+ */
+static inline size_t slot(const array_list* lst, const size_t pos) {
+    const size_t index = lst->head + pos;
+
+    return index < lst->capacity ? index : index - lst->capacity;
+}
+
+/**
+ * Get the address of a slot
+ *
+ * @param lst Array list
+ * @param index Slot index
+ * @return Slot address
+ */
+static inline char* slot_ptr(const array_list* lst, const size_t index) {
+    return (char *)lst->data + index * lst->slot_size;
+}
+
+/**
+ * Get the number of slots to allocate for a capacity
+ * (ARRAY_LIST_VALUES keeps a spare slot past the end to hold deleted values)
  *
  * @param lst Array list
+ * @param capacity Capacity
+ * @return Number of slots
+ */
+static inline size_t alloc_slots(const array_list* lst, const size_t capacity) {
+    return lst->type == ARRAY_LIST_VALUES ? capacity + 1 : capacity;
+}
+
+/**
+ * Copy the values of an array list into a new array starting at slot 0
+ *
+ * @param lst Array list
+ * @param capacity Capacity of the new array (at least the size)
  * @return 0 on success, -1 on failure
  */
-static int alloc_array(array_list* lst) {
-    void* new_array;
+static int linearize(array_list* lst, const size_t capacity) {
+    array_list_span spans[2];
+    const size_t span_count = array_list_get_spans(lst, spans);
 
-    if (lst->array == NULL) {
-        // First allocation
-        new_array = malloc(lst->capacity * lst->value_size);
+    char* new_data = malloc(alloc_slots(lst, capacity) * lst->slot_size);
+    if (new_data == NULL) {
+        perror("linearize: malloc() failed");
+        return -1;
     }
-    else {
-        // Subsequent allocation
-        new_array = realloc(lst->array, lst->capacity * lst->value_size);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < span_count; ++i) {
+        memcpy(&new_data[offset], spans[i].data, spans[i].size * lst->slot_size);
+        offset += spans[i].size * lst->slot_size;
     }
 
-    if (new_array == NULL) {
-        perror("alloc_array: malloc() failed");
+    free(lst->data);
+    lst->data = new_data;
+    lst->capacity = capacity;
+    lst->head = 0;
+
+    return 0;
+}
+
+/**
+ * Reallocate the array of an array list
+ *
+ * @param lst Array list
+ * @param capacity New capacity (at least the size)
+ * @return 0 on success, -1 on failure
+ */
+static int alloc_array(array_list* lst, const size_t capacity) {
+    if (capacity == 0) {
+        free(lst->data);
+        lst->data = NULL;
+        lst->capacity = 0;
+        lst->head = 0;
+        return 0;
+    }
+
+    if (capacity >= SIZE_MAX / lst->slot_size) {
+        fprintf(stderr, "alloc_array: capacity %zu is too large\n", capacity);
+        return -1;
+    }
+
+    if (capacity < lst->capacity && lst->head != 0) {
+        // Values past the new capacity would be cut off
+        return linearize(lst, capacity);
+    }
+
+    char* new_data = realloc(lst->data, alloc_slots(lst, capacity) * lst->slot_size);
+    if (new_data == NULL) {
+        perror("alloc_array: realloc() failed");
         return -1;
     }
 
-    lst->array = new_array;
+    const size_t old_capacity = lst->capacity;
+    lst->data = new_data;
+    lst->capacity = capacity;
+
+    if (lst->type == ARRAY_LIST_VALUES && old_capacity != 0 && capacity > old_capacity) {
+        // Keep the spare slot past the new end, before wrapped values move
+        // over its old place
+        memcpy(slot_ptr(lst, capacity), slot_ptr(lst, old_capacity), lst->slot_size);
+    }
+
+    if (lst->head + lst->size > old_capacity) {
+        // Values wrapped around: move the ones up to the old end to the new end
+        const size_t head_size = old_capacity - lst->head;
+        memmove(slot_ptr(lst, capacity - head_size), slot_ptr(lst, lst->head), head_size * lst->slot_size);
+        lst->head = capacity - head_size;
+    }
 
     return 0;
 }
 
-int array_list_init(array_list* lst, const size_t value_size, const size_t capacity) {
-    lst->size = 0;
-    lst->value_size = value_size;
-    lst->capacity = capacity;
-    lst->array = NULL;
+/**
+ * Make room for more values, growing the array geometrically if needed
+ * (so that appending is amortized O(1))
+ *
+ * @param lst Array list
+ * @param count Number of values to make room for
+ * @return 0 on success, -1 on failure
+ */
+static int grow(array_list* lst, const size_t count) {
+    if (count <= lst->capacity - lst->size) {
+        return 0;
+    }
+
+    if (count > SIZE_MAX - lst->size) {
+        fprintf(stderr, "grow: size overflow\n");
+        return -1;
+    }
 
-    if (alloc_array(lst) != 0) {
+    const double scaled = (double)lst->capacity * lst->growth_factor;
+    size_t capacity = scaled < (double)SIZE_MAX ? (size_t)scaled : SIZE_MAX;
+
+    // Small capacities may not grow at all once truncated
+    if (capacity < lst->size + count) {
+        capacity = lst->size + count;
+    }
+
+    if (capacity < MIN_CAPACITY) {
+        capacity = MIN_CAPACITY;
+    }
+
+    return alloc_array(lst, capacity);
+}
+
+/**
+ * Make room for one more value, before storing a value that may point into
+ * the list itself (ARRAY_LIST_VALUES)
+ * A value that would move is first copied to the spare slot, which growing
+ * keeps: always when values are shifted, or only when the array grows
+ *
+ * @param lst Array list
+ * @param value Value, or pointer to value (updated to point to the copy)
+ * @param shifting 1 if values are shifted to make room
+ * @return 0 on success, -1 on failure
+ */
+static int grow_one(array_list* lst, void** value, const int shifting) {
+    // (An empty array holds nothing a value could point into)
+    const int hold = lst->type == ARRAY_LIST_VALUES
+        && lst->data != NULL
+        && (shifting || lst->size == lst->capacity);
+
+    if (hold) {
+        memmove(slot_ptr(lst, lst->capacity), *value, lst->slot_size);
+    }
+
+    if (grow(lst, 1) != 0) {
         return -1;
     }
 
+    if (hold) {
+        *value = slot_ptr(lst, lst->capacity);
+    }
+
     return 0;
 }
 
-size_t array_list_index_of(const array_list* lst, const void* value) {
-    for (size_t i = 0; i < lst->size; ++i) {
-        if (lst->array[i] == value) {
-            return i;
+/**
+ * Check whether a run of values overlaps the array of a list
+ *
+ * @param lst Array list
+ * @param values Values
+ * @param count Number of values
+ * @return 1 if it does, 0 otherwise
+ */
+static int overlaps(const array_list* lst, const void* values, const size_t count) {
+    const uintptr_t start = (uintptr_t)lst->data;
+    const uintptr_t end = start + alloc_slots(lst, lst->capacity) * lst->slot_size;
+
+    return lst->data != NULL && (uintptr_t)values < end && (uintptr_t)values + count * lst->slot_size > start;
+}
+
+/**
+ * Move values between (possibly overlapping) runs of slots, which may both
+ * wrap around the end of the array
+ *
+ * @param lst Array list
+ * @param dst First destination slot
+ * @param src First source slot
+ * @param count Number of values
+ * @param backward 1 to move the last values first (when moving to higher positions)
+ */
+static void move_slots(array_list* lst, size_t dst, size_t src, size_t count, const int backward) {
+    const size_t capacity = lst->capacity;
+
+    if (!backward) {
+        while (count > 0) {
+            size_t run = count;
+            run = run < capacity - src ? run : capacity - src;
+            run = run < capacity - dst ? run : capacity - dst;
+
+            memmove(slot_ptr(lst, dst), slot_ptr(lst, src), run * lst->slot_size);
+
+            src = src + run < capacity ? src + run : 0;
+            dst = dst + run < capacity ? dst + run : 0;
+            count -= run;
         }
+
+        return;
     }
 
-    return -1;
+    // Slots just past the runs
+    size_t src_end = src + count < capacity ? src + count : src + count - capacity;
+    size_t dst_end = dst + count < capacity ? dst + count : dst + count - capacity;
+
+    while (count > 0) {
+        if (src_end == 0) {
+            src_end = capacity;
+        }
+        if (dst_end == 0) {
+            dst_end = capacity;
+        }
+
+        size_t run = count;
+        run = run < src_end ? run : src_end;
+        run = run < dst_end ? run : dst_end;
+
+        src_end -= run;
+        dst_end -= run;
+        memmove(slot_ptr(lst, dst_end), slot_ptr(lst, src_end), run * lst->slot_size);
+
+        count -= run;
+    }
 }
 
 /**
- * Remove item at pos and shift items after it left
+ * Copy a value into a slot
  *
- * @param lst List
- * @param pos Position to remove
+ * @param lst Array list
+ * @param index Slot index
+ * @param value Value (ARRAY_LIST_POINTERS) or pointer to value (ARRAY_LIST_VALUES)
  */
-static void shift_left(array_list* lst, size_t pos) {
-    --lst->size;
+static inline void store(array_list* lst, const size_t index, void* value) {
+    if (lst->type == ARRAY_LIST_POINTERS) {
+        lst->array[index] = value;
+    }
+    else {
+        memcpy(slot_ptr(lst, index), value, lst->slot_size);
+    }
+}
 
-    for (size_t i = pos; i < lst->size; ++i) {
-        lst->array[i] = lst->array[i + 1];
+/**
+ * Get the value of a slot
+ *
+ * @param lst Array list
+ * @param index Slot index
+ * @return Value (ARRAY_LIST_POINTERS) or pointer to the slot (ARRAY_LIST_VALUES)
+ */
+static inline void* load(const array_list* lst, const size_t index) {
+    if (lst->type == ARRAY_LIST_POINTERS) {
+        return lst->array[index];
     }
+
+    return slot_ptr(lst, index);
 }
 
 /**
- * Remove item at pos and shift items before it right
+ * Initialize the fields of an array list and allocate its array
  *
- * @param lst List
- * @param pos Position to remove
+ * @param lst Empty list to initialize
+ * @param type Storage type
+ * @param value_size Size of each value
+ * @param slot_size Size of each slot of the array
+ * @param capacity Initial capacity
+ * @return 0 on success, -1 on failure
  */
-static void shift_right(array_list* lst, size_t pos) {
-    if ((pos + 1) >= lst->capacity) {
-        array_list_resize(lst, pos + 1);
+static int init(
+    array_list* lst,
+    const array_list_type type,
+    const size_t value_size,
+    const size_t slot_size,
+    const size_t capacity
+) {
+    lst->size = 0;
+    lst->value_size = value_size;
+    lst->capacity = 0;
+    lst->data = NULL;
+    lst->head = 0;
+    lst->growth_factor = ARRAY_LIST_GROWTH_FACTOR;
+    lst->type = type;
+    lst->slot_size = slot_size;
+
+    if (alloc_array(lst, capacity) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int array_list_init(array_list* lst, const size_t value_size, const size_t capacity) {
+    return init(lst, ARRAY_LIST_POINTERS, value_size, sizeof(void *), capacity);
+}
+
+int array_list_init_values(array_list* lst, const size_t value_size, const size_t capacity) {
+    if (value_size == 0) {
+        fprintf(stderr, "array_list_init_values: value size can't be 0\n");
+        return -1;
+    }
+
+    return init(lst, ARRAY_LIST_VALUES, value_size, value_size, capacity);
+}
+
+size_t array_list_index_of(const array_list* lst, const void* value) {
+    if (lst->type == ARRAY_LIST_POINTERS) {
+        for (size_t i = 0; i < lst->size; ++i) {
+            if (lst->array[slot(lst, i)] == value) {
+                return i;
+            }
+        }
+
+        return -1;
     }
 
-    for (size_t i = lst->size; i > pos; --i) {
-        lst->array[i] = lst->array[i - 1];
+    for (size_t i = 0; i < lst->size; ++i) {
+        if (memcmp(slot_ptr(lst, slot(lst, i)), value, lst->slot_size) == 0) {
+            return i;
+        }
     }
+
+    return -1;
+}
+
+void* array_list_emplace_at(array_list* lst, const size_t pos) {
+    if (pos > lst->size) {
+        fprintf(stderr, "array_list_emplace_at: index %zu is out of bounds %zu\n", pos, lst->size);
+        return NULL;
+    }
+
+    if (grow(lst, 1) != 0) {
+        return NULL;
+    }
+
+    // Shift whichever side of pos is shorter (nothing at either end)
+    if (pos < lst->size - pos) {
+        const size_t old_head = lst->head;
+
+        lst->head = old_head > 0 ? old_head - 1 : lst->capacity - 1;
+        move_slots(lst, lst->head, old_head, pos, 0);
+    }
+    else {
+        move_slots(lst, slot(lst, pos + 1), slot(lst, pos), lst->size - pos, 1);
+    }
+
+    ++lst->size;
+
+    return slot_ptr(lst, slot(lst, pos));
+}
+
+void* array_list_emplace_tail(array_list* lst) {
+    if (grow(lst, 1) != 0) {
+        return NULL;
+    }
+
+    return slot_ptr(lst, slot(lst, lst->size++));
 }
 
 int array_list_insert_at(array_list* lst, void* value, const size_t pos) {
@@ -90,16 +399,16 @@ int array_list_insert_at(array_list* lst, void* value, const size_t pos) {
         return -1;
     }
 
-    if (lst->size == 0 && pos == 0) {
-        lst->array[0] = value;
-        ++lst->size;
-        return 0;
+    if (grow_one(lst, &value, 1) != 0) {
+        return -1;
     }
 
-    shift_right(lst, pos);
+    void* p_slot = array_list_emplace_at(lst, pos);
+    if (p_slot == NULL) {
+        return -1;
+    }
 
-    lst->array[pos] = value;
-    ++lst->size;
+    memcpy(p_slot, lst->type == ARRAY_LIST_POINTERS ? (void *)&value : value, lst->slot_size);
 
     return 0;
 }
@@ -109,7 +418,7 @@ void* array_list_get_at(const array_list* lst, const size_t pos) {
         return NULL;
     }
 
-    return lst->array[pos];
+    return load(lst, slot(lst, pos));
 }
 
 void* array_list_del_at(array_list* lst, const size_t pos) {
@@ -117,9 +426,28 @@ void* array_list_del_at(array_list* lst, const size_t pos) {
         return NULL;
     }
 
-    void* value = array_list_get_at(lst, pos);
+    void* value;
+    if (lst->type == ARRAY_LIST_POINTERS) {
+        value = lst->array[slot(lst, pos)];
+    }
+    else {
+        // The slot is about to be overwritten: keep a copy in the spare slot
+        value = slot_ptr(lst, lst->capacity);
+        memcpy(value, slot_ptr(lst, slot(lst, pos)), lst->slot_size);
+    }
 
-    shift_left(lst, pos);
+    // Close the gap from whichever side of pos is shorter (nothing at either end)
+    if (pos < lst->size - 1 - pos) {
+        move_slots(lst, slot(lst, 1), lst->head, pos, 1);
+        lst->head = slot(lst, 1);
+    }
+    else {
+        move_slots(lst, slot(lst, pos), slot(lst, pos + 1), lst->size - 1 - pos, 0);
+    }
+
+    if (--lst->size == 0) {
+        lst->head = 0;
+    }
 
     return value;
 }
@@ -134,7 +462,15 @@ void* array_list_del_value(array_list* lst, const void* value) {
 }
 
 int array_list_push_head(array_list* lst, void* value) {
-    return array_list_insert_at(lst, value, 0);
+    if (grow_one(lst, &value, 0) != 0) {
+        return -1;
+    }
+
+    lst->head = lst->head > 0 ? lst->head - 1 : lst->capacity - 1;
+    store(lst, lst->head, value);
+    ++lst->size;
+
+    return 0;
 }
 
 void* array_list_pop_head(array_list* lst) {
@@ -142,11 +478,23 @@ void* array_list_pop_head(array_list* lst) {
         return NULL;
     }
 
-    return array_list_del_at(lst, 0);
+    // (The vacated slot keeps an ARRAY_LIST_VALUES value until the next change)
+    void* value = load(lst, lst->head);
+
+    lst->head = --lst->size == 0 ? 0 : slot(lst, 1);
+
+    return value;
 }
 
 int array_list_push_tail(array_list* lst, void* value) {
-    return array_list_insert_at(lst, value, lst->size);
+    if (grow_one(lst, &value, 0) != 0) {
+        return -1;
+    }
+
+    store(lst, slot(lst, lst->size), value);
+    ++lst->size;
+
+    return 0;
 }
 
 void* array_list_pop_tail(array_list* lst) {
@@ -154,42 +502,147 @@ void* array_list_pop_tail(array_list* lst) {
         return NULL;
     }
 
-    return array_list_del_at(lst, lst->size - 1);
+    void* value = load(lst, slot(lst, lst->size - 1));
+
+    if (--lst->size == 0) {
+        lst->head = 0;
+    }
+
+    return value;
 }
 
-int array_list_resize(array_list* lst, const size_t capacity) {
-    const size_t old_capacity = lst->capacity;
+int array_list_push_tail_n(array_list* lst, const void* values, const size_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Values from the list itself would move, or be freed, when it grows
+    void* p_copy = NULL;
+    if (count > lst->capacity - lst->size && overlaps(lst, values, count)) {
+        p_copy = malloc(count * lst->slot_size);
+        if (p_copy == NULL) {
+            perror("array_list_push_tail_n: malloc() failed");
+            return -1;
+        }
+
+        memcpy(p_copy, values, count * lst->slot_size);
+        values = p_copy;
+    }
+
+    if (grow(lst, count) != 0) {
+        free(p_copy);
+        return -1;
+    }
+
+    // Up to the end of the array, then from its start
+    const size_t tail = slot(lst, lst->size);
+    const size_t first = count < lst->capacity - tail ? count : lst->capacity - tail;
+
+    memcpy(slot_ptr(lst, tail), values, first * lst->slot_size);
+    memcpy(lst->data, (const char *)values + first * lst->slot_size, (count - first) * lst->slot_size);
+    lst->size += count;
+
+    free(p_copy);
+
+    return 0;
+}
+
+size_t array_list_pop_head_n(array_list* lst, void* values_out, size_t count) {
+    if (count > lst->size) {
+        count = lst->size;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (values_out != NULL) {
+        const size_t first = count < lst->capacity - lst->head ? count : lst->capacity - lst->head;
+
+        memcpy(values_out, slot_ptr(lst, lst->head), first * lst->slot_size);
+        memcpy((char *)values_out + first * lst->slot_size, lst->data, (count - first) * lst->slot_size);
+    }
 
+    lst->size -= count;
+    lst->head = lst->size > 0 ? slot(lst, count) : 0;
+
+    return count;
+}
+
+size_t array_list_get_spans(const array_list* lst, array_list_span spans[2]) {
+    if (lst->size == 0) {
+        return 0;
+    }
+
+    const size_t first = lst->size < lst->capacity - lst->head ? lst->size : lst->capacity - lst->head;
+
+    spans[0].data = slot_ptr(lst, lst->head);
+    spans[0].size = first;
+
+    if (first == lst->size) {
+        return 1;
+    }
+
+    spans[1].data = lst->data;
+    spans[1].size = lst->size - first;
+
+    return 2;
+}
+
+void* array_list_make_contiguous(array_list* lst) {
+    if (lst->head != 0 && linearize(lst, lst->capacity) != 0) {
+        return NULL;
+    }
+
+    return lst->data;
+}
+
+int array_list_resize(array_list* lst, const size_t capacity) {
     if (capacity == lst->capacity) {
         // ignore
         return 0;
     }
 
-    if (capacity < lst->capacity && capacity < lst->size) {
+    if (capacity < lst->size) {
         fprintf(stderr, "array_list_resize: new capacity %zu is smaller than list size %zu\n", capacity, lst->size);
         return -1;
     }
 
-    printf("array_list_resize: resizing from %zu to %zu\n", lst->capacity, capacity);
-    lst->capacity = capacity;
+    return alloc_array(lst, capacity);
+}
 
-    if (alloc_array(lst) == -1) {
-        lst->capacity = old_capacity;
+int array_list_reserve(array_list* lst, const size_t capacity) {
+    if (capacity <= lst->capacity) {
+        return 0;
+    }
+
+    return alloc_array(lst, capacity);
+}
+
+int array_list_shrink_to_fit(array_list* lst) {
+    return array_list_resize(lst, lst->size);
+}
+
+int array_list_set_growth_factor(array_list* lst, const double growth_factor) {
+    // (Also rejects NaN)
+    if (!(growth_factor > 1.0)) {
+        fprintf(stderr, "array_list_set_growth_factor: growth factor must be greater than 1\n");
         return -1;
     }
 
+    lst->growth_factor = growth_factor;
+
     return 0;
 }
 
 int array_list_destroy(array_list* lst) {
-    if (lst->array != NULL) {
-        free(lst->array);
-        lst->array = NULL;
-    }
+    free(lst->data);
+    lst->data = NULL;
 
     lst->size = 0;
     lst->value_size = 0;
     lst->capacity = 0;
+    lst->head = 0;
 
     return 0;
 }
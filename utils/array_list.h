@@ -1,25 +1,128 @@
 #ifndef __ARRAY_LIST_H_DEFINED__
 #define __ARRAY_LIST_H_DEFINED__
 
+#include <stddef.h>
+
+/**
+ * Default factor the capacity is multiplied by when the array is full
+ */
+#define ARRAY_LIST_GROWTH_FACTOR 2.0
+
+/**
+ * Array list storage type
+ */
+typedef enum array_list_type {
+  /**
+   * The array holds pointers to values stored elsewhere (array_list_init)
+   */
+  ARRAY_LIST_POINTERS = 0,
+
+  /**
+   * The array holds the values themselves, value_size bytes each
+   * (array_list_init_values)
+   */
+  ARRAY_LIST_VALUES
+} array_list_type;
+
+/**
+ * Array list
+ *
+ * Values are kept in a circular buffer: the list starts at slot head and may
+ * wrap around the end of the array, so both ends can grow and shrink in O(1).
+ * Use array_list_get_spans() or array_list_make_contiguous() to access the
+ * values in place.
+ *
+ * Functions taking or returning a value work with the value itself for
+ * ARRAY_LIST_POINTERS, and with a pointer to the value for ARRAY_LIST_VALUES
+ * (values are copied in, and pointers returned into the array stay valid
+ * until the list is modified).
+ */
 typedef struct array_list {
   size_t size;
   size_t value_size;
   size_t capacity;
-  void** array;
+
+  union {
+    /**
+     * ARRAY_LIST_POINTERS: Array of value pointers
+     */
+    void** array;
+
+    /**
+     * Array of slots (slot_size bytes each)
+     */
+    void* data;
+  };
+
+  /**
+   * Slot of the first value
+   */
+  size_t head;
+
+  /**
+   * Factor the capacity is multiplied by when the array is full
+   */
+  double growth_factor;
+
+  /**
+   * Storage type
+   */
+  array_list_type type;
+
+  /**
+   * Size of each slot of the array (value_size for ARRAY_LIST_VALUES)
+   */
+  size_t slot_size;
 } array_list;
 
 /**
- * Initialize array list
+ * Run of consecutive values stored next to each other
+ */
+typedef struct array_list_span {
+  union {
+    /**
+     * ARRAY_LIST_POINTERS: First value
+     */
+    void** values;
+
+    /**
+     * First slot
+     */
+    void* data;
+  };
+  size_t size;
+} array_list_span;
+
+/**
+ * Value comparator function
+ * Gets values the way array_list_get_at() returns them (pointers to the
+ * values for ARRAY_LIST_VALUES), and returns <0, 0 or >0 like strcmp()
+ */
+typedef int (*array_list_cmp_func)(const void* value_a, const void* value_b);
+
+/**
+ * Initialize array list storing pointers to values (ARRAY_LIST_POINTERS)
  *
  * @param lst Empty list to initialize
  * @param value_size Size of each value in array
- * @param capacity Max capacity of array list (before it gets resized)
+ * @param capacity Max capacity of array list (before it gets resized, may be 0)
  * @return 0 on success, -1 on failure
  */
 int array_list_init(array_list* lst, size_t value_size, size_t capacity);
 
+/**
+ * Initialize array list storing values inline (ARRAY_LIST_VALUES)
+ *
+ * @param lst Empty list to initialize
+ * @param value_size Size of each value in bytes
+ * @param capacity Max capacity of array list (before it gets resized, may be 0)
+ * @return 0 on success, -1 on failure
+ */
+int array_list_init_values(array_list* lst, size_t value_size, size_t capacity);
+
 /**
  * Find index of value
+ * ARRAY_LIST_VALUES compares the bytes of the values
  *
  * @param lst Array list
  * @param value Value to search
@@ -29,14 +132,33 @@ size_t array_list_index_of(const array_list* lst, const void* value);
 
 /**
  * Insert value into array list at position
+ * Shifts the values on the shorter side of pos (none at either end)
  *
  * @param lst Array list
- * @param value Value to insert
+ * @param value Value to insert (ARRAY_LIST_VALUES: may point into the list)
  * @param pos Position to insert at
  * @return 0 on success, -1 on failure
  */
 int array_list_insert_at(array_list* lst, void* value, size_t pos);
 
+/**
+ * Make room for a value at position in array list, to be written in place
+ * Shifts the values on the shorter side of pos (none at either end)
+ *
+ * @param lst Array list
+ * @param pos Position to insert at
+ * @return Uninitialized slot of slot_size bytes (or NULL on failure)
+ */
+void* array_list_emplace_at(array_list* lst, size_t pos);
+
+/**
+ * Make room for a value at the tail of array list, to be written in place
+ *
+ * @param lst Array list
+ * @return Uninitialized slot of slot_size bytes (or NULL on failure)
+ */
+void* array_list_emplace_tail(array_list* lst);
+
 /**
  * Get value at position in array list
  *
@@ -48,10 +170,12 @@ void* array_list_get_at(const array_list* lst, size_t pos);
 
 /**
  * Delete value at position in array list
+ * Shifts the values on the shorter side of pos (none at either end)
  *
  * @param lst Array list
  * @param pos Position to delete at
- * @return Value at position (or NULL if not found)
+ * @return Value at position (or NULL if not found; ARRAY_LIST_VALUES: a copy
+ * that stays valid until the list is modified)
  */
 void* array_list_del_at(array_list* lst, size_t pos);
 
@@ -77,7 +201,8 @@ int array_list_push_head(array_list* lst, void* value);
  * Pop value from head of array list
  *
  * @param lst Array list
- * @return Value that was popped (or NULL if not found)
+ * @return Value that was popped (or NULL if not found; ARRAY_LIST_VALUES: stays
+ * valid until the list is modified)
  */
 void* array_list_pop_head(array_list* lst);
 
@@ -94,19 +219,178 @@ int array_list_push_tail(array_list* lst, void* value);
  * Pop last (tail) value from array list
  *
  * @param lst Array list
- * @return Value from tail (or NULL if empty)
+ * @return Value from tail (or NULL if empty; ARRAY_LIST_VALUES: stays valid
+ * until the list is modified)
  */
 void* array_list_pop_tail(array_list* lst);
 
+/**
+ * Append values to array list
+ * Grows the array at most once
+ *
+ * @param lst Array list
+ * @param values Values to append (an array of pointers for ARRAY_LIST_POINTERS,
+ * of values for ARRAY_LIST_VALUES)
+ * @param count Number of values
+ * @return 0 on success, -1 on failure (nothing is appended)
+ */
+int array_list_push_tail_n(array_list* lst, const void* values, size_t count);
+
+/**
+ * Pop values from head of array list
+ *
+ * @param lst Array list
+ * @param values_out Output for the popped values, laid out like the values of
+ * array_list_push_tail_n (or NULL to drop them)
+ * @param count Maximum number of values to pop
+ * @return Number of values popped (less than count if the list ran out)
+ */
+size_t array_list_pop_head_n(array_list* lst, void* values_out, size_t count);
+
+/**
+ * Get the values of array list as (at most two) runs of consecutive values,
+ * in list order, without copying them
+ * The spans stay valid until the list is modified.
+ *
+ * @param lst Array list
+ * @param spans Output for the spans
+ * @return Number of spans (0 if the list is empty)
+ */
+size_t array_list_get_spans(const array_list* lst, array_list_span spans[2]);
+
+/**
+ * Rearrange array list so that all values are consecutive, starting at slot 0
+ *
+ * @param lst Array list
+ * @return The array, holding the values in list order (or NULL on failure,
+ * or if the list has no array)
+ */
+void* array_list_make_contiguous(array_list* lst);
+
+/**
+ * Sort array list in place (introsort: O(n log n), not stable)
+ *
+ * @param lst Array list
+ * @param cmp Value comparator
+ * @return 0 on success, -1 on failure
+ */
+int array_list_sort(array_list* lst, array_list_cmp_func cmp);
+
+/**
+ * Sort an ARRAY_LIST_VALUES list in place by an unsigned integer key stored
+ * in each value (LSD radix sort: O(n) per key byte, stable)
+ *
+ * @param lst Array list
+ * @param key_offset Offset of the key in each value
+ * @param key_size Size of the key (1, 2, 4 or 8 bytes, in host byte order)
+ * @return 0 on success, -1 on failure
+ */
+int array_list_radix_sort(array_list* lst, size_t key_offset, size_t key_size);
+
+/**
+ * Find the first position of a sorted array list whose value isn't less
+ * than value
+ *
+ * @param lst Array list sorted by cmp
+ * @param value Value to search (passed to cmp as the second value)
+ * @param cmp Value comparator
+ * @return Position (the size of the list if all values are less)
+ */
+size_t array_list_lower_bound(const array_list* lst, const void* value, array_list_cmp_func cmp);
+
+/**
+ * Find index of value in a sorted array list in O(log n)
+ *
+ * @param lst Array list sorted by cmp
+ * @param value Value to search (passed to cmp as the second value)
+ * @param cmp Value comparator
+ * @return Index of the first equal value or -1 if not found
+ */
+size_t array_list_binary_search(const array_list* lst, const void* value, array_list_cmp_func cmp);
+
+/**
+ * Remove consecutive duplicate values (all duplicates, once sorted)
+ *
+ * @param lst Array list
+ * @param cmp Value comparator
+ * @return 0 on success, -1 on failure
+ */
+int array_list_unique(array_list* lst, array_list_cmp_func cmp);
+
+/**
+ * Append all values of two sorted array lists to dst, in order
+ * (values of a before equal values of b)
+ *
+ * @param dst Array list to append to (of the same type as a and b)
+ * @param a First sorted list
+ * @param b Second sorted list
+ * @param cmp Value comparator a and b are sorted by
+ * @return 0 on success, -1 on failure (nothing is appended)
+ */
+int array_list_merge(array_list* dst, const array_list* a, const array_list* b, array_list_cmp_func cmp);
+
+/**
+ * Append the values found in either of two sorted array lists to dst, in
+ * order (values found in both are taken once, from a)
+ *
+ * @param dst Array list to append to (of the same type as a and b)
+ * @param a First sorted list
+ * @param b Second sorted list
+ * @param cmp Value comparator a and b are sorted by
+ * @return 0 on success, -1 on failure (nothing is appended)
+ */
+int array_list_union(array_list* dst, const array_list* a, const array_list* b, array_list_cmp_func cmp);
+
+/**
+ * Append the values found in both of two sorted array lists to dst, in
+ * order (taken from a)
+ *
+ * @param dst Array list to append to (of the same type as a and b)
+ * @param a First sorted list
+ * @param b Second sorted list
+ * @param cmp Value comparator a and b are sorted by
+ * @return 0 on success, -1 on failure (nothing is appended)
+ */
+int array_list_intersection(array_list* dst, const array_list* a, const array_list* b, array_list_cmp_func cmp);
+
 /**
  * Resize array list
  *
  * @param lst Array list
- * @param capacity New capacity
+ * @param capacity New capacity (at least the current size)
  * @return 0 on success, -1 on failure
  */
 int array_list_resize(array_list* lst, size_t capacity);
 
+/**
+ * Make sure the array list can hold capacity values without being resized
+ * Never shrinks the array
+ *
+ * @param lst Array list
+ * @param capacity Minimum capacity
+ * @return 0 on success, -1 on failure
+ */
+int array_list_reserve(array_list* lst, size_t capacity);
+
+/**
+ * Release the capacity beyond the current size
+ *
+ * @param lst Array list
+ * @return 0 on success, -1 on failure
+ */
+int array_list_shrink_to_fit(array_list* lst);
+
+/**
+ * Set the factor the capacity is multiplied by when the array is full
+ * (ARRAY_LIST_GROWTH_FACTOR by default). Larger factors resize less often
+ * but leave more unused capacity.
+ *
+ * @param lst Array list
+ * @param growth_factor Growth factor (greater than 1)
+ * @return 0 on success, -1 on failure
+ */
+int array_list_set_growth_factor(array_list* lst, double growth_factor);
+
 /**
  * Destroy array list
  *
@@ -0,0 +1,589 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "array_list.h"
+
+/**
+ * Runs of at most this many values are sorted by insertion sort
+ */
+#define INSERTION_SORT_SIZE 16
+
+/**
+ * Sort state shared by the introsort helpers
+ */
+typedef struct sort_ctx {
+    /**
+     * First slot of the (contiguous) values
+     */
+    char* base;
+
+    size_t slot_size;
+
+    /**
+     * 1 if slots hold pointers to the values (ARRAY_LIST_POINTERS)
+     */
+    int by_pointer;
+
+    array_list_cmp_func cmp;
+} sort_ctx;
+
+/**
+ * Set operation applied by set_op()
+ */
+typedef enum set_op_type {
+    SET_OP_MERGE,
+    SET_OP_UNION,
+    SET_OP_INTERSECTION
+} set_op_type;
+
+/**
+ * Get the address of the slot holding a position of an array list
+ *
+ * @param lst Array list
+ * @param pos Position (less than the size)
+ * @return Slot address
+ */
+static inline char* slot_at(const array_list* lst, const size_t pos) {
+    size_t index = lst->head + pos;
+    if (index >= lst->capacity) {
+        index -= lst->capacity;
+    }
+
+    return (char *)lst->data + index * lst->slot_size;
+}
+
+/**
+ * Get the value a slot stands for, as passed to comparators
+ *
+ * @param lst Array list
+ * @param p_slot Slot address
+ * @return Value (ARRAY_LIST_POINTERS) or the slot itself (ARRAY_LIST_VALUES)
+ */
+static inline const void* slot_value(const array_list* lst, const char* p_slot) {
+    return lst->type == ARRAY_LIST_POINTERS ? *(void* const*)p_slot : p_slot;
+}
+
+/**
+ * Get the address of a slot being sorted
+ *
+ * @param ctx Sort state
+ * @param i Position
+ * @return Slot address
+ */
+static inline char* at(const sort_ctx* ctx, const size_t i) {
+    return ctx->base + i * ctx->slot_size;
+}
+
+/**
+ * Compare the values held by two slots
+ *
+ * @param ctx Sort state
+ * @param a First slot
+ * @param b Second slot
+ * @return Comparator result
+ */
+static inline int cmp_slots(const sort_ctx* ctx, const char* a, const char* b) {
+    if (ctx->by_pointer) {
+        return ctx->cmp(*(void* const*)a, *(void* const*)b);
+    }
+
+    return ctx->cmp(a, b);
+}
+
+/**
+ * Swap the contents of two slots
+ *
+ * @param ctx Sort state
+ * @param a First slot
+ * @param b Second slot
+ */
+static inline void swap_slots(const sort_ctx* ctx, char* a, char* b) {
+    if (ctx->by_pointer || ctx->slot_size == sizeof(void *)) {
+        void* tmp = *(void**)a;
+        *(void**)a = *(void**)b;
+        *(void**)b = tmp;
+        return;
+    }
+
+    if (ctx->slot_size == sizeof(uint32_t)) {
+        uint32_t tmp;
+        memcpy(&tmp, a, sizeof(tmp));
+        memcpy(a, b, sizeof(tmp));
+        memcpy(b, &tmp, sizeof(tmp));
+        return;
+    }
+
+    char tmp[64];
+    size_t left = ctx->slot_size;
+
+    while (left > 0) {
+        const size_t run = left < sizeof(tmp) ? left : sizeof(tmp);
+
+        memcpy(tmp, a, run);
+        memcpy(a, b, run);
+        memcpy(b, tmp, run);
+        a += run;
+        b += run;
+        left -= run;
+    }
+}
+
+/**
+ * Sort a short run of values
+ *
+ * @param ctx Sort state
+ * @param lo First position to sort
+ * @param n Number of values to sort
+ */
+static void insertion_sort(const sort_ctx* ctx, const size_t lo, const size_t n) {
+    for (size_t i = lo + 1; i < lo + n; ++i) {
+        for (size_t j = i; j > lo && cmp_slots(ctx, at(ctx, j - 1), at(ctx, j)) > 0; --j) {
+            swap_slots(ctx, at(ctx, j - 1), at(ctx, j));
+        }
+    }
+}
+
+/**
+ * Restore the max-heap property below a node of a heap
+ *
+ * @param ctx Sort state
+ * @param lo Position of the heap root
+ * @param n Number of values in the heap
+ * @param root Node to sift down (relative to lo)
+ */
+static void sift_down(const sort_ctx* ctx, const size_t lo, const size_t n, size_t root) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) {
+            return;
+        }
+
+        if (child + 1 < n && cmp_slots(ctx, at(ctx, lo + child), at(ctx, lo + child + 1)) < 0) {
+            ++child;
+        }
+
+        if (cmp_slots(ctx, at(ctx, lo + root), at(ctx, lo + child)) >= 0) {
+            return;
+        }
+
+        swap_slots(ctx, at(ctx, lo + root), at(ctx, lo + child));
+        root = child;
+    }
+}
+
+/**
+ * Sort values in O(n log n) regardless of their order
+ *
+ * @param ctx Sort state
+ * @param lo First position to sort
+ * @param n Number of values to sort
+ */
+static void heap_sort(const sort_ctx* ctx, const size_t lo, const size_t n) {
+    for (size_t i = n / 2; i > 0; --i) {
+        sift_down(ctx, lo, n, i - 1);
+    }
+
+    for (size_t end = n - 1; end > 0; --end) {
+        swap_slots(ctx, at(ctx, lo), at(ctx, lo + end));
+        sift_down(ctx, lo, end, 0);
+    }
+}
+
+/**
+ * Quicksort that falls back to heap sort past a recursion depth (so that it
+ * stays O(n log n) on adversarial input) and to insertion sort on short runs
+ *
+ * @param ctx Sort state
+ * @param lo First position to sort
+ * @param n Number of values to sort
+ * @param depth Partitioning rounds left before falling back to heap sort
+ */
+static void intro_sort(const sort_ctx* ctx, size_t lo, size_t n, size_t depth) {
+    while (n > INSERTION_SORT_SIZE) {
+        if (depth-- == 0) {
+            heap_sort(ctx, lo, n);
+            return;
+        }
+
+        // Median of three as the pivot, moved to lo (the last value then
+        // stops the left-to-right scan)
+        const size_t mid = lo + n / 2;
+        const size_t hi = lo + n - 1;
+
+        if (cmp_slots(ctx, at(ctx, mid), at(ctx, lo)) < 0) {
+            swap_slots(ctx, at(ctx, mid), at(ctx, lo));
+        }
+        if (cmp_slots(ctx, at(ctx, hi), at(ctx, mid)) < 0) {
+            swap_slots(ctx, at(ctx, hi), at(ctx, mid));
+            if (cmp_slots(ctx, at(ctx, mid), at(ctx, lo)) < 0) {
+                swap_slots(ctx, at(ctx, mid), at(ctx, lo));
+            }
+        }
+        swap_slots(ctx, at(ctx, lo), at(ctx, mid));
+
+        // Hoare partition: both scans stop on values equal to the pivot, so
+        // runs of equal values are split evenly
+        const char* pivot = at(ctx, lo);
+        size_t i = lo;
+        size_t j = hi + 1;
+
+        for (;;) {
+            do {
+                ++i;
+            } while (cmp_slots(ctx, at(ctx, i), pivot) < 0);
+
+            do {
+                --j;
+            } while (cmp_slots(ctx, pivot, at(ctx, j)) < 0);
+
+            if (i >= j) {
+                break;
+            }
+
+            swap_slots(ctx, at(ctx, i), at(ctx, j));
+        }
+
+        swap_slots(ctx, at(ctx, lo), at(ctx, j));
+
+        // Recurse into the smaller side, loop on the larger one
+        const size_t left_n = j - lo;
+        const size_t right_n = lo + n - j - 1;
+
+        if (left_n < right_n) {
+            intro_sort(ctx, lo, left_n, depth);
+            lo = j + 1;
+            n = right_n;
+        }
+        else {
+            intro_sort(ctx, j + 1, right_n, depth);
+            n = left_n;
+        }
+    }
+
+    insertion_sort(ctx, lo, n);
+}
+
+int array_list_sort(array_list* lst, const array_list_cmp_func cmp) {
+    if (lst->size < 2) {
+        return 0;
+    }
+
+    sort_ctx ctx;
+    ctx.base = array_list_make_contiguous(lst);
+    if (ctx.base == NULL) {
+        return -1;
+    }
+    ctx.slot_size = lst->slot_size;
+    ctx.by_pointer = lst->type == ARRAY_LIST_POINTERS;
+    ctx.cmp = cmp;
+
+    size_t depth = 0;
+    for (size_t n = lst->size; n > 1; n >>= 1) {
+        depth += 2;
+    }
+
+    intro_sort(&ctx, 0, lst->size, depth);
+
+    return 0;
+}
+
+/**
+ * Read an unsigned integer key
+ *
+ * @param p_key Key address
+ * @param key_size Key size (1, 2, 4 or 8 bytes)
+ * @return Key
+ */
+static inline uint64_t read_key(const char* p_key, const size_t key_size) {
+    switch (key_size) {
+        case 1: {
+            return *(const uint8_t *)p_key;
+        }
+        case 2: {
+            uint16_t key;
+            memcpy(&key, p_key, sizeof(key));
+            return key;
+        }
+        case 4: {
+            uint32_t key;
+            memcpy(&key, p_key, sizeof(key));
+            return key;
+        }
+        default: {
+            uint64_t key;
+            memcpy(&key, p_key, sizeof(key));
+            return key;
+        }
+    }
+}
+
+int array_list_radix_sort(array_list* lst, const size_t key_offset, const size_t key_size) {
+    if (lst->type != ARRAY_LIST_VALUES) {
+        fprintf(stderr, "array_list_radix_sort: list doesn't store values inline\n");
+        return -1;
+    }
+
+    if (key_size != 1 && key_size != 2 && key_size != 4 && key_size != 8) {
+        fprintf(stderr, "array_list_radix_sort: key size %zu isn't 1, 2, 4 or 8\n", key_size);
+        return -1;
+    }
+
+    if (key_offset > lst->slot_size || key_size > lst->slot_size - key_offset) {
+        fprintf(stderr, "array_list_radix_sort: key doesn't fit in a %zu byte value\n", lst->slot_size);
+        return -1;
+    }
+
+    if (lst->size < 2) {
+        return 0;
+    }
+
+    char* src = array_list_make_contiguous(lst);
+    if (src == NULL) {
+        return -1;
+    }
+
+    char* buffer = malloc(lst->size * lst->slot_size);
+    if (buffer == NULL) {
+        perror("array_list_radix_sort: malloc() failed");
+        return -1;
+    }
+
+    // Count every byte of the keys in a single pass
+    size_t (*counts)[256] = calloc(key_size, sizeof(*counts));
+    if (counts == NULL) {
+        perror("array_list_radix_sort: calloc() failed");
+        free(buffer);
+        return -1;
+    }
+
+    const size_t size = lst->size;
+    const size_t slot_size = lst->slot_size;
+
+    for (size_t i = 0; i < size; ++i) {
+        const uint64_t key = read_key(&src[i * slot_size + key_offset], key_size);
+
+        for (size_t byte = 0; byte < key_size; ++byte) {
+            ++counts[byte][(key >> (8 * byte)) & 0xFF];
+        }
+    }
+
+    // Stable scatter by each byte, least significant first
+    char* dst = buffer;
+
+    for (size_t byte = 0; byte < key_size; ++byte) {
+        size_t offsets[256];
+        size_t offset = 0;
+        int skip = 0;
+
+        for (size_t digit = 0; digit < 256; ++digit) {
+            if (counts[byte][digit] == size) {
+                // All keys share this byte
+                skip = 1;
+                break;
+            }
+
+            offsets[digit] = offset;
+            offset += counts[byte][digit];
+        }
+
+        if (skip) {
+            continue;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            const uint64_t key = read_key(&src[i * slot_size + key_offset], key_size);
+            const size_t digit = (key >> (8 * byte)) & 0xFF;
+
+            memcpy(&dst[offsets[digit]++ * slot_size], &src[i * slot_size], slot_size);
+        }
+
+        char* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src == buffer) {
+        memcpy(lst->data, buffer, size * slot_size);
+    }
+
+    free(counts);
+    free(buffer);
+
+    return 0;
+}
+
+size_t array_list_lower_bound(const array_list* lst, const void* value, const array_list_cmp_func cmp) {
+    if (lst->size == 0) {
+        return 0;
+    }
+
+    // Branchless: the range always halves, so both slots the next step may
+    // probe are known in advance and can be prefetched while comparing
+    size_t base = 0;
+    size_t n = lst->size;
+
+    while (n > 1) {
+        const size_t half = n / 2;
+
+        __builtin_prefetch(slot_at(lst, base + half / 2));
+        __builtin_prefetch(slot_at(lst, base + half + half / 2));
+
+        base = cmp(slot_value(lst, slot_at(lst, base + half)), value) < 0 ? base + half : base;
+        n -= half;
+    }
+
+    return base + (cmp(slot_value(lst, slot_at(lst, base)), value) < 0);
+}
+
+size_t array_list_binary_search(const array_list* lst, const void* value, const array_list_cmp_func cmp) {
+    const size_t pos = array_list_lower_bound(lst, value, cmp);
+
+    if (pos < lst->size && cmp(slot_value(lst, slot_at(lst, pos)), value) == 0) {
+        return pos;
+    }
+
+    return -1;
+}
+
+int array_list_unique(array_list* lst, const array_list_cmp_func cmp) {
+    if (lst->size < 2) {
+        return 0;
+    }
+
+    char* base = array_list_make_contiguous(lst);
+    if (base == NULL) {
+        return -1;
+    }
+
+    const size_t slot_size = lst->slot_size;
+    size_t kept = 1;
+
+    for (size_t i = 1; i < lst->size; ++i) {
+        const char* p_last = &base[(kept - 1) * slot_size];
+        const char* p_slot = &base[i * slot_size];
+
+        if (cmp(slot_value(lst, p_last), slot_value(lst, p_slot)) != 0) {
+            if (kept != i) {
+                memcpy(&base[kept * slot_size], p_slot, slot_size);
+            }
+            ++kept;
+        }
+    }
+
+    lst->size = kept;
+
+    return 0;
+}
+
+/**
+ * Append one value of a list to another
+ * (dst must have room for it)
+ *
+ * @param dst Array list to append to
+ * @param p_slot Slot holding the value
+ */
+static inline void append_slot(array_list* dst, const char* p_slot) {
+    memcpy(array_list_emplace_tail(dst), p_slot, dst->slot_size);
+}
+
+/**
+ * Apply a set operation to two sorted lists
+ *
+ * @param func Name of the calling function (for error messages)
+ * @param dst Array list to append the result to
+ * @param a First sorted list
+ * @param b Second sorted list
+ * @param cmp Comparator the lists are sorted by
+ * @param type Set operation
+ * @return 0 on success, -1 on failure
+ */
+static int set_op(
+    const char* func,
+    array_list* dst,
+    const array_list* a,
+    const array_list* b,
+    const array_list_cmp_func cmp,
+    const set_op_type type
+) {
+    if (dst == a || dst == b) {
+        fprintf(stderr, "%s: destination can't be an input list\n", func);
+        return -1;
+    }
+
+    if (a->type != dst->type || b->type != dst->type
+        || a->slot_size != dst->slot_size || b->slot_size != dst->slot_size) {
+        fprintf(stderr, "%s: lists don't store the same kind of values\n", func);
+        return -1;
+    }
+
+    // Reserve up front so that appending can't fail halfway
+    const size_t max_count = type == SET_OP_INTERSECTION
+        ? (a->size < b->size ? a->size : b->size)
+        : a->size + b->size;
+
+    if (array_list_reserve(dst, dst->size + max_count) != 0) {
+        return -1;
+    }
+
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < a->size && j < b->size) {
+        const char* p_a = slot_at(a, i);
+        const char* p_b = slot_at(b, j);
+        const int order = cmp(slot_value(a, p_a), slot_value(b, p_b));
+
+        if (order < 0) {
+            if (type != SET_OP_INTERSECTION) {
+                append_slot(dst, p_a);
+            }
+            ++i;
+        }
+        else if (order > 0) {
+            if (type != SET_OP_INTERSECTION) {
+                append_slot(dst, p_b);
+            }
+            ++j;
+        }
+        else if (type == SET_OP_MERGE) {
+            // Stable: values of a come first
+            append_slot(dst, p_a);
+            ++i;
+        }
+        else {
+            append_slot(dst, p_a);
+            ++i;
+            ++j;
+        }
+    }
+
+    if (type != SET_OP_INTERSECTION) {
+        for (; i < a->size; ++i) {
+            append_slot(dst, slot_at(a, i));
+        }
+        for (; j < b->size; ++j) {
+            append_slot(dst, slot_at(b, j));
+        }
+    }
+
+    return 0;
+}
+
+int array_list_merge(array_list* dst, const array_list* a, const array_list* b, const array_list_cmp_func cmp) {
+    return set_op("array_list_merge", dst, a, b, cmp, SET_OP_MERGE);
+}
+
+int array_list_union(array_list* dst, const array_list* a, const array_list* b, const array_list_cmp_func cmp) {
+    return set_op("array_list_union", dst, a, b, cmp, SET_OP_UNION);
+}
+
+int array_list_intersection(
+    array_list* dst,
+    const array_list* a,
+    const array_list* b,
+    const array_list_cmp_func cmp
+) {
+    return set_op("array_list_intersection", dst, a, b, cmp, SET_OP_INTERSECTION);
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bloom_filter.h"
+#include "murmur3.h"
+
+/**
+ * Size of a block (a cache line)
+ */
+#define BLOCK_SIZE (BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t))
+
+/**
+ * Odd multipliers deriving the bit set in each word of a block from the hash
+ * (as in the split block Bloom filters of Parquet)
+ */
+static const uint32_t salts[BLOOM_FILTER_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+/**
+ * Get the block for a hash
+ * Uses the high bits of the hash (multiply-shift rather than modulo)
+ *
+ * @param filter Filter
+ * @param hash Hash of key
+ * @return Block
+ */
+static uint64_t* block_for(const bloom_filter* filter, const uint32_t hash) {
+    const size_t block = (size_t)(((uint64_t)hash * filter->block_count) >> 32);
+
+    return filter->blocks + block * BLOOM_FILTER_BLOCK_WORDS;
+}
+
+/**
+ * Get the bit of a word of a block for a hash
+ *
+ * @param hash Hash of key
+ * @param word Word of block
+ * @return Bit mask
+ */
+static uint64_t word_bit(const uint32_t hash, const size_t word) {
+    return (uint64_t)1 << ((hash * salts[word]) >> 26);
+}
+
+int bloom_filter_init(bloom_filter* filter, const size_t key_count, const uint32_t bits_per_key) {
+    if (bits_per_key == 0) {
+        fprintf(stderr, "bloom_filter_init: bits per key must not be 0\n");
+        return -1;
+    }
+
+    size_t block_count = (key_count * bits_per_key + BLOCK_SIZE * 8 - 1) / (BLOCK_SIZE * 8);
+    if (block_count == 0) {
+        block_count = 1;
+    }
+
+    if (block_count > UINT32_MAX) {
+        fprintf(stderr, "bloom_filter_init: %zu keys is too many\n", key_count);
+        return -1;
+    }
+
+    filter->blocks = aligned_alloc(BLOCK_SIZE, block_count * BLOCK_SIZE);
+    if (filter->blocks == NULL) {
+        perror("bloom_filter_init: aligned_alloc() failed");
+        return -1;
+    }
+
+    filter->block_count = block_count;
+    bloom_filter_clear(filter);
+
+    return 0;
+}
+
+void bloom_filter_add(bloom_filter* filter, const uint32_t hash) {
+    uint64_t* p_block = block_for(filter, hash);
+
+    for (size_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; ++i) {
+        p_block[i] |= word_bit(hash, i);
+    }
+}
+
+int bloom_filter_contains(const bloom_filter* filter, const uint32_t hash) {
+    const uint64_t* p_block = block_for(filter, hash);
+    uint64_t missing = 0;
+
+    // No early exit: the block is one cache line, and this compiles branchless
+    for (size_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; ++i) {
+        missing |= ~p_block[i] & word_bit(hash, i);
+    }
+
+    return missing == 0;
+}
+
+void bloom_filter_prefetch(const bloom_filter* filter, const uint32_t hash) {
+    __builtin_prefetch(block_for(filter, hash));
+}
+
+void bloom_filter_add_bytes(bloom_filter* filter, const void* key, const size_t len) {
+    bloom_filter_add(filter, murmur3(key, len, 0));
+}
+
+int bloom_filter_contains_bytes(const bloom_filter* filter, const void* key, const size_t len) {
+    return bloom_filter_contains(filter, murmur3(key, len, 0));
+}
+
+void bloom_filter_clear(bloom_filter* filter) {
+    memset(filter->blocks, 0, filter->block_count * BLOCK_SIZE);
+}
+
+void bloom_filter_destroy(bloom_filter* filter) {
+    free(filter->blocks);
+    filter->blocks = NULL;
+    filter->block_count = 0;
+}
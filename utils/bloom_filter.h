@@ -0,0 +1,111 @@
+#ifndef __BLOOM_FILTER_H__
+#define __BLOOM_FILTER_H__
+
+/**
+ * Blocked Bloom filter
+ *
+ * Answers "definitely not added" or "maybe added" for 32-bit key hashes.
+ * Each key maps to a single 64-byte block (one cache line), and sets one bit
+ * in each of the block's 8 words, so that adding or checking a key touches
+ * one cache line only. With 10 bits per key, about 1% of the keys that were
+ * never added are reported as maybe added.
+ *
+ * The filter works on hashes rather than keys, so that a hash computed for a
+ * lookup (murmur3(), hash_table_hash_key(), ...) is reused. Keys can't be
+ * removed: clear the filter and add the remaining keys again instead.
+ *
+ * Not thread-safe.
+ */
+
+#include <inttypes.h>
+#include <stddef.h>
+
+/**
+ * Number of 64-bit words per block (one cache line)
+ */
+#define BLOOM_FILTER_BLOCK_WORDS 8
+
+/**
+ * Blocked Bloom filter
+ */
+typedef struct bloom_filter {
+    /**
+     * Blocks of BLOOM_FILTER_BLOCK_WORDS words, aligned to a cache line
+     */
+    uint64_t* blocks;
+
+    /**
+     * Number of blocks
+     */
+    size_t block_count;
+} bloom_filter;
+
+/**
+ * Initialize Bloom filter
+ *
+ * @param filter Filter
+ * @param key_count Expected number of keys
+ * @param bits_per_key Bits of filter per expected key (at least 1, 10 for ~1% false positives)
+ * @return 0 on success, -1 on failure
+ */
+int bloom_filter_init(bloom_filter* filter, size_t key_count, uint32_t bits_per_key);
+
+/**
+ * Add a key hash to filter
+ *
+ * @param filter Filter
+ * @param hash Hash of key
+ */
+void bloom_filter_add(bloom_filter* filter, uint32_t hash);
+
+/**
+ * Check if a key hash may have been added to filter
+ *
+ * @param filter Filter
+ * @param hash Hash of key
+ * @return 1 if it may have been added, 0 if it definitely wasn't
+ */
+int bloom_filter_contains(const bloom_filter* filter, uint32_t hash);
+
+/**
+ * Prefetch the block of filter for a key hash
+ *
+ * @param filter Filter
+ * @param hash Hash of key
+ */
+void bloom_filter_prefetch(const bloom_filter* filter, uint32_t hash);
+
+/**
+ * Add a key to filter, hashing it with murmur3()
+ *
+ * @param filter Filter
+ * @param key Key
+ * @param len Length of key
+ */
+void bloom_filter_add_bytes(bloom_filter* filter, const void* key, size_t len);
+
+/**
+ * Check if a key may have been added to filter, hashing it with murmur3()
+ *
+ * @param filter Filter
+ * @param key Key
+ * @param len Length of key
+ * @return 1 if it may have been added, 0 if it definitely wasn't
+ */
+int bloom_filter_contains_bytes(const bloom_filter* filter, const void* key, size_t len);
+
+/**
+ * Remove all keys from filter
+ *
+ * @param filter Filter
+ */
+void bloom_filter_clear(bloom_filter* filter);
+
+/**
+ * Destroy filter
+ *
+ * @param filter Filter
+ */
+void bloom_filter_destroy(bloom_filter* filter);
+
+#endif
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "concurrent_hash_table.h"
+#include "hash_table_internal.h"
+
+/**
+ * Number of shards per online CPU when no shard count is given
+ */
+#define SHARDS_PER_CPU 4
+
+/**
+ * Hash a key, the way the hash table of every shard does
+ *
+ * @param cht Concurrent hash table
+ * @param key Key
+ * @return Full hash of key
+ */
+static uint32_t hash_key(const concurrent_hash_table* cht, const void* key) {
+    // All shards hash keys the same way
+    return hash_table_hash_key(&cht->shards[0].table, key);
+}
+
+/**
+ * Get the shard holding a key
+ * The hash is remixed before picking a shard, so that the bits the shard's
+ * own hash table indexes with stay evenly spread within every shard
+ *
+ * @param cht Concurrent hash table
+ * @param hash Full hash of key (passed on to the shard, so keys are hashed once)
+ * @return Shard
+ */
+static concurrent_hash_table_shard* find_shard(const concurrent_hash_table* cht, const uint32_t hash) {
+    const uint32_t mixed = hash * 0x9E3779B9U;
+
+    // Map the (remixed) hash onto [0, shard_count) with a multiply instead of a modulo
+    return &cht->shards[((uint64_t)mixed * cht->shard_count) >> 32];
+}
+
+/**
+ * Initialize the hash table of a shard
+ *
+ * @param shard Shard
+ * @param size Index size
+ * @param type Storage backend
+ * @param key_cmp Key comparator (or NULL to use default)
+ * @param key_hash Key hash function (or NULL to use default)
+ * @return 0 on success, -1 on failure
+ */
+static int init_shard_table(
+    concurrent_hash_table_shard* shard,
+    const uint32_t size,
+    const hash_table_type type,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    if (type == HASH_TABLE_OPEN) {
+        return hash_table_init_open(&shard->table, size, key_cmp, key_hash);
+    }
+
+    if (type == HASH_TABLE_COMPACT) {
+        return hash_table_init_compact(&shard->table, size, key_cmp, key_hash);
+    }
+
+    if (type == HASH_TABLE_CHAINED) {
+        return hash_table_init(&shard->table, size, key_cmp, key_hash);
+    }
+
+    fprintf(stderr, "cht_init: unsupported shard type %d\n", (int)type);
+    return -1;
+}
+
+int concurrent_hash_table_init(
+    concurrent_hash_table* cht,
+    size_t shard_count,
+    const uint32_t size,
+    const hash_table_type type,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    memset(cht, 0, sizeof(concurrent_hash_table));
+
+    if (shard_count == 0) {
+        const long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        shard_count = (cpu_count > 0 ? cpu_count : 1) * SHARDS_PER_CPU;
+    }
+
+    cht->shards = aligned_alloc(
+        _Alignof(concurrent_hash_table_shard),
+        shard_count * sizeof(concurrent_hash_table_shard)
+    );
+    if (cht->shards == NULL) {
+        perror("cht_init: aligned_alloc() failed");
+        return -1;
+    }
+
+    for (size_t i = 0; i < shard_count; ++i) {
+        concurrent_hash_table_shard* shard = &cht->shards[i];
+
+        if (init_shard_table(shard, size, type, key_cmp, key_hash) != 0) {
+            cht->shard_count = i;
+            concurrent_hash_table_destroy(cht);
+            return -1;
+        }
+
+        if (pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            perror("cht_init: pthread_rwlock_init() failed");
+            hash_table_destroy(&shard->table);
+            cht->shard_count = i;
+            concurrent_hash_table_destroy(cht);
+            return -1;
+        }
+    }
+
+    cht->shard_count = shard_count;
+
+    return 0;
+}
+
+int concurrent_hash_table_set(concurrent_hash_table* cht, void* key, void* value) {
+    if (cht->shards == NULL) {
+        fprintf(stderr, "cht_set: hash table not initialized\n");
+        return -1;
+    }
+
+    const uint32_t hash = hash_key(cht, key);
+    concurrent_hash_table_shard* shard = find_shard(cht, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    const int ret = hash_table_set_hashed(&shard->table, key, value, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return ret;
+}
+
+void* concurrent_hash_table_get(concurrent_hash_table* cht, const void* key) {
+    if (cht->shards == NULL) {
+        fprintf(stderr, "cht_get: hash table not initialized\n");
+        return NULL;
+    }
+
+    const uint32_t hash = hash_key(cht, key);
+    concurrent_hash_table_shard* shard = find_shard(cht, hash);
+
+    // Lookups don't migrate entries of an in-progress rehash, so readers can share the lock
+    pthread_rwlock_rdlock(&shard->lock);
+    void* value = hash_table_lookup_hashed(&shard->table, key, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return value;
+}
+
+void* concurrent_hash_table_compute_if_absent(
+    concurrent_hash_table* cht,
+    void* key,
+    const concurrent_hash_table_compute_func compute_func,
+    void* user_arg
+) {
+    if (cht->shards == NULL) {
+        fprintf(stderr, "cht_compute_if_absent: hash table not initialized\n");
+        return NULL;
+    }
+
+    const uint32_t hash = hash_key(cht, key);
+    concurrent_hash_table_shard* shard = find_shard(cht, hash);
+
+    // Most calls find the key, so try without excluding other readers first
+    pthread_rwlock_rdlock(&shard->lock);
+    void* value = hash_table_lookup_hashed(&shard->table, key, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    if (value != NULL) {
+        return value;
+    }
+
+    pthread_rwlock_wrlock(&shard->lock);
+
+    // Another thread may have stored the key in between
+    value = hash_table_lookup_hashed(&shard->table, key, hash);
+    if (value == NULL) {
+        value = compute_func(key, user_arg);
+        if (value != NULL && hash_table_set_hashed(&shard->table, key, value, hash) != 0) {
+            value = NULL;
+        }
+    }
+
+    pthread_rwlock_unlock(&shard->lock);
+
+    return value;
+}
+
+int concurrent_hash_table_del(concurrent_hash_table* cht, const void* key) {
+    if (cht->shards == NULL) {
+        fprintf(stderr, "cht_del: hash table not initialized\n");
+        return -1;
+    }
+
+    const uint32_t hash = hash_key(cht, key);
+    concurrent_hash_table_shard* shard = find_shard(cht, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    const int ret = hash_table_del_hashed(&shard->table, key, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return ret;
+}
+
+size_t concurrent_hash_table_size(concurrent_hash_table* cht) {
+    size_t size = 0;
+
+    for (size_t i = 0; i < cht->shard_count; ++i) {
+        concurrent_hash_table_shard* shard = &cht->shards[i];
+
+        pthread_rwlock_rdlock(&shard->lock);
+        size += hash_table_size(&shard->table);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    return size;
+}
+
+int concurrent_hash_table_destroy(concurrent_hash_table* cht) {
+    if (cht->shards == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < cht->shard_count; ++i) {
+        hash_table_destroy(&cht->shards[i].table);
+        pthread_rwlock_destroy(&cht->shards[i].lock);
+    }
+
+    free(cht->shards);
+    cht->shards = NULL;
+    cht->shard_count = 0;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+#ifndef __CONCURRENT_HASH_TABLE_H__
+#define __CONCURRENT_HASH_TABLE_H__
+
+/**
+ * Hash table that can be shared between threads
+ *
+ * Entries are spread over a number of shards, each one a regular hash_table
+ * guarded by its own reader-writer lock. The shard of a key is picked from
+ * its hash, so threads working on different keys rarely wait on each other,
+ * and any number of threads may read the same shard at once.
+ *
+ * Like hash_table, keys and values are stored as pointers: the caller keeps
+ * ownership of them, and they must stay valid while they are in the table.
+ */
+
+#include <pthread.h>
+
+#include "hash_table.h"
+
+/**
+ * Size of a cache line
+ */
+#define CONCURRENT_HASH_TABLE_CACHE_LINE 64
+
+/**
+ * Shard of a concurrent hash table
+ * Aligned to its own cache lines, so that taking the lock of one shard
+ * doesn't slow down threads using its neighbours
+ */
+typedef struct concurrent_hash_table_shard {
+    /**
+     * Guards table
+     */
+    _Alignas(CONCURRENT_HASH_TABLE_CACHE_LINE) pthread_rwlock_t lock;
+
+    /**
+     * Entries whose keys hash to this shard
+     */
+    hash_table table;
+} concurrent_hash_table_shard;
+
+/**
+ * Concurrent hash table
+ */
+typedef struct concurrent_hash_table {
+    /**
+     * Number of shards
+     */
+    size_t shard_count;
+
+    /**
+     * Shards
+     */
+    concurrent_hash_table_shard* shards;
+} concurrent_hash_table;
+
+/**
+ * Value factory for concurrent_hash_table_compute_if_absent()
+ * Called with the lock of the key's shard held for writing, so it must not
+ * access the same concurrent hash table
+ *
+ * @param key Key that is missing from the table
+ * @param user_arg Optional user arg
+ * @return Value to store (or NULL to leave the key absent)
+ */
+typedef void* (*concurrent_hash_table_compute_func)(const void* key, void* user_arg);
+
+/**
+ * Initialize concurrent hash table
+ *
+ * @param cht Concurrent hash table
+ * @param shard_count Number of shards (0 for one per online CPU, times 4)
+ * @param size Initial index size of each shard (rounded up to a power of 2)
+ * @param type Storage backend of shards (HASH_TABLE_CHAINED, HASH_TABLE_OPEN or
+ *             HASH_TABLE_COMPACT: shards are already locked, so HASH_TABLE_RCU
+ *             is rejected)
+ * @param key_cmp Key comparator (or NULL to use default)
+ * @param key_hash Key hash function (or NULL to use default)
+ * @return 0 on success, -1 on failure
+ */
+int concurrent_hash_table_init(
+    concurrent_hash_table* cht,
+    size_t shard_count,
+    uint32_t size,
+    hash_table_type type,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Set value in concurrent hash table
+ *
+ * @param cht Concurrent hash table
+ * @param key Pointer to key
+ * @param value Pointer to value
+ * @return 0 on success, -1 on failure
+ */
+int concurrent_hash_table_set(concurrent_hash_table* cht, void* key, void* value);
+
+/**
+ * Get value from concurrent hash table
+ * Only takes the lock of the key's shard for reading
+ *
+ * @param cht Concurrent hash table
+ * @param key Entry key to get value for
+ * @return Value pointer (or NULL if not found)
+ */
+void* concurrent_hash_table_get(concurrent_hash_table* cht, const void* key);
+
+/**
+ * Get value from concurrent hash table, or atomically compute and store it
+ * if the key is absent
+ * compute_func is called at most once per missing key, even if several
+ * threads ask for the same key at the same time
+ *
+ * @param cht Concurrent hash table
+ * @param key Pointer to key (stored if the value is computed)
+ * @param compute_func Value factory
+ * @param user_arg Optional argument to pass to compute_func
+ * @return Existing or computed value (or NULL if compute_func returned NULL,
+ *         or on failure)
+ */
+void* concurrent_hash_table_compute_if_absent(
+    concurrent_hash_table* cht,
+    void* key,
+    concurrent_hash_table_compute_func compute_func,
+    void* user_arg
+);
+
+/**
+ * Delete entry from concurrent hash table
+ *
+ * @param cht Concurrent hash table
+ * @param key Entry key to delete
+ * @return 0 on success, -1 on failure
+ */
+int concurrent_hash_table_del(concurrent_hash_table* cht, const void* key);
+
+/**
+ * Get number of entries in concurrent hash table
+ * Shards are counted one at a time, so the result may be stale if other
+ * threads are modifying the table
+ *
+ * @param cht Concurrent hash table
+ * @return Number of entries
+ */
+size_t concurrent_hash_table_size(concurrent_hash_table* cht);
+
+/**
+ * Destroy concurrent hash table
+ * No other thread may be using the table
+ *
+ * @param cht Concurrent hash table
+ * @return 0 on success, -1 on failure
+ */
+int concurrent_hash_table_destroy(concurrent_hash_table* cht);
+
+#endif
@@ -0,0 +1,120 @@
+#include <stdio.h>
+
+#include "entry_index.h"
+
+/**
+ * Pass the key and value of a dropped entry to the release function
+ *
+ * @param index Index
+ * @param key Key (or NULL if still in use)
+ * @param value Value (or NULL if still in use)
+ */
+static void release(const entry_index* index, void* key, void* value) {
+    if (index->release_func != NULL && (key != NULL || value != NULL)) {
+        index->release_func(key, value, index->release_func_user_arg);
+    }
+}
+
+/**
+ * Release the key and value of an entry left over at destroy time
+ *
+ * @param entry Table entry (its value is the indexed entry)
+ * @param _index Iteration index (ignored)
+ * @param index Index
+ */
+static void release_iter_func(const hash_table_entry* entry, const size_t _index, void* index) {
+    const entry_index_entry* p_entry = entry->value;
+
+    release(index, p_entry->key, p_entry->value);
+}
+
+int entry_index_init(
+    entry_index* index,
+    const uint32_t size,
+    const size_t entry_size,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    if (hash_table_init_open(&index->table, size, key_cmp, key_hash) != 0) {
+        return -1;
+    }
+
+    if (slab_init(&index->entry_pool, entry_size, 0) != 0) {
+        hash_table_destroy(&index->table);
+        return -1;
+    }
+
+    index->release_func = NULL;
+    index->release_func_user_arg = NULL;
+
+    return 0;
+}
+
+void entry_index_set_release_func(entry_index* index, const entry_index_release_func release_func, void* user_arg) {
+    index->release_func = release_func;
+    index->release_func_user_arg = user_arg;
+}
+
+void* entry_index_get(entry_index* index, const void* key) {
+    return hash_table_get(&index->table, key);
+}
+
+void* entry_index_add(entry_index* index, void* key, void* value) {
+    entry_index_entry* p_entry = slab_alloc(&index->entry_pool);
+    if (p_entry == NULL) {
+        return NULL;
+    }
+
+    p_entry->key = key;
+    p_entry->value = value;
+
+    if (hash_table_set(&index->table, key, p_entry) != 0) {
+        slab_free(&index->entry_pool, p_entry);
+        return NULL;
+    }
+
+    return p_entry;
+}
+
+int entry_index_replace(entry_index* index, void* entry, void* key, void* value) {
+    entry_index_entry* p_entry = entry;
+    void* old_key = p_entry->key;
+    void* old_value = p_entry->value;
+
+    // The table keeps the key pointer it was set with: setting the entry
+    // again swaps it for the new one before the old one may be released
+    if (hash_table_set(&index->table, key, p_entry) != 0) {
+        return -1;
+    }
+
+    p_entry->key = key;
+    p_entry->value = value;
+
+    release(index, old_key != key ? old_key : NULL, old_value != value ? old_value : NULL);
+
+    return 0;
+}
+
+void entry_index_drop(entry_index* index, void* entry) {
+    entry_index_entry* p_entry = entry;
+    void* key = p_entry->key;
+    void* value = p_entry->value;
+
+    // Deleting compares against the stored key, so it goes before the release
+    hash_table_del(&index->table, key);
+    slab_free(&index->entry_pool, p_entry);
+
+    release(index, key, value);
+}
+
+int entry_index_destroy(entry_index* index) {
+    // Iterating only reads the stored key pointers, and destroying the table
+    // doesn't look at the keys of entries it doesn't own: releasing them on
+    // the way is fine
+    hash_table_iter(&index->table, release_iter_func, index);
+
+    const int result = hash_table_destroy(&index->table);
+    slab_destroy(&index->entry_pool);
+
+    return result;
+}
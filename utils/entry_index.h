@@ -0,0 +1,136 @@
+#ifndef __ENTRY_INDEX_H__
+#define __ENTRY_INDEX_H__
+
+/**
+ * Slab-allocated entries indexed by key, shared by lru_cache and ttl_map
+ *
+ * Each entry holds a key and value pointer, followed by whatever its
+ * container links it with (recency list, timer...). An open addressing
+ * hash_table maps keys to entries, and entries are allocated from a slab.
+ *
+ * Keys and values are stored as pointers, as with hash_table_set(). Whenever
+ * an entry is dropped (removed, replaced, or left over at destroy time), its
+ * key and value are passed to the release function if one is set, so that
+ * they can be freed there. When an entry is replaced by one holding the same
+ * key (or value) pointer, that pointer is passed as NULL instead.
+ *
+ * Not thread-safe.
+ */
+
+#include <inttypes.h>
+
+#include "hash_table.h"
+#include "slab.h"
+
+/**
+ * Release function, called with the key and value of each dropped entry
+ *
+ * @param key Key of the entry (or NULL if still in use)
+ * @param value Value of the entry (or NULL if still in use)
+ * @param user_arg User argument given to entry_index_set_release_func()
+ */
+typedef void (*entry_index_release_func)(void* key, void* value, void* user_arg);
+
+/**
+ * Start of every indexed entry
+ */
+typedef struct entry_index_entry {
+    void* key;
+    void* value;
+} entry_index_entry;
+
+/**
+ * Entry index
+ */
+typedef struct entry_index {
+    /**
+     * Key to entry table
+     */
+    hash_table table;
+
+    /**
+     * Entry allocator
+     */
+    slab entry_pool;
+
+    entry_index_release_func release_func;
+    void* release_func_user_arg;
+} entry_index;
+
+/**
+ * Initialize entry index
+ *
+ * @param index Index
+ * @param size Initial size of the table
+ * @param entry_size Size of entries (starting with an entry_index_entry)
+ * @param key_cmp Key comparator (or NULL to use the hash_table default)
+ * @param key_hash Key hash function (or NULL to use the hash_table default)
+ * @return 0 on success, -1 on failure
+ */
+int entry_index_init(
+    entry_index* index,
+    uint32_t size,
+    size_t entry_size,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Set the function called with the key and value of each dropped entry
+ *
+ * @param index Index
+ * @param release_func Release function (or NULL)
+ * @param user_arg Optional argument to pass to the release function
+ */
+void entry_index_set_release_func(entry_index* index, entry_index_release_func release_func, void* user_arg);
+
+/**
+ * Get entry from index
+ *
+ * @param index Index
+ * @param key Key of entry
+ * @return Entry (or NULL if not indexed)
+ */
+void* entry_index_get(entry_index* index, const void* key);
+
+/**
+ * Allocate and index an entry for a key that isn't indexed yet
+ * Its fields past the entry_index_entry are left for the caller to set
+ *
+ * @param index Index
+ * @param key Key (must stay valid while indexed)
+ * @param value Value
+ * @return Entry (or NULL on failure)
+ */
+void* entry_index_add(entry_index* index, void* key, void* value);
+
+/**
+ * Replace the key and value of an indexed entry, with a key equal to its own
+ * Releases the previous key and value, except what the entry still holds
+ *
+ * @param index Index
+ * @param entry Entry
+ * @param key Key (must stay valid while indexed)
+ * @param value Value
+ * @return 0 on success, -1 on failure (the entry is left unchanged)
+ */
+int entry_index_replace(entry_index* index, void* entry, void* key, void* value);
+
+/**
+ * Remove an entry from index, free it and release its key and value
+ * The caller must have unlinked it from anything else first
+ *
+ * @param index Index
+ * @param entry Entry
+ */
+void entry_index_drop(entry_index* index, void* entry);
+
+/**
+ * Destroy index, releasing all entries
+ *
+ * @param index Index
+ * @return 0 on success, -1 on failure
+ */
+int entry_index_destroy(entry_index* index);
+
+#endif
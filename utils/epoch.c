@@ -0,0 +1,286 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+
+/**
+ * Record state bit: thread is inside a read section
+ * The remaining bits hold the epoch the thread entered it in
+ */
+#define EPOCH_ACTIVE 1
+
+/**
+ * Number of pending retired pointers after which epoch_retire() reclaims
+ */
+#define RECLAIM_THRESHOLD 64
+
+/**
+ * Per-thread record of the epoch a reader is in
+ * Records are never freed: a thread's record is reused by a later thread
+ * once it exits
+ */
+typedef struct epoch_record {
+    /**
+     * (epoch << 1) | EPOCH_ACTIVE while in a read section
+     */
+    _Atomic uint64_t state;
+
+    /**
+     * Set while the record is owned by a thread
+     */
+    atomic_int in_use;
+
+    /**
+     * Read section nesting depth (only accessed by the owning thread)
+     */
+    unsigned int depth;
+
+    /**
+     * Next record (records are only ever prepended)
+     */
+    struct epoch_record* next;
+} epoch_record;
+
+/**
+ * Memory waiting to be freed
+ */
+typedef struct epoch_retired {
+    void* ptr;
+    epoch_free_func free_func;
+
+    /**
+     * Global epoch when ptr was retired
+     */
+    uint64_t epoch;
+
+    struct epoch_retired* next;
+} epoch_retired;
+
+/**
+ * Global epoch
+ * Only advances once every thread in a read section has seen its value
+ */
+static _Atomic uint64_t global_epoch = 0;
+
+/**
+ * All thread records
+ */
+static _Atomic(epoch_record*) records = NULL;
+
+/**
+ * Guards the retired list and advancing the global epoch
+ */
+static pthread_mutex_t retired_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Retired pointers, oldest first
+ */
+static epoch_retired* retired_head = NULL;
+static epoch_retired** retired_tail = &retired_head;
+static size_t retired_size = 0;
+
+/**
+ * Releases the record of an exiting thread
+ */
+static pthread_key_t record_key;
+static pthread_once_t record_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Record of the calling thread (or NULL if not registered yet)
+ */
+static _Thread_local epoch_record* thread_record = NULL;
+
+/**
+ * Release the record of an exiting thread, so another thread can reuse it
+ *
+ * @param record Thread record
+ */
+static void release_record(void* record) {
+    epoch_record* p_record = record;
+
+    atomic_store_explicit(&p_record->state, 0, memory_order_release);
+    atomic_store_explicit(&p_record->in_use, 0, memory_order_release);
+}
+
+static void init_record_key(void) {
+    pthread_key_create(&record_key, release_record);
+}
+
+/**
+ * Register the calling thread
+ * Reuses the record of a thread that exited, or allocates a new one
+ *
+ * @return Thread record (or NULL on failure)
+ */
+static epoch_record* acquire_record(void) {
+    epoch_record* p_record;
+
+    pthread_once(&record_key_once, init_record_key);
+
+    for (p_record = atomic_load(&records); p_record != NULL; p_record = p_record->next) {
+        int unused = 0;
+        if (atomic_compare_exchange_strong(&p_record->in_use, &unused, 1)) {
+            break;
+        }
+    }
+
+    if (p_record == NULL) {
+        p_record = calloc(1, sizeof(epoch_record));
+        if (p_record == NULL) {
+            perror("epoch_enter: calloc() failed");
+            return NULL;
+        }
+
+        atomic_store(&p_record->in_use, 1);
+
+        p_record->next = atomic_load(&records);
+        while (!atomic_compare_exchange_weak(&records, &p_record->next, p_record)) {
+        }
+    }
+
+    p_record->depth = 0;
+    pthread_setspecific(record_key, p_record);
+    thread_record = p_record;
+
+    return p_record;
+}
+
+void epoch_enter(void) {
+    epoch_record* p_record = thread_record;
+    if (p_record == NULL && (p_record = acquire_record()) == NULL) {
+        // Without a record, nothing stops reclamation: fail loudly rather than read freed memory
+        abort();
+    }
+
+    if (p_record->depth++ == 0) {
+        const uint64_t epoch = atomic_load(&global_epoch);
+        atomic_store_explicit(&p_record->state, epoch << 1 | EPOCH_ACTIVE, memory_order_relaxed);
+
+        // Publish the epoch before loading any shared pointer
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+}
+
+void epoch_exit(void) {
+    epoch_record* p_record = thread_record;
+
+    if (--p_record->depth == 0) {
+        // Everything read in the section happens before the section ends
+        atomic_store_explicit(&p_record->state, 0, memory_order_release);
+    }
+}
+
+/**
+ * Advance the global epoch if every thread in a read section has seen it
+ * Must be called with retired_lock held
+ *
+ * @return Global epoch
+ */
+static uint64_t try_advance(void) {
+    const uint64_t epoch = atomic_load(&global_epoch);
+
+    atomic_thread_fence(memory_order_seq_cst);
+
+    for (epoch_record* p_record = atomic_load(&records); p_record != NULL; p_record = p_record->next) {
+        const uint64_t state = atomic_load_explicit(&p_record->state, memory_order_acquire);
+        if ((state & EPOCH_ACTIVE) && state >> 1 != epoch) {
+            // A reader may still hold pointers retired two epochs ago
+            return epoch;
+        }
+    }
+
+    atomic_store(&global_epoch, epoch + 1);
+
+    return epoch + 1;
+}
+
+size_t epoch_reclaim(void) {
+    size_t freed = 0;
+
+    pthread_mutex_lock(&retired_lock);
+
+    const uint64_t epoch = try_advance();
+
+    // Readers are at most one epoch behind, so memory retired two epochs ago is unreachable
+    epoch_retired* p_ready = NULL;
+    epoch_retired** p_ready_tail = &p_ready;
+    while (retired_head != NULL && retired_head->epoch + 2 <= epoch) {
+        *p_ready_tail = retired_head;
+        p_ready_tail = &retired_head->next;
+        retired_head = retired_head->next;
+        --retired_size;
+    }
+
+    *p_ready_tail = NULL;
+    if (retired_head == NULL) {
+        retired_tail = &retired_head;
+    }
+
+    pthread_mutex_unlock(&retired_lock);
+
+    while (p_ready != NULL) {
+        epoch_retired* p_next = p_ready->next;
+        p_ready->free_func(p_ready->ptr);
+        free(p_ready);
+        p_ready = p_next;
+        ++freed;
+    }
+
+    return freed;
+}
+
+int epoch_retire(void* ptr, const epoch_free_func free_func) {
+    epoch_retired* p_retired = malloc(sizeof(epoch_retired));
+    if (p_retired == NULL) {
+        perror("epoch_retire: malloc() failed");
+        return -1;
+    }
+
+    p_retired->ptr = ptr;
+    p_retired->free_func = free_func;
+    p_retired->next = NULL;
+
+    // ptr was unlinked before the epoch it's retired in is read
+    atomic_thread_fence(memory_order_seq_cst);
+
+    pthread_mutex_lock(&retired_lock);
+
+    p_retired->epoch = atomic_load(&global_epoch);
+    *retired_tail = p_retired;
+    retired_tail = &p_retired->next;
+
+    const int must_reclaim = ++retired_size >= RECLAIM_THRESHOLD;
+
+    pthread_mutex_unlock(&retired_lock);
+
+    if (must_reclaim) {
+        epoch_reclaim();
+    }
+
+    return 0;
+}
+
+void epoch_barrier(void) {
+    if (thread_record != NULL && thread_record->depth != 0) {
+        fprintf(stderr, "epoch_barrier: called from within a read section\n");
+        return;
+    }
+
+    for (;;) {
+        epoch_reclaim();
+
+        pthread_mutex_lock(&retired_lock);
+        const size_t pending = retired_size;
+        pthread_mutex_unlock(&retired_lock);
+
+        if (pending == 0) {
+            break;
+        }
+
+        sched_yield();
+    }
+}
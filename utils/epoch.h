@@ -0,0 +1,62 @@
+#ifndef __EPOCH_H__
+#define __EPOCH_H__
+
+/**
+ * Epoch-based memory reclamation
+ *
+ * Lets readers traverse shared data without taking any lock, while writers
+ * unlink and retire the memory they replace. Retired memory is only freed
+ * once every thread that was reading when it was retired has left its read
+ * section.
+ *
+ * Readers wrap their accesses in epoch_enter()/epoch_exit(). Both are
+ * wait-free once the thread is registered (by its first epoch_enter()).
+ * Read sections may be nested, but must not block for long: they hold back
+ * the reclamation of all memory retired in the meantime.
+ */
+
+#include <stddef.h>
+
+/**
+ * Function that frees retired memory
+ *
+ * @param ptr Retired pointer
+ */
+typedef void (*epoch_free_func)(void* ptr);
+
+/**
+ * Enter a read section on the calling thread
+ * Memory retired after this call isn't freed until the matching epoch_exit()
+ */
+void epoch_enter(void);
+
+/**
+ * Leave a read section on the calling thread
+ */
+void epoch_exit(void);
+
+/**
+ * Free memory once no reader can still be using it
+ * Must be called after ptr was unlinked from all shared data. Every few calls
+ * also try to reclaim previously retired memory.
+ *
+ * @param ptr Pointer to free
+ * @param free_func Function to free ptr with
+ * @return 0 on success, -1 on failure (ptr was not retired)
+ */
+int epoch_retire(void* ptr, epoch_free_func free_func);
+
+/**
+ * Free the retired memory that no reader can still be using
+ *
+ * @return Number of pointers freed
+ */
+size_t epoch_reclaim(void);
+
+/**
+ * Wait until all memory retired so far has been freed
+ * Must not be called from within a read section
+ */
+void epoch_barrier(void);
+
+#endif
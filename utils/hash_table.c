@@ -1,8 +1,15 @@
+#include <pthread.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "hash_table.h"
+#include "hash_table_compact.h"
+#include "hash_table_internal.h"
+#include "hash_table_open.h"
+#include "hash_table_rcu.h"
 #include "murmur3.h"
+#include "wyhash.h"
 
 /**
  * Array builder iterator user_arg
@@ -14,18 +21,48 @@ struct hash_table_array_builder_arg {
      * Array to store items in
      */
     void** items;
+
+    /**
+     * Size of items array (items past it are counted, not stored)
+     */
+    size_t max_count;
 };
 
 /**
- * Get hash table index pointer for given key
- * Hashes the key then computes its index offset
+ * Number of buckets migrated by every set/get/del during an incremental rehash
+ */
+#define REHASH_STEP_BUCKETS 16
+
+/**
+ * Number of keys hashed and prefetched together by hash_table_get_many() and
+ * hash_table_set_many()
+ */
+#define BATCH_SIZE 16
+
+/**
+ * Get hash table index offset for a key hash
  *
- * @param ht Hash table
- * @param key Key to compute index for
+ * @param hash Full hash of key
+ * @param index_size Size of the index to compute offset into (power of 2)
  * @return Computed index
  */
-static size_t find_index(const hash_table* ht, const void* key) {
-    return (*ht->key_hash)(key, ht->index_size) % (ht->index_size - 1);
+static size_t find_index(const uint32_t hash, const size_t index_size) {
+    return hash & (index_size - 1);
+}
+
+/**
+ * Round an index size up to a power of 2
+ *
+ * @param size Requested index size
+ * @return Index size
+ */
+static size_t round_index_size(const size_t size) {
+    size_t index_size = 1;
+    while (index_size < size) {
+        index_size <<= 1;
+    }
+
+    return index_size;
 }
 
 /**
@@ -40,19 +77,31 @@ static int default_key_cmp(const void* key_a, const void* key_b) {
 }
 
 /**
- * Default hashing function (murmur3)
- *
- * @param key Key to hash
- * @param ht_size Size of hash table index
- * @return Hash value
+ * Seed for the string hashing functions
+ * Picked when the first hash table is initialized, so threads sharing a
+ * table never race on it
  */
-static uint32_t default_key_hash(const void* key, size_t ht_size) {
-    static uint32_t hash_seed = -1;
-    if (hash_seed == -1) {
-        hash_seed = rand();
-    }
+static uint32_t hash_seed;
+
+static pthread_once_t hash_seed_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Pick the seed for the string hashing functions (once per process)
+ */
+static void init_hash_seed(void) {
+    hash_seed = rand();
+}
 
-    return murmur3(key, strlen(key), hash_seed) % (ht_size - 1);
+uint32_t hash_table_str_hash_wyhash(const void* key) {
+    return (uint32_t)wyhash(key, strlen(key), hash_seed);
+}
+
+uint32_t hash_table_str_hash_wyhash_str(const void* key) {
+    return (uint32_t)wyhash_str(key, hash_seed);
+}
+
+uint32_t hash_table_str_hash_murmur3(const void* key) {
+    return murmur3_str(key, hash_seed);
 }
 
 int hash_table_init(
@@ -62,86 +111,366 @@ int hash_table_init(
     const hash_table_key_hash_func key_hash
 ) {
     memset(ht, 0, sizeof(hash_table));
-    ht->index_size = size;
+    ht->index_size = round_index_size(size);
 
-    size_t index_size = size * sizeof(list);
-    ht->index = malloc(index_size);
+    // Zeroed lists are empty lists
+    ht->index = calloc(ht->index_size, sizeof(list));
     if (ht->index == NULL) {
-        perror("ht_init: malloc() failed");
+        perror("ht_init: calloc() failed");
         return -1;
     }
 
-    memset(ht->index, 0, index_size);
-
     ht->entry_size = 0;
+    ht->max_load_factor = 1.0f;
+
+    slab_init(&ht->entry_pool, sizeof(hash_table_entry), 0);
+    slab_init(&ht->node_pool, sizeof(list_node), 0);
+
+    pthread_once(&hash_seed_once, init_hash_seed);
 
     ht->key_cmp = key_cmp == NULL ? default_key_cmp : key_cmp;
-    ht->key_hash = key_hash == NULL ? default_key_hash : key_hash;
+    ht->key_hash = key_hash == NULL ? hash_table_str_hash_wyhash : key_hash;
 
     return 0;
 }
 
-int hash_table_rehash(hash_table* ht, const uint32_t new_size) {
-    list** old_index = ht->index;
-    const size_t old_index_size = ht->index_size;
+int hash_table_init_open(
+    hash_table* ht,
+    const uint32_t size,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    memset(ht, 0, sizeof(hash_table));
+    ht->type = HASH_TABLE_OPEN;
+    ht->max_load_factor = 0.875f;
 
-    size_t index_size = new_size * sizeof(list);
-    ht->index = malloc(index_size);
-    if (ht->index == NULL) {
-        perror("ht_rehash: malloc() failed");
+    pthread_once(&hash_seed_once, init_hash_seed);
+
+    ht->key_cmp = key_cmp == NULL ? default_key_cmp : key_cmp;
+    ht->key_hash = key_hash == NULL ? hash_table_str_hash_wyhash : key_hash;
+
+    return hash_table_open_init(ht, size);
+}
+
+int hash_table_init_rcu(
+    hash_table* ht,
+    const uint32_t size,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    memset(ht, 0, sizeof(hash_table));
+    ht->type = HASH_TABLE_RCU;
+    ht->max_load_factor = 1.0f;
+
+    pthread_once(&hash_seed_once, init_hash_seed);
+
+    ht->key_cmp = key_cmp == NULL ? default_key_cmp : key_cmp;
+    ht->key_hash = key_hash == NULL ? hash_table_str_hash_wyhash : key_hash;
+
+    return hash_table_rcu_init(ht, size);
+}
+
+int hash_table_init_compact(
+    hash_table* ht,
+    const uint32_t size,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    memset(ht, 0, sizeof(hash_table));
+    ht->type = HASH_TABLE_COMPACT;
+    ht->max_load_factor = 2.0f / 3.0f;
+
+    pthread_once(&hash_seed_once, init_hash_seed);
+
+    ht->key_cmp = key_cmp == NULL ? default_key_cmp : key_cmp;
+    ht->key_hash = key_hash == NULL ? hash_table_str_hash_wyhash : key_hash;
+
+    return hash_table_compact_init(ht, size);
+}
+
+int hash_table_init_fixed(
+    hash_table* ht,
+    const uint32_t size,
+    const size_t key_size,
+    const size_t value_size
+) {
+    if (key_size == 0) {
+        fprintf(stderr, "ht_init_fixed: key size must not be 0\n");
+        return -1;
+    }
+
+    memset(ht, 0, sizeof(hash_table));
+    ht->type = HASH_TABLE_OPEN;
+    ht->max_load_factor = 0.875f;
+
+    // Keys are compared and hashed by the open addressing backend itself
+    ht->key_size = key_size;
+    ht->value_size = value_size;
+
+    return hash_table_open_init(ht, size);
+}
+
+/**
+ * Check if the hash table storage has been allocated
+ *
+ * @param ht Hash table
+ * @return 1 if initialized, 0 if not (or destroyed)
+ */
+static int is_initialized(const hash_table* ht) {
+    if (ht->type == HASH_TABLE_OPEN) {
+        return ht->ctrl != NULL;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        return ht->rcu != NULL;
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return ht->entries != NULL;
+    }
+
+    return ht->index != NULL;
+}
+
+/**
+ * Add a key hash to the attached filter (if any)
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ */
+static void filter_add(const hash_table* ht, const uint32_t hash) {
+    if (ht->filter != NULL) {
+        bloom_filter_add(ht->filter, hash);
+    }
+}
+
+/**
+ * Check if the attached filter rules a key out
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ * @return 1 if the key is definitely not in the table, 0 otherwise
+ */
+static int filter_excludes(const hash_table* ht, const uint32_t hash) {
+    return ht->filter != NULL && !bloom_filter_contains(ht->filter, hash);
+}
+
+/**
+ * Release a hash table entry that is no longer stored in the table
+ *
+ * @param ht Hash table
+ * @param entry Hash table entry
+ */
+static void dispose_entry(hash_table* ht, const hash_table_entry* entry) {
+    if (entry->pooled) {
+        slab_free(&ht->entry_pool, (void *)entry);
+    }
+    else if (entry->must_destroy) {
+        hash_table_destroy_entry(entry);
+    }
+    else {
+        free((void *)entry);
+    }
+}
+
+/**
+ * Move all entries of a bucket in the previous index to the current index
+ * List nodes (and the entries they hold) are relinked, not reallocated
+ *
+ * @param ht Hash table
+ * @param p_bucket Bucket of previous index
+ */
+static void migrate_bucket(hash_table* ht, list* p_bucket) {
+    list_node* p_node;
+
+    while ((p_node = linked_list_pop_head_node(p_bucket)) != NULL) {
+        const hash_table_entry* p_entry = p_node->value;
+        const size_t index = find_index(p_entry->hash, ht->index_size);
+        linked_list_push_tail_node(&ht->index[index], p_node);
+    }
+}
+
+/**
+ * Migrate a few buckets of an in-progress incremental rehash
+ *
+ * @param ht Hash table
+ * @param bucket_count Max number of buckets to migrate
+ */
+static void rehash_step(hash_table* ht, size_t bucket_count) {
+    if (ht->rehash_index == NULL) {
+        return;
+    }
+
+    while (bucket_count-- > 0 && ht->rehash_pos < ht->rehash_index_size) {
+        migrate_bucket(ht, &ht->rehash_index[ht->rehash_pos++]);
+    }
+
+    if (ht->rehash_pos == ht->rehash_index_size) {
+        // Done
+        free(ht->rehash_index);
+        ht->rehash_index = NULL;
+        ht->rehash_index_size = 0;
+        ht->rehash_pos = 0;
+    }
+}
+
+/**
+ * Start an incremental rehash into a new index
+ * Any rehash already in progress is completed first
+ *
+ * @param ht Hash table
+ * @param new_size Size of new index
+ * @return 0 on success, -1 on failure
+ */
+static int start_rehash(hash_table* ht, const size_t new_size) {
+    rehash_step(ht, SIZE_MAX);
+
+    list* new_index = calloc(new_size, sizeof(list));
+    if (new_index == NULL) {
+        perror("ht_rehash: calloc() failed");
         return -1;
     }
 
-    memset(ht->index, 0, index_size);
+    ht->rehash_index = ht->index;
+    ht->rehash_index_size = ht->index_size;
+    ht->rehash_pos = 0;
+
+    ht->index = new_index;
     ht->index_size = new_size;
 
+    return 0;
+}
+
+int hash_table_rehash(hash_table* ht, const uint32_t new_size) {
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_rehash: hash table not initialized\n");
+        return -1;
+    }
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_rehash(ht, new_size);
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_rehash(ht, new_size);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_rehash(ht, new_size);
+    }
+
+    if (start_rehash(ht, round_index_size(new_size)) != 0) {
+        return -1;
+    }
+
     // Rebuild index
-    for (int i = 0; i < old_index_size; ++i) {
-        const list* p_list = old_index[i];
-        if (p_list != NULL) {
-            const list_node* p_iter = p_list->head;
-            if (p_iter != NULL) {
-                do {
-                    hash_table_entry* p_entry = p_iter->value;
-                    hash_table_set_entry(ht, p_entry);
-                    p_iter = p_iter->next;
-                }
-                while (p_iter != NULL);
-            }
-        }
+    rehash_step(ht, SIZE_MAX);
+
+    return 0;
+}
+
+int hash_table_set_max_load_factor(hash_table* ht, const float max_load_factor) {
+    const int must_be_fraction = ht->type == HASH_TABLE_OPEN || ht->type == HASH_TABLE_COMPACT;
+
+    if (max_load_factor < 0 || (must_be_fraction && (max_load_factor <= 0 || max_load_factor >= 1))) {
+        fprintf(stderr, "ht_set_max_load_factor: invalid load factor %f\n", max_load_factor);
+        return -1;
     }
 
-    free(old_index);
+    ht->max_load_factor = max_load_factor;
 
     return 0;
 }
 
+/**
+ * Start growing the index if the load factor was exceeded
+ *
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+static int maybe_grow(hash_table* ht) {
+    if (ht->max_load_factor == 0 || ht->rehash_index != NULL) {
+        return 0;
+    }
+
+    if (ht->entry_size <= ht->index_size * ht->max_load_factor) {
+        return 0;
+    }
+
+    return start_rehash(ht, ht->index_size * 2);
+}
+
+/**
+ * Find list node holding key in a bucket
+ * The comparator only runs on entries whose full hash matches
+ *
+ * @param ht Hash table
+ * @param p_bucket Bucket to search
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @return List node (or NULL if not found)
+ */
+static list_node* find_node(
+    const hash_table* ht,
+    const list* p_bucket,
+    const void* key,
+    const uint32_t hash
+) {
+    for (list_node* p_curr = p_bucket->head; p_curr != NULL; p_curr = p_curr->next) {
+        const hash_table_entry* p_entry = p_curr->value;
+        if (p_entry->hash == hash && (*ht->key_cmp)(p_entry->key, key) == 0) {
+            return p_curr;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Find list node holding key in the current index, or in the previous index
+ * if a rehash is in progress
+ *
+ * @param ht Hash table
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @param p_bucket Output bucket holding the node (optional)
+ * @return List node (or NULL if not found)
+ */
+static list_node* lookup_node(const hash_table* ht, const void* key, const uint32_t hash, list** p_bucket) {
+    list* p_list = &ht->index[find_index(hash, ht->index_size)];
+    list_node* p_node = find_node(ht, p_list, key, hash);
+
+    if (p_node == NULL && ht->rehash_index != NULL) {
+        p_list = &ht->rehash_index[find_index(hash, ht->rehash_index_size)];
+        p_node = find_node(ht, p_list, key, hash);
+    }
+
+    if (p_bucket != NULL) {
+        *p_bucket = p_list;
+    }
+
+    return p_node;
+}
+
 hash_table_entry* hash_table_init_entry(
     const void* key, size_t key_size,
     const void* value, size_t value_size
 ) {
-    hash_table_entry* p_entry = malloc(sizeof(hash_table_entry));
+    // Entry, key and value share one allocation. The key directly follows
+    // the entry, and the value follows the key (padded for alignment).
+    const size_t align = _Alignof(max_align_t);
+    const size_t key_block_size = (key_size + align - 1) / align * align;
+
+    hash_table_entry* p_entry = malloc(sizeof(hash_table_entry) + key_block_size + value_size);
     if (p_entry == NULL) {
-        perror("ht_init_entry: malloc() failed for entry");
+        perror("ht_init_entry: malloc() failed");
         return NULL;
     }
 
+    memset(p_entry, 0, sizeof(hash_table_entry));
     p_entry->must_destroy = 1;
-
-    p_entry->key = malloc(key_size);
-    if (p_entry->key == NULL) {
-        perror("ht_init_entry: malloc() failed for key");
-        free(p_entry);
-        return NULL;
-    }
-
-    p_entry->value = malloc(value_size);
-    if (p_entry->value == NULL) {
-        perror("ht_init_entry: malloc() failed for value");
-        free(p_entry->key);
-        free(p_entry);
-        return NULL;
-    }
+    p_entry->key = p_entry + 1;
+    p_entry->value = (char *)p_entry->key + key_block_size;
 
     memcpy(p_entry->key, key, key_size);
     memcpy(p_entry->value, value, value_size);
@@ -149,155 +478,515 @@ hash_table_entry* hash_table_init_entry(
     return p_entry;
 }
 
+/**
+ * Check if an entry holds its key and value in its own block, as allocated by
+ * hash_table_init_entry()
+ *
+ * @param entry Hash table entry
+ * @return 1 if it does, 0 if key and value were allocated separately
+ */
+static int is_single_block(const hash_table_entry* entry) {
+    return entry->key == (const void *)(entry + 1);
+}
+
 int hash_table_destroy_entry(const hash_table_entry* entry) {
-    free(entry->key);
-    free(entry->value);
+    if (!is_single_block(entry)) {
+        free(entry->key);
+        free(entry->value);
+    }
+
     free((void *)entry);
 
     return 0;
 }
 
-int hash_table_set(hash_table* ht, void* key, void* value) {
-    hash_table_entry* p_entry = malloc(sizeof(hash_table_entry));
-    if (p_entry == NULL) {
-        perror("ht_set: malloc() failed");
+void hash_table_release_entry_copy(const hash_table_entry* copy) {
+    if (!copy->must_destroy) {
+        return;
+    }
+
+    if (copy->single_block) {
+        // The original entry was kept when the copy was stored, as the block
+        // holding the key: the key still directly follows it
+        free((hash_table_entry *)copy->key - 1);
+        return;
+    }
+
+    free(copy->key);
+    free(copy->value);
+}
+
+/**
+ * Add entry to a chained hash table (or replace the entry with the same key)
+ *
+ * @param ht Hash table
+ * @param entry Entry to set
+ * @param hash Full hash of entry key
+ * @return 0 on success, -1 on failure
+ */
+static int set_chained_entry(hash_table* ht, hash_table_entry* entry, const uint32_t hash) {
+    rehash_step(ht, REHASH_STEP_BUCKETS);
+
+    entry->hash = hash;
+
+    list_node* p_node = lookup_node(ht, entry->key, entry->hash, NULL);
+    if (p_node != NULL) {
+        // Replace existing entry
+        const hash_table_entry* p_old_entry = p_node->value;
+        p_node->value = entry;
+        dispose_entry(ht, p_old_entry);
+        return 0;
+    }
+
+    // Add to list
+    p_node = slab_alloc(&ht->node_pool);
+    if (p_node == NULL) {
         return -1;
     }
 
-    memset(p_entry, 0, sizeof(hash_table_entry));
-    p_entry->key = key;
-    p_entry->value = value;
+    p_node->value = entry;
 
-    return hash_table_set_entry(ht, p_entry);
+    const size_t index = find_index(entry->hash, ht->index_size);
+    linked_list_push_tail_node(&ht->index[index], p_node);
+
+    ++ht->entry_size;
+
+    // Failing to grow only makes chains longer
+    maybe_grow(ht);
+
+    return 0;
 }
 
 int hash_table_set_entry(hash_table* ht, hash_table_entry* entry) {
-    if (ht->index == NULL) {
+    if (!is_initialized(ht)) {
         fprintf(stderr, "ht_set_entry: hash table not initialized\n");
         return -1;
     }
 
-    const size_t index = find_index(ht, entry->key);
-    list* p_list = *(ht->index + index);
-    if (p_list == NULL) {
-        // First entry: Start a new linked list
-        p_list = *(ht->index + index) = malloc(sizeof(list));
-        if (linked_list_init(p_list) != 0) {
-            free(p_list);
+    // Only hash_table_set() creates pooled entries: clear whatever the caller
+    // left in the flag before any path below disposes of the entry by it
+    entry->pooled = 0;
+
+    // Backends storing copies of the entry keep the entry only if it's also
+    // the block holding the key and value
+    entry->single_block = entry->must_destroy && is_single_block(entry);
+
+    if (ht->type == HASH_TABLE_RCU) {
+        if (hash_table_rcu_set_entry(ht, entry) != 0) {
             return -1;
         }
+
+        if (!entry->single_block) {
+            // Entry was copied into its node
+            free(entry);
+        }
+
+        return 0;
     }
-    else {
-        list_node* p_curr = p_list->head;
-        do {
-            hash_table_entry* p_curr_ent = p_curr->value;
-            if ((*ht->key_cmp)(p_curr_ent->key, entry->key) == 0) {
-                // Update existing value
-                p_curr_ent->value = entry->value;
-                free(entry);
-                return 0;
-            }
 
-            p_curr = p_curr->next;
+    const uint32_t hash = hash_table_hash_key(ht, entry->key);
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        if (hash_table_open_set_entry(ht, entry, hash) != 0) {
+            return -1;
         }
-        while (p_curr != NULL);
+
+        filter_add(ht, hash);
+
+        if (ht->key_size != 0) {
+            // Key and value were copied into the slot as well
+            dispose_entry(ht, entry);
+        }
+        else if (!entry->single_block) {
+            // Entry was copied into its slot
+            free(entry);
+        }
+
+        return 0;
     }
 
-    ++ht->entry_size;
+    if (ht->type == HASH_TABLE_COMPACT) {
+        if (hash_table_compact_set_entry(ht, entry, hash) != 0) {
+            return -1;
+        }
 
-    // Add to list
-    return linked_list_push_tail(*(ht->index + index), entry);
+        filter_add(ht, hash);
+
+        if (!entry->single_block) {
+            // Entry was copied into the entries array
+            free(entry);
+        }
+
+        return 0;
+    }
+
+    if (set_chained_entry(ht, entry, hash) != 0) {
+        return -1;
+    }
+
+    filter_add(ht, hash);
+
+    return 0;
 }
 
-void* hash_table_get(const hash_table* ht, const void* key) {
-    if (ht->index == NULL) {
+int hash_table_set_hashed(hash_table* ht, void* key, void* value, const uint32_t hash) {
+    if (ht->type == HASH_TABLE_OPEN || ht->type == HASH_TABLE_COMPACT) {
+        // Slots hold entries (or keys and values) inline, so there's nothing to allocate
+        const hash_table_entry entry = { .key = key, .value = value, .must_destroy = 0 };
+        const int result = ht->type == HASH_TABLE_OPEN
+            ? hash_table_open_set_entry(ht, &entry, hash)
+            : hash_table_compact_set_entry(ht, &entry, hash);
+
+        if (result != 0) {
+            return -1;
+        }
+
+        filter_add(ht, hash);
+
+        return 0;
+    }
+
+    hash_table_entry* p_entry = slab_alloc(&ht->entry_pool);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    memset(p_entry, 0, sizeof(hash_table_entry));
+    p_entry->key = key;
+    p_entry->value = value;
+    p_entry->pooled = 1;
+
+    if (set_chained_entry(ht, p_entry, hash) != 0) {
+        slab_free(&ht->entry_pool, p_entry);
+        return -1;
+    }
+
+    filter_add(ht, hash);
+
+    return 0;
+}
+
+int hash_table_set(hash_table* ht, void* key, void* value) {
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_set: hash table not initialized\n");
+        return -1;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        // Entries are copied into chain nodes
+        const hash_table_entry entry = { .key = key, .value = value, .must_destroy = 0 };
+        return hash_table_rcu_set_entry(ht, &entry);
+    }
+
+    return hash_table_set_hashed(ht, key, value, hash_table_hash_key(ht, key));
+}
+
+/**
+ * Get value from a chained, open addressing or compact hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @param hash Full hash of key
+ * @return Value pointer (or NULL if not found)
+ */
+static void* get_hashed(hash_table* ht, const void* key, const uint32_t hash) {
+    if (filter_excludes(ht, hash)) {
+        return NULL;
+    }
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_get(ht, key, hash);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_lookup(ht, key, hash);
+    }
+
+    rehash_step(ht, REHASH_STEP_BUCKETS);
+
+    const list_node* p_node = lookup_node(ht, key, hash, NULL);
+
+    return p_node != NULL ? ((hash_table_entry *)p_node->value)->value : NULL;
+}
+
+void* hash_table_get(hash_table* ht, const void* key) {
+    if (!is_initialized(ht)) {
         fprintf(stderr, "ht_get: hash table not initialized\n");
         return NULL;
     }
 
-    size_t index = find_index(ht, key);
-    list* p_list = ht->index[index];
-    if (p_list == NULL || p_list->size == 0) {
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_get(ht, key);
+    }
+
+    return get_hashed(ht, key, hash_table_hash_key(ht, key));
+}
+
+/**
+ * Hash a batch of keys, and prefetch what looking them up reads first
+ * One level of indirection is prefetched per pass over the batch, so that
+ * the cache misses of all keys are in flight at the same time
+ *
+ * @param ht Chained, open addressing or compact hash table
+ * @param keys Keys
+ * @param count Number of keys (at most BATCH_SIZE)
+ * @param hashes Output full hashes of keys
+ */
+static void prefetch_batch(const hash_table* ht, const void* const* keys, const size_t count, uint32_t* hashes) {
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = hash_table_hash_key(ht, keys[i]);
+    }
+
+    if (ht->filter != NULL) {
+        for (size_t i = 0; i < count; ++i) {
+            bloom_filter_prefetch(ht->filter, hashes[i]);
+        }
+    }
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        for (size_t i = 0; i < count; ++i) {
+            hash_table_open_prefetch_group(ht, hashes[i]);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            hash_table_open_prefetch_slot(ht, hashes[i]);
+        }
+
+        return;
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        // Index slot, then the entry it points to
+        for (size_t i = 0; i < count; ++i) {
+            hash_table_compact_prefetch_slot(ht, hashes[i]);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            hash_table_compact_prefetch_entry(ht, hashes[i]);
+        }
+
+        return;
+    }
+
+    // Bucket, then first node, then its entry
+    const list* buckets[BATCH_SIZE];
+
+    for (size_t i = 0; i < count; ++i) {
+        buckets[i] = &ht->index[find_index(hashes[i], ht->index_size)];
+        __builtin_prefetch(buckets[i]);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (buckets[i]->head != NULL) {
+            __builtin_prefetch(buckets[i]->head);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (buckets[i]->head != NULL) {
+            __builtin_prefetch(buckets[i]->head->value);
+        }
+    }
+}
+
+size_t hash_table_get_many(hash_table* ht, const void* const* keys, const size_t count, void** values) {
+    uint32_t hashes[BATCH_SIZE];
+    size_t found = 0;
+
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_get_many: hash table not initialized\n");
+        return 0;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = hash_table_rcu_get(ht, keys[i]);
+            found += values[i] != NULL;
+        }
+
+        return found;
+    }
+
+    for (size_t start = 0; start < count; start += BATCH_SIZE) {
+        const size_t batch_count = count - start < BATCH_SIZE ? count - start : BATCH_SIZE;
+
+        prefetch_batch(ht, keys + start, batch_count, hashes);
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            values[start + i] = get_hashed(ht, keys[start + i], hashes[i]);
+            found += values[start + i] != NULL;
+        }
+    }
+
+    return found;
+}
+
+void* hash_table_lookup(const hash_table* ht, const void* key) {
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_lookup: hash table not initialized\n");
+        return NULL;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_get(ht, key);
+    }
+
+    return hash_table_lookup_hashed(ht, key, hash_table_hash_key(ht, key));
+}
+
+void* hash_table_lookup_hashed(const hash_table* ht, const void* key, const uint32_t hash) {
+    if (filter_excludes(ht, hash)) {
+        return NULL;
+    }
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_lookup(ht, key, hash);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_lookup(ht, key, hash);
+    }
+
+    const list_node* p_node = lookup_node(ht, key, hash, NULL);
+    if (p_node == NULL) {
         // No entry
         return NULL;
     }
 
-    list_node* p_curr = p_list->head;
-    do {
-        hash_table_entry* p_entry = p_curr->value;
-        if ((*ht->key_cmp)(p_entry->key, key) == 0) {
-            return p_entry->value;
+    return ((hash_table_entry *)p_node->value)->value;
+}
+
+int hash_table_set_many(hash_table* ht, void* const* keys, void* const* values, const size_t count) {
+    uint32_t hashes[BATCH_SIZE];
+
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_set_many: hash table not initialized\n");
+        return -1;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        for (size_t i = 0; i < count; ++i) {
+            if (hash_table_set(ht, keys[i], values[i]) != 0) {
+                return -1;
+            }
         }
 
-        p_curr = p_curr->next;
+        return 0;
     }
-    while (p_curr != NULL);
 
-    // No entry
-    return NULL;
+    for (size_t start = 0; start < count; start += BATCH_SIZE) {
+        const size_t batch_count = count - start < BATCH_SIZE ? count - start : BATCH_SIZE;
+
+        prefetch_batch(ht, (const void* const*)keys + start, batch_count, hashes);
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            if (hash_table_set_hashed(ht, keys[start + i], values[start + i], hashes[i]) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+uint32_t hash_table_hash_key(const hash_table* ht, const void* key) {
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_hash_key(ht, key);
+    }
+
+    return (*ht->key_hash)(key);
 }
 
 int hash_table_del(hash_table* ht, const void* key) {
-    if (ht->index == NULL) {
+    if (!is_initialized(ht)) {
         fprintf(stderr, "ht_del: hash table not initialized\n");
         return -1;
     }
 
-    size_t index = find_index(ht, key);
-    list* p_list = ht->index[index];
-    if (p_list == NULL || p_list->size == 0) {
-        // No entry
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_del(ht, key);
+    }
+
+    return hash_table_del_hashed(ht, key, hash_table_hash_key(ht, key));
+}
+
+int hash_table_del_hashed(hash_table* ht, const void* key, const uint32_t hash) {
+    // (Deleted keys stay in the filter: they can't be removed from it)
+    if (filter_excludes(ht, hash)) {
         return -1;
     }
 
-    int i = 0;
-    size_t deleted_count = 0;
-    list_node* p_curr = p_list->head;
-    while (p_curr != NULL) {
-        hash_table_entry* p_entry = p_curr->value;
-        if ((*ht->key_cmp)(p_entry->key, key) == 0) {
-            linked_list_del_at(p_list, i);
-            ++deleted_count;
-        }
-        else {
-            ++i;
-        }
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_del(ht, key, hash);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_del(ht, key, hash);
+    }
+
+    rehash_step(ht, REHASH_STEP_BUCKETS);
+
+    // Keys are unique, so there's at most one entry to delete
+    list* p_list;
+    list_node* p_node = lookup_node(ht, key, hash, &p_list);
+    if (p_node == NULL) {
+        // No entry
+        return -1;
+    }
 
-        p_curr = p_curr->next;
-    };
+    const hash_table_entry* p_entry = p_node->value;
+    linked_list_unlink_node(p_list, p_node);
+    slab_free(&ht->node_pool, p_node);
+    dispose_entry(ht, p_entry);
 
-    ht->entry_size -= deleted_count;
+    --ht->entry_size;
 
-    // No entry
-    return deleted_count > 0 ? 0 : -1;
+    return 0;
 }
 
 /**
- * Iterator callback function that destroys all entries
+ * Iterator callback function that destroys entries not allocated from
+ * the hash table's entry pool
  *
  * @param entry Iterated hash table entry
  * @param _index Iteration index (ignored)
- * @param _user_arg Ignored
+ * @param ht Hash table
  */
 static void destroy_iter_func(
     const hash_table_entry* entry,
     const size_t _index,
-    void* _user_arg
+    void* ht
 ) {
-    if (entry->must_destroy) {
-        hash_table_destroy_entry(entry);
-    }
-    else {
-        free((void *)entry);
+    if (!entry->pooled) {
+        dispose_entry(ht, entry);
     }
 }
 
 int hash_table_destroy(hash_table* ht) {
-    if (ht->index == NULL) {
+    if (!is_initialized(ht)) {
         return -1;
     }
 
-    hash_table_iter(ht, destroy_iter_func, NULL);
+    ht->filter = NULL;
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_destroy(ht);
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_destroy(ht);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_destroy(ht);
+    }
+
+    hash_table_iter(ht, destroy_iter_func, ht);
+
+    // Pooled entries and all list nodes are released in bulk
+    slab_reset(&ht->entry_pool);
+    slab_reset(&ht->node_pool);
+
     free(ht->index);
     ht->index = NULL;
 
@@ -307,33 +996,137 @@ int hash_table_destroy(hash_table* ht) {
 }
 
 int hash_table_iter(
-    const hash_table* ht,
+    hash_table* ht,
     ht_iter_func iter_func,
     void* iter_func_user_arg
 ) {
-    if (ht->index == NULL) {
+    if (!is_initialized(ht)) {
         fprintf(stderr, "ht_iter: hash table not initialized\n");
         return -1;
     }
 
-    for (int i = 0; i < ht->index_size; ++i) {
-        const list* p_list = ht->index[i];
-        if (p_list != NULL) {
-            const list_node* p_iter = p_list->head;
-            if (p_iter != NULL) {
-                do {
-                    hash_table_entry* p_entry = p_iter->value;
-                    p_iter = p_iter->next;
-                    iter_func(p_entry, i, iter_func_user_arg);
-                }
-                while (p_iter != NULL);
-            }
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_iter(ht, iter_func, iter_func_user_arg);
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        return hash_table_rcu_iter(ht, iter_func, iter_func_user_arg);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_iter(ht, iter_func, iter_func_user_arg);
+    }
+
+    // Iterate a single, stable index
+    rehash_step(ht, SIZE_MAX);
+
+    for (size_t i = 0; i < ht->index_size; ++i) {
+        const list_node* p_iter = ht->index[i].head;
+        while (p_iter != NULL) {
+            hash_table_entry* p_entry = p_iter->value;
+            p_iter = p_iter->next;
+            iter_func(p_entry, i, iter_func_user_arg);
         }
     }
 
     return 0;
 }
 
+int hash_table_cursor_init(hash_table_cursor* cursor, hash_table* ht) {
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_cursor_init: hash table not initialized\n");
+        return -1;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        // Iterate with hash_table_iter() instead: it walks a snapshot of the chains
+        // within one epoch read section, which a cursor can't hold across calls.
+        // Writers aren't excluded either way.
+        fprintf(stderr, "ht_cursor_init: RCU hash tables don't support cursors\n");
+        return -1;
+    }
+
+    // Iterate a single, stable index
+    if (ht->type == HASH_TABLE_OPEN) {
+        hash_table_open_finish_rehash(ht);
+    }
+    else if (ht->type == HASH_TABLE_CHAINED) {
+        rehash_step(ht, SIZE_MAX);
+    }
+
+    memset(cursor, 0, sizeof(hash_table_cursor));
+    cursor->ht = ht;
+
+    return 0;
+}
+
+const hash_table_entry* hash_table_cursor_next(hash_table_cursor* cursor) {
+    const hash_table* ht = cursor->ht;
+
+    if (ht->type == HASH_TABLE_OPEN) {
+        return hash_table_open_next(ht, &cursor->pos, &cursor->entry);
+    }
+
+    if (ht->type == HASH_TABLE_COMPACT) {
+        return hash_table_compact_next(ht, &cursor->pos);
+    }
+
+    while (cursor->node == NULL) {
+        if (cursor->pos >= ht->index_size) {
+            return NULL;
+        }
+
+        cursor->node = ht->index[cursor->pos++].head;
+    }
+
+    // Move on first, so that the entry may be deleted
+    const hash_table_entry* p_entry = cursor->node->value;
+    cursor->node = cursor->node->next;
+
+    return p_entry;
+}
+
+/**
+ * Iterator callback function that adds the hash of entry keys to a filter
+ *
+ * @param entry Iterated hash table entry
+ * @param _index Iteration index (ignored)
+ * @param filter Filter
+ */
+static void filter_iter_func(
+    const hash_table_entry* entry,
+    const size_t _index,
+    void* filter
+) {
+    bloom_filter_add(filter, entry->hash);
+}
+
+int hash_table_attach_filter(hash_table* ht, bloom_filter* filter) {
+    if (!is_initialized(ht)) {
+        fprintf(stderr, "ht_attach_filter: hash table not initialized\n");
+        return -1;
+    }
+
+    if (ht->type == HASH_TABLE_RCU) {
+        // Readers would race with the filter being updated
+        fprintf(stderr, "ht_attach_filter: RCU hash tables don't support filters\n");
+        return -1;
+    }
+
+    ht->filter = NULL;
+
+    if (filter != NULL) {
+        bloom_filter_clear(filter);
+        if (hash_table_iter(ht, filter_iter_func, filter) != 0) {
+            return -1;
+        }
+    }
+
+    ht->filter = filter;
+
+    return 0;
+}
+
 /**
  * Iterator callback function that prints the hash table to stdout
  *
@@ -349,7 +1142,7 @@ static void dump_iter_func(
     printf("%zu: { \"%s\" => \"%s\" }\n", index, (char *)entry->key, (char *)entry->value);
 }
 
-void hash_table_dump(const hash_table* ht) {
+void hash_table_dump(hash_table* ht) {
     hash_table_iter(ht, dump_iter_func, NULL);
 }
 
@@ -367,20 +1160,37 @@ static void keys_iter_func(
 ) {
     struct hash_table_array_builder_arg* arg = user_arg;
 
-    arg->items[arg->index++] = entry->key;
+    if (arg->index < arg->max_count) {
+        arg->items[arg->index] = entry->key;
+    }
+
+    ++arg->index;
 }
 
-size_t hash_table_keys(const hash_table* ht, void** keys) {
+size_t hash_table_keys(hash_table* ht, void** keys) {
+    size_t count;
+
+    if (hash_table_keys_n(ht, keys, SIZE_MAX, &count) != 0) {
+        return -1;
+    }
+
+    return count;
+}
+
+int hash_table_keys_n(hash_table* ht, void** keys, const size_t max_count, size_t* count_out) {
     struct hash_table_array_builder_arg user_arg;
 
     memset(&user_arg, 0, sizeof(user_arg));
     user_arg.items = keys;
+    user_arg.max_count = max_count;
 
     if (hash_table_iter(ht, keys_iter_func, &user_arg) != 0) {
         return -1;
     }
 
-    return user_arg.index;
+    *count_out = user_arg.index;
+
+    return 0;
 }
 
 size_t hash_table_size(const hash_table* ht) {
@@ -401,18 +1211,35 @@ static void values_iter_func(
 ) {
     struct hash_table_array_builder_arg* arg = user_arg;
 
-    arg->items[arg->index++] = entry->value;
+    if (arg->index < arg->max_count) {
+        arg->items[arg->index] = entry->value;
+    }
+
+    ++arg->index;
 }
 
-size_t hash_table_values(const hash_table* ht, void** values) {
+size_t hash_table_values(hash_table* ht, void** values) {
+    size_t count;
+
+    if (hash_table_values_n(ht, values, SIZE_MAX, &count) != 0) {
+        return -1;
+    }
+
+    return count;
+}
+
+int hash_table_values_n(hash_table* ht, void** values, const size_t max_count, size_t* count_out) {
     struct hash_table_array_builder_arg user_arg;
 
     memset(&user_arg, 0, sizeof(user_arg));
     user_arg.items = values;
+    user_arg.max_count = max_count;
 
     if (hash_table_iter(ht, values_iter_func, &user_arg) != 0) {
         return -1;
     }
 
-    return user_arg.index;
+    *count_out = user_arg.index;
+
+    return 0;
 }
@@ -2,12 +2,26 @@
 #define __HASH_TABLE_H__
 
 /**
- * Closed-addressed general purpose hash table with
- * a customizable hash function and key comparator
+ * General purpose hash table with a customizable hash function
+ * and key comparator.
+ *
+ * Four storage backends are available behind the same API:
+ * - Chained (hash_table_init): each index bucket is a linked list of entries
+ * - Open addressing (hash_table_init_open): entries are stored inline in a
+ *   flat slot array, probed 16 slots at a time through a control byte array.
+ *   Its hash_table_init_fixed() variant stores fixed-size keys and values
+ *   themselves inline in the slot array
+ * - Read-copy-update (hash_table_init_rcu): like chained, but chains are
+ *   never modified in place, so lookups take no lock and never wait
+ * - Compact (hash_table_init_compact): entries are stored densely in
+ *   insertion order, behind a small index, so iteration visits them in
+ *   insertion order and costs O(entries) rather than O(index size)
  */
 
 #include <inttypes.h>
+#include "bloom_filter.h"
 #include "linked_list.h"
+#include "slab.h"
 
 /**
  * Hash table entry
@@ -17,10 +31,30 @@ typedef struct hash_table_entry {
     void* value;
 
     /**
-     * If set to 1, then ht_destroy_entry() will automatically
-     * be called on this entry when ht_destroy() was called
+     * Full hash of key (set by the hash table when the entry is stored)
+     * Compared before calling the key comparator, and reused when rehashing
+     */
+    uint32_t hash;
+
+    /**
+     * If set to 1, the hash table owns the entry, key and value once the entry
+     * is set, and frees them when the entry is replaced, deleted or destroyed.
+     * Entries from hash_table_init_entry() hold their key and value in the
+     * same block; for other entries, the key and value are freed separately.
      */
     uint8_t must_destroy;
+
+    /**
+     * Set by the hash table when the entry was allocated from its own pool
+     */
+    uint8_t pooled;
+
+    /**
+     * Set by the hash table when a must_destroy entry holds its key and value
+     * in the same block (hash_table_init_entry()), so that copies of the entry
+     * stored in a slot or node free that block rather than key and value
+     */
+    uint8_t single_block;
 } hash_table_entry;
 
 /**
@@ -30,15 +64,79 @@ typedef int (*hash_table_key_cmp_func)(const void* key_a, const void* key_b);
 
 /**
  * Key hash function
+ * Must return the full 32-bit hash: the hash table reduces it to an index
+ * itself (from the low bits for chained tables, and both the high and low
+ * bits for open addressing)
  */
-typedef uint32_t (*hash_table_key_hash_func)(const void* key, size_t ht_size);
+typedef uint32_t (*hash_table_key_hash_func)(const void* key);
+
+/**
+ * String key hash function: wyhash (default)
+ * All string hash functions use a seed picked once per process, when the
+ * first hash table is initialized
+ *
+ * @param key NUL-terminated string
+ * @return Hash value
+ */
+uint32_t hash_table_str_hash_wyhash(const void* key);
+
+/**
+ * String key hash function: wyhash-style, single pass
+ * Reads the string once instead of twice (strlen() first), but glibc's
+ * vectorized strlen() usually makes hash_table_str_hash_wyhash() faster
+ *
+ * @param key NUL-terminated string
+ * @return Hash value
+ */
+uint32_t hash_table_str_hash_wyhash_str(const void* key);
+
+/**
+ * String key hash function: murmur3, single pass
+ *
+ * @param key NUL-terminated string
+ * @return Hash value
+ */
+uint32_t hash_table_str_hash_murmur3(const void* key);
+
+/**
+ * Hash table storage backend
+ */
+typedef enum hash_table_type {
+    /**
+     * Separate chaining: index buckets are linked lists of entries
+     */
+    HASH_TABLE_CHAINED = 0,
+
+    /**
+     * Open addressing: entries are stored inline in a flat slot array
+     */
+    HASH_TABLE_OPEN,
+
+    /**
+     * Read-copy-update: chains are replaced instead of modified, and old
+     * versions are freed through epoch-based reclamation
+     */
+    HASH_TABLE_RCU,
+
+    /**
+     * Compact: entries are stored in insertion order in a dense array, which
+     * an index of small integers points into
+     */
+    HASH_TABLE_COMPACT
+} hash_table_type;
 
 /**
  * Hash table
  */
 typedef struct hash_table {
     /**
-     * Size of the index
+     * Storage backend
+     */
+    hash_table_type type;
+
+    /**
+     * Size of the index (number of slots for HASH_TABLE_OPEN and HASH_TABLE_COMPACT)
+     * Always a power of 2, so that a hash is reduced to an index with a mask
      * This is NOT the size of all stored entries
      */
     size_t index_size;
@@ -50,9 +148,135 @@ typedef struct hash_table {
 
     /**
      * Hash table index
-     * Pointers to linked lists of entries
+     * One linked list of entries per bucket
+     */
+    list* index;
+
+    /**
+     * HASH_TABLE_OPEN: Control bytes (one per slot)
+     * Either empty, deleted, or the low 7 bits of the hash of the slot's key
+     */
+    int8_t* ctrl;
+
+    /**
+     * HASH_TABLE_OPEN: Slot array (index_size slots of slot_size bytes)
+     * Each slot is a hash_table_entry, or the hash, key and value for
+     * fixed-size keys
+     */
+    void* slots;
+
+    /**
+     * HASH_TABLE_OPEN: Size of each slot
+     */
+    size_t slot_size;
+
+    /**
+     * Fixed-size keys (hash_table_init_fixed): size of keys (0 otherwise)
+     */
+    size_t key_size;
+
+    /**
+     * Fixed-size keys: size of values
+     */
+    size_t value_size;
+
+    /**
+     * Fixed-size keys: offset of the key in a slot
+     */
+    size_t key_offset;
+
+    /**
+     * Fixed-size keys: offset of the value in a slot
+     */
+    size_t value_offset;
+
+    /**
+     * HASH_TABLE_OPEN: Number of deleted slots that have not been reclaimed yet
+     */
+    size_t tombstone_size;
+
+    /**
+     * HASH_TABLE_COMPACT: Entries, in insertion order
+     * Deleted entries have a NULL key until the next resize squeezes them out
+     */
+    hash_table_entry* entries;
+
+    /**
+     * HASH_TABLE_COMPACT: Number of entries used in the entries array (live or deleted)
+     */
+    size_t entries_used;
+
+    /**
+     * HASH_TABLE_COMPACT: Capacity of the entries array
+     */
+    size_t entries_capacity;
+
+    /**
+     * HASH_TABLE_COMPACT: Index (index_size slots of compact_index_width bytes)
+     * Each slot is empty, deleted, or the position of an entry
+     */
+    void* compact_index;
+
+    /**
+     * HASH_TABLE_COMPACT: Size of each index slot (1, 2, 4 or 8 bytes)
+     */
+    uint8_t compact_index_width;
+
+    /**
+     * Load factor (entries / index size) at which the index automatically
+     * doubles in size. 0 disables automatic growth (chained only).
+     * Default: 1.0 (chained), 0.875 (open addressing), 2/3 (compact)
+     */
+    float max_load_factor;
+
+    /**
+     * Incremental rehash: previous index that entries are being migrated
+     * away from (NULL when no rehash is in progress)
+     * A few buckets are migrated on every set/get/del, so that growing the
+     * table never stalls a single operation for the whole table
+     */
+    list* rehash_index;
+
+    /**
+     * Incremental rehash (HASH_TABLE_OPEN): previous control bytes
      */
-    list** index;
+    int8_t* rehash_ctrl;
+
+    /**
+     * Incremental rehash (HASH_TABLE_OPEN): previous slot array
+     */
+    void* rehash_slots;
+
+    /**
+     * Incremental rehash: size of the previous index
+     */
+    size_t rehash_index_size;
+
+    /**
+     * Incremental rehash: next bucket (or slot) of the previous index to migrate
+     */
+    size_t rehash_pos;
+
+    /**
+     * Pool for entries created by hash_table_set() (chained only)
+     */
+    slab entry_pool;
+
+    /**
+     * Pool for bucket list nodes (chained only)
+     * Released in bulk, along with entry_pool, by hash_table_destroy()
+     */
+    slab node_pool;
+
+    /**
+     * HASH_TABLE_RCU: Published bucket array and writer lock
+     */
+    struct hash_table_rcu* rcu;
+
+    /**
+     * Filter answering most lookups of missing keys (NULL if none attached)
+     */
+    bloom_filter* filter;
 
     /**
      * Key comparator function
@@ -62,7 +286,7 @@ typedef struct hash_table {
 
     /**
      * Key hash function
-     * Default: String hash function
+     * Default: String hash function (hash_table_str_hash_wyhash)
      */
     hash_table_key_hash_func key_hash;
 } hash_table;
@@ -71,7 +295,7 @@ typedef struct hash_table {
  * Initialize hash table
  *
  * @param ht Hash table
- * @param size Index size
+ * @param size Index size (rounded up to a power of 2)
  * @param key_cmp Key comparator (or NULL to use default)
  * @param key_hash Key hash function (or NULL to use default)
  * @return 0 on success, -1 on failure
@@ -83,17 +307,126 @@ int hash_table_init(
     hash_table_key_hash_func key_hash
 );
 
+/**
+ * Initialize an open addressing hash table
+ *
+ * Entries are stored inline in a flat slot array instead of separately
+ * allocated list nodes, so setting a value doesn't allocate and a lookup
+ * usually touches a single cache line of control bytes and a single slot.
+ * The table grows automatically once it's 7/8 full.
+ *
+ * @param ht Hash table
+ * @param size Initial number of slots (rounded up to a power of 2, minimum 16)
+ * @param key_cmp Key comparator (or NULL to use default)
+ * @param key_hash Key hash function (or NULL to use default)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_init_open(
+    hash_table* ht,
+    uint32_t size,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Initialize an open addressing hash table for fixed-size keys and values
+ *
+ * Keys and values are copied into the slot array itself, so nothing is
+ * allocated per entry and no key/value copy has to outlive the call to
+ * hash_table_set(). Keys are compared bytewise and hashed according to their
+ * size (4, 6 and 8 byte keys are hashed as integers), without calling a
+ * comparator or hash function.
+ *
+ * Values returned by hash_table_get() and entries passed to hash_table_iter()
+ * point into the slot array: they stay valid until the next set or delete.
+ *
+ * @param ht Hash table
+ * @param size Initial number of slots (rounded up to a power of 2, minimum 16)
+ * @param key_size Size of keys
+ * @param value_size Size of values (may be 0 to use the table as a set)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_init_fixed(
+    hash_table* ht,
+    uint32_t size,
+    size_t key_size,
+    size_t value_size
+);
+
+/**
+ * Initialize a read-copy-update hash table
+ *
+ * Any number of threads may call hash_table_get() while other threads set
+ * and delete entries, without locking: readers never wait, and writers only
+ * wait for each other. Writers copy the chain nodes in front of the entry
+ * they replace or delete (and the whole index when it grows), and the old
+ * versions are freed once no reader can still be traversing them (see
+ * epoch.h).
+ *
+ * hash_table_size(), hash_table_destroy() and hash_table_dump() must not
+ * run concurrently with writers.
+ *
+ * @param ht Hash table
+ * @param size Index size (rounded up to a power of 2)
+ * @param key_cmp Key comparator (or NULL to use default)
+ * @param key_hash Key hash function (or NULL to use default)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_init_rcu(
+    hash_table* ht,
+    uint32_t size,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Initialize a compact hash table
+ *
+ * Entries are stored in insertion order in a dense array, and a separate
+ * index of 1, 2, 4 or 8-byte integers (the smallest that fits the table)
+ * maps key hashes to positions in it. Iterating (hash_table_iter(), cursors,
+ * hash_table_keys(), ...) scans the entries array only, in insertion order,
+ * and replacing a value keeps the entry's position. Deletes leave a hole
+ * until the next resize. Resizes are not incremental. Keys must not be NULL.
+ *
+ * @param ht Hash table
+ * @param size Initial number of index slots (rounded up to a power of 2, minimum 8)
+ * @param key_cmp Key comparator (or NULL to use default)
+ * @param key_hash Key hash function (or NULL to use default)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_init_compact(
+    hash_table* ht,
+    uint32_t size,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
 /**
  * Resize and rebuild the hash table
+ * Unlike automatic growth, this completes the whole rebuild before returning.
+ * Existing entries are moved to the new index, not reallocated.
  *
  * @param ht Hash table
- * @param new_size New size of hash table index
+ * @param new_size New size of hash table index (rounded up to a power of 2)
  * @return 0 on success, -1 on failure
  */
 int hash_table_rehash(hash_table* ht, uint32_t new_size);
 
+/**
+ * Set the load factor at which the hash table automatically grows
+ *
+ * @param ht Hash table
+ * @param max_load_factor Maximum entries per index bucket (or slot). Must be
+ *                        less than 1 for open addressing and compact tables.
+ *                        0 disables automatic growth for chained tables.
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_set_max_load_factor(hash_table* ht, float max_load_factor);
+
 /**
  * Initialize a new hash table entry by creating a copy of key/value
+ * The entry and both copies are allocated as a single block
  *
  * @param key Pointer to key (to copy)
  * @param key_size Size of key
@@ -118,6 +451,8 @@ int hash_table_destroy_entry(const hash_table_entry* entry);
 
 /**
  * Set value in hash table
+ * Tables with fixed-size keys store copies of key and value (a NULL value
+ * is stored as zeroes); other tables store the pointers themselves
  *
  * @param ht Hash table
  * @param key Pointer to key
@@ -127,6 +462,9 @@ int hash_table_destroy_entry(const hash_table_entry* entry);
 int hash_table_set(hash_table* ht, void* key, void* value);
 
 /**
+ * Set entry in hash table
+ * The hash table takes ownership of the entry on success. If an entry with
+ * the same key already exists, it is replaced (and destroyed).
  *
  * @param ht Hash table
  * @param entry Entry to set
@@ -141,7 +479,54 @@ int hash_table_set_entry(hash_table* ht, hash_table_entry* entry);
  * @param key Entry key to get value for
  * @return Value pointer
  */
-void* hash_table_get(const hash_table* ht, const void* key);
+void* hash_table_get(hash_table* ht, const void* key);
+
+/**
+ * Get value from hash table without modifying it
+ * Unlike hash_table_get(), this never migrates entries of an in-progress
+ * rehash, so any number of threads may call it concurrently as long as no
+ * thread modifies the table at the same time
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @return Value pointer
+ */
+void* hash_table_lookup(const hash_table* ht, const void* key);
+
+/**
+ * Get the values of a batch of keys
+ * Keys are hashed a group at a time, and the buckets they map to are
+ * prefetched before any of them is looked up, so that lookups overlap their
+ * cache misses rather than stalling on each in turn. Worth it on tables much
+ * larger than the cache. RCU tables look keys up one at a time.
+ *
+ * @param ht Hash table
+ * @param keys Keys to get values for
+ * @param count Number of keys
+ * @param values Output values, in the order of keys (NULL for missing keys)
+ * @return Number of keys found
+ */
+size_t hash_table_get_many(hash_table* ht, const void* const* keys, size_t count, void** values);
+
+/**
+ * Set a batch of values, prefetching like hash_table_get_many()
+ *
+ * @param ht Hash table
+ * @param keys Pointers to keys
+ * @param values Pointers to values, in the order of keys
+ * @param count Number of keys
+ * @return 0 on success, -1 on failure (the keys before the one that failed are set)
+ */
+int hash_table_set_many(hash_table* ht, void* const* keys, void* const* values, size_t count);
+
+/**
+ * Compute the full hash of a key, as stored by the hash table
+ *
+ * @param ht Hash table
+ * @param key Key to hash
+ * @return Hash value
+ */
+uint32_t hash_table_hash_key(const hash_table* ht, const void* key);
 
 /**
  * Delete entry from hash table
@@ -152,6 +537,24 @@ void* hash_table_get(const hash_table* ht, const void* key);
  */
 int hash_table_del(hash_table* ht, const void* key);
 
+/**
+ * Attach a Bloom filter to hash table, so that most gets, lookups and deletes
+ * of missing keys return after checking one cache line of the filter, rather
+ * than probing the table (the key hash is computed once, for both). Present
+ * keys pay for the filter's cache line too, so it pays off when most lookups
+ * miss.
+ * The filter is cleared and filled with the keys already in the table, then
+ * kept up to date by every set. Deleted keys stay in the filter, so attaching
+ * it again after many deletes brings its false positive rate back down.
+ * The filter is not owned by the table, and is detached when the table is
+ * destroyed. RCU tables don't support filters.
+ *
+ * @param ht Hash table
+ * @param filter Filter, sized for the expected number of keys (or NULL to detach)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_attach_filter(hash_table* ht, bloom_filter* filter);
+
 /**
  * Destroy hash table
  *
@@ -175,6 +578,8 @@ typedef void (*ht_iter_func)(
 
 /**
  * Iterate hash table keys and values
+ * Completes any pending incremental rehash first. Entries may be deleted
+ * from within the callback, but not added.
  *
  * @param ht Hash table
  * @param iter_func Iterator callback function
@@ -182,36 +587,103 @@ typedef void (*ht_iter_func)(
  * @return 0 on success, -1 on failure
  */
 int hash_table_iter(
-    const hash_table* ht,
+    hash_table* ht,
     ht_iter_func iter_func,
     void* iter_func_user_arg
 );
 
+/**
+ * Hash table cursor, for iterating without a callback
+ */
+typedef struct hash_table_cursor {
+    hash_table* ht;
+
+    /**
+     * Next bucket, slot or entry position to look at
+     */
+    size_t pos;
+
+    /**
+     * Chained: next list node of the current bucket
+     */
+    const list_node* node;
+
+    /**
+     * Open addressing with fixed-size keys: entry presenting the current slot
+     */
+    hash_table_entry entry;
+} hash_table_cursor;
+
+/**
+ * Start iterating hash table keys and values with a cursor
+ * Completes any pending incremental rehash first. Compact tables are iterated
+ * in insertion order. RCU tables don't support cursors.
+ *
+ * @param cursor Cursor
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_cursor_init(hash_table_cursor* cursor, hash_table* ht);
+
+/**
+ * Get the next entry of a cursor
+ * The entry last returned may be deleted between two calls, but no entry may
+ * be added until the cursor is done.
+ *
+ * @param cursor Cursor
+ * @return Entry (or NULL once all entries were returned)
+ */
+const hash_table_entry* hash_table_cursor_next(hash_table_cursor* cursor);
+
 /**
  * Print the hash table to the console
  * Assumes that keys and values are stored as strings
  *
  * @param ht hash table
  */
-void hash_table_dump(const hash_table* ht);
+void hash_table_dump(hash_table* ht);
 
 /**
  * Get all keys in hash table
  *
  * @param ht Hash table
+ * @param keys Pointer to array to store key pointers in (hash_table_size() items)
+ * @return Number of keys (or -1 on failure)
+ */
+size_t hash_table_keys(hash_table* ht, void** keys);
+
+/**
+ * Get up to max_count keys in hash table
+ * Like snprintf(), a count greater than max_count means the array was too
+ * small, and only its first max_count items were written
+ *
+ * @param ht Hash table
  * @param keys Pointer to array to store key pointers in
- * @return Number of keys
+ * @param max_count Size of keys array
+ * @param count_out Output number of keys in hash table
+ * @return 0 on success, -1 on failure (count_out is left unchanged)
  */
-size_t hash_table_keys(const hash_table* ht, void** keys);
+int hash_table_keys_n(hash_table* ht, void** keys, size_t max_count, size_t* count_out);
 
 /**
  * Get all values in hash table
  *
  * @param ht Hash table
+ * @param values Pointer to array to store value pointers in (hash_table_size() items)
+ * @return Number of values (or -1 on failure)
+ */
+size_t hash_table_values(hash_table* ht, void** values);
+
+/**
+ * Get up to max_count values in hash table, like hash_table_keys_n()
+ *
+ * @param ht Hash table
  * @param values Pointer to array to store value pointers in
- * @return Number of values
+ * @param max_count Size of values array
+ * @param count_out Output number of values in hash table
+ * @return 0 on success, -1 on failure (count_out is left unchanged)
  */
-size_t hash_table_values(const hash_table* ht, void** values);
+int hash_table_values_n(hash_table* ht, void** values, size_t max_count, size_t* count_out);
 
 /**
  * Get number of entries in hash table
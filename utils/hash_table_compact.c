@@ -0,0 +1,371 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_table_compact.h"
+#include "hash_table_internal.h"
+
+/**
+ * Index slot: never used (ends a probe sequence)
+ */
+#define INDEX_EMPTY (-1)
+
+/**
+ * Index slot: pointed to an entry that was deleted
+ */
+#define INDEX_DELETED (-2)
+
+/**
+ * Minimum number of index slots
+ */
+#define MIN_INDEX_SIZE 8
+
+/**
+ * Bits of the hash mixed into each probe step (as in CPython's dict)
+ */
+#define PERTURB_SHIFT 5
+
+/**
+ * Round a requested index size up to a power of 2
+ *
+ * @param size Requested number of index slots
+ * @return Index size
+ */
+static size_t round_index_size(const size_t size) {
+    size_t index_size = MIN_INDEX_SIZE;
+    while (index_size < size) {
+        index_size <<= 1;
+    }
+
+    return index_size;
+}
+
+/**
+ * Get the width of the slots of an index: the smallest signed integer that
+ * holds every entry position
+ *
+ * @param index_size Number of index slots
+ * @return Slot width in bytes (1, 2, 4 or 8)
+ */
+static uint8_t index_width(const size_t index_size) {
+    if (index_size <= INT8_MAX + 1) {
+        return 1;
+    }
+
+    if (index_size <= INT16_MAX + 1) {
+        return 2;
+    }
+
+    if (index_size <= (size_t)INT32_MAX + 1) {
+        return 4;
+    }
+
+    return 8;
+}
+
+/**
+ * Get the entry position in an index slot
+ *
+ * @param index Index
+ * @param width Slot width
+ * @param slot Slot
+ * @return Entry position, INDEX_EMPTY or INDEX_DELETED
+ */
+static int64_t index_get(const void* index, const uint8_t width, const size_t slot) {
+    switch (width) {
+        case 1:
+            return ((const int8_t *)index)[slot];
+        case 2:
+            return ((const int16_t *)index)[slot];
+        case 4:
+            return ((const int32_t *)index)[slot];
+        default:
+            return ((const int64_t *)index)[slot];
+    }
+}
+
+/**
+ * Set the entry position in an index slot
+ *
+ * @param index Index
+ * @param width Slot width
+ * @param slot Slot
+ * @param pos Entry position, INDEX_EMPTY or INDEX_DELETED
+ */
+static void index_set(void* index, const uint8_t width, const size_t slot, const int64_t pos) {
+    switch (width) {
+        case 1:
+            ((int8_t *)index)[slot] = (int8_t)pos;
+            break;
+        case 2:
+            ((int16_t *)index)[slot] = (int16_t)pos;
+            break;
+        case 4:
+            ((int32_t *)index)[slot] = (int32_t)pos;
+            break;
+        default:
+            ((int64_t *)index)[slot] = pos;
+    }
+}
+
+/**
+ * Maximum number of entries (live or deleted) for an index size
+ *
+ * @param ht Hash table (for max load factor)
+ * @param index_size Number of index slots
+ * @return Entries array capacity (always leaves at least one empty index slot)
+ */
+static size_t max_entries(const hash_table* ht, const size_t index_size) {
+    const size_t capacity = (size_t)(index_size * ht->max_load_factor);
+
+    if (capacity == 0) {
+        return 1;
+    }
+
+    return capacity < index_size ? capacity : index_size - 1;
+}
+
+/**
+ * Find the index slot pointing to the entry holding a key
+ *
+ * @param ht Hash table
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @return Index slot (or -1 if not found)
+ */
+static size_t find_slot(const hash_table* ht, const void* key, const uint32_t hash) {
+    const size_t mask = ht->index_size - 1;
+    size_t perturb = hash;
+    size_t slot = hash & mask;
+
+    // Once perturb runs out, slot * 5 + 1 visits every slot of a power of 2 index
+    for (;;) {
+        const int64_t pos = index_get(ht->compact_index, ht->compact_index_width, slot);
+        if (pos == INDEX_EMPTY) {
+            return -1;
+        }
+
+        if (pos >= 0) {
+            const hash_table_entry* p_entry = &ht->entries[pos];
+            if (p_entry->hash == hash && (*ht->key_cmp)(p_entry->key, key) == 0) {
+                return slot;
+            }
+        }
+
+        perturb >>= PERTURB_SHIFT;
+        slot = (slot * 5 + perturb + 1) & mask;
+    }
+}
+
+/**
+ * Find the first empty slot in the probe sequence of a hash
+ * Deleted slots aren't reused: every used entry keeps its own slot, so that
+ * the index always has more empty slots than the entries array has room for
+ *
+ * @param index Index (must have at least one empty slot)
+ * @param width Slot width
+ * @param index_size Number of index slots
+ * @param hash Full hash
+ * @return Index slot
+ */
+static size_t find_empty_slot(const void* index, const uint8_t width, const size_t index_size, const uint32_t hash) {
+    const size_t mask = index_size - 1;
+    size_t perturb = hash;
+    size_t slot = hash & mask;
+
+    while (index_get(index, width, slot) != INDEX_EMPTY) {
+        perturb >>= PERTURB_SHIFT;
+        slot = (slot * 5 + perturb + 1) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * Move the live entries to a new entries array and index, in the same order
+ *
+ * @param ht Hash table
+ * @param new_size Requested number of index slots
+ * @return 0 on success, -1 on failure (the table is left unchanged)
+ */
+static int resize(hash_table* ht, const size_t new_size) {
+    // Never shrink below what the current entries need, plus one
+    size_t index_size = round_index_size(new_size);
+    while (ht->entry_size >= max_entries(ht, index_size)) {
+        index_size <<= 1;
+    }
+
+    const size_t capacity = max_entries(ht, index_size);
+    const uint8_t width = index_width(index_size);
+    void* new_index = malloc(index_size * width);
+    hash_table_entry* new_entries = malloc(capacity * sizeof(hash_table_entry));
+
+    if (new_index == NULL || new_entries == NULL) {
+        perror("hash_table_compact: malloc() failed");
+        free(new_index);
+        free(new_entries);
+        return -1;
+    }
+
+    // All bytes set is -1 (INDEX_EMPTY) at every width
+    memset(new_index, 0xFF, index_size * width);
+
+    size_t used = 0;
+    for (size_t pos = 0; pos < ht->entries_used; ++pos) {
+        const hash_table_entry* p_entry = &ht->entries[pos];
+        if (p_entry->key == NULL) {
+            continue;
+        }
+
+        new_entries[used] = *p_entry;
+        index_set(new_index, width, find_empty_slot(new_index, width, index_size, p_entry->hash), (int64_t)used);
+        ++used;
+    }
+
+    free(ht->compact_index);
+    free(ht->entries);
+
+    ht->compact_index = new_index;
+    ht->compact_index_width = width;
+    ht->index_size = index_size;
+    ht->entries = new_entries;
+    ht->entries_used = used;
+    ht->entries_capacity = capacity;
+
+    return 0;
+}
+
+int hash_table_compact_init(hash_table* ht, const size_t size) {
+    ht->entries = NULL;
+    ht->compact_index = NULL;
+    ht->entries_used = 0;
+    ht->entry_size = 0;
+
+    return resize(ht, size);
+}
+
+int hash_table_compact_rehash(hash_table* ht, const size_t new_size) {
+    return resize(ht, new_size);
+}
+
+int hash_table_compact_set_entry(hash_table* ht, const hash_table_entry* entry, const uint32_t hash) {
+    if (entry->key == NULL) {
+        fprintf(stderr, "hash_table_compact: keys must not be NULL\n");
+        return -1;
+    }
+
+    size_t slot = find_slot(ht, entry->key, hash);
+    if (slot != -1) {
+        // Replace existing entry, in place
+        hash_table_entry* p_entry = &ht->entries[index_get(ht->compact_index, ht->compact_index_width, slot)];
+        hash_table_release_entry_copy(p_entry);
+        *p_entry = *entry;
+        p_entry->hash = hash;
+        return 0;
+    }
+
+    if (ht->entries_used == ht->entries_capacity) {
+        // Squeeze out deleted entries when they're most of the array, grow otherwise
+        const size_t new_size = ht->entry_size < ht->entries_capacity / 2 ? ht->index_size : ht->index_size * 2;
+        if (resize(ht, new_size) != 0) {
+            return -1;
+        }
+    }
+
+    slot = find_empty_slot(ht->compact_index, ht->compact_index_width, ht->index_size, hash);
+
+    hash_table_entry* p_entry = &ht->entries[ht->entries_used];
+    *p_entry = *entry;
+    p_entry->hash = hash;
+
+    index_set(ht->compact_index, ht->compact_index_width, slot, (int64_t)ht->entries_used);
+    ++ht->entries_used;
+    ++ht->entry_size;
+
+    return 0;
+}
+
+void* hash_table_compact_lookup(const hash_table* ht, const void* key, const uint32_t hash) {
+    const size_t slot = find_slot(ht, key, hash);
+    if (slot == -1) {
+        return NULL;
+    }
+
+    return ht->entries[index_get(ht->compact_index, ht->compact_index_width, slot)].value;
+}
+
+void hash_table_compact_prefetch_slot(const hash_table* ht, const uint32_t hash) {
+    __builtin_prefetch((const uint8_t *)ht->compact_index + (hash & (ht->index_size - 1)) * ht->compact_index_width);
+}
+
+void hash_table_compact_prefetch_entry(const hash_table* ht, const uint32_t hash) {
+    const int64_t pos = index_get(ht->compact_index, ht->compact_index_width, hash & (ht->index_size - 1));
+
+    if (pos >= 0) {
+        __builtin_prefetch(&ht->entries[pos]);
+    }
+}
+
+int hash_table_compact_del(hash_table* ht, const void* key, const uint32_t hash) {
+    const size_t slot = find_slot(ht, key, hash);
+    if (slot == -1) {
+        return -1;
+    }
+
+    hash_table_entry* p_entry = &ht->entries[index_get(ht->compact_index, ht->compact_index_width, slot)];
+
+    // The entry keeps its place (marked with a NULL key) so that positions
+    // stay valid, and its slot stays used so that probe sequences do too
+    index_set(ht->compact_index, ht->compact_index_width, slot, INDEX_DELETED);
+    hash_table_release_entry_copy(p_entry);
+    p_entry->key = NULL;
+    p_entry->value = NULL;
+
+    --ht->entry_size;
+
+    return 0;
+}
+
+const hash_table_entry* hash_table_compact_next(const hash_table* ht, size_t* pos) {
+    while (*pos < ht->entries_used) {
+        const hash_table_entry* p_entry = &ht->entries[(*pos)++];
+        if (p_entry->key != NULL) {
+            return p_entry;
+        }
+    }
+
+    return NULL;
+}
+
+int hash_table_compact_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+) {
+    for (size_t pos = 0; pos < ht->entries_used; ++pos) {
+        if (ht->entries[pos].key != NULL) {
+            iter_func(&ht->entries[pos], pos, iter_func_user_arg);
+        }
+    }
+
+    return 0;
+}
+
+int hash_table_compact_destroy(hash_table* ht) {
+    for (size_t pos = 0; pos < ht->entries_used; ++pos) {
+        if (ht->entries[pos].key != NULL) {
+            hash_table_release_entry_copy(&ht->entries[pos]);
+        }
+    }
+
+    free(ht->entries);
+    free(ht->compact_index);
+    ht->entries = NULL;
+    ht->compact_index = NULL;
+
+    ht->entries_used = 0;
+    ht->entries_capacity = 0;
+    ht->entry_size = 0;
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef __HASH_TABLE_COMPACT_H__
+#define __HASH_TABLE_COMPACT_H__
+
+/**
+ * Compact, insertion-ordered backend for hash_table (HASH_TABLE_COMPACT)
+ *
+ * Entries are stored densely, in insertion order, in an array of their own.
+ * A separate index of small integers (1, 2, 4 or 8 bytes each, depending on
+ * the table size) maps hashes to positions in that array, with open
+ * addressing. Iterating only scans the entries array, so it is O(entries)
+ * rather than O(index size), and visits entries in insertion order.
+ *
+ * Deleted entries leave a hole in the array until the next resize, which
+ * squeezes them out. Resizes happen in one go (not incrementally).
+ *
+ * Not meant to be used directly: the hash_table_* functions dispatch here
+ * when the table was created with hash_table_init_compact()
+ */
+
+#include "hash_table.h"
+
+/**
+ * Allocate the entries array and index
+ *
+ * @param ht Hash table (with key_cmp/key_hash and max_load_factor already set)
+ * @param size Requested number of index slots
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_init(hash_table* ht, size_t size);
+
+/**
+ * Resize the index (and entries array), squeezing out deleted entries
+ *
+ * @param ht Hash table
+ * @param new_size Requested number of index slots
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_rehash(hash_table* ht, size_t new_size);
+
+/**
+ * Copy an entry into the entries array, replacing any entry with the same key
+ * (which keeps its position)
+ *
+ * @param ht Hash table
+ * @param entry Entry to copy (key/value ownership moves to the table, key must not be NULL)
+ * @param hash Full hash of entry key
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_set_entry(hash_table* ht, const hash_table_entry* entry, uint32_t hash);
+
+/**
+ * Get value from hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @param hash Full hash of key
+ * @return Value pointer (or NULL if not found)
+ */
+void* hash_table_compact_lookup(const hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Prefetch the first index slot probed for a hash
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ */
+void hash_table_compact_prefetch_slot(const hash_table* ht, uint32_t hash);
+
+/**
+ * Prefetch the entry the first index slot probed for a hash points to
+ * (best after hash_table_compact_prefetch_slot() had time to complete)
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ */
+void hash_table_compact_prefetch_entry(const hash_table* ht, uint32_t hash);
+
+/**
+ * Delete entry from hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to delete
+ * @param hash Full hash of key
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_del(hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Get the next live entry, in insertion order
+ *
+ * @param ht Hash table
+ * @param pos Position in entries array to start at (updated to after the returned entry)
+ * @return Entry (or NULL if there are no more)
+ */
+const hash_table_entry* hash_table_compact_next(const hash_table* ht, size_t* pos);
+
+/**
+ * Iterate all entries, in insertion order
+ *
+ * @param ht Hash table
+ * @param iter_func Iterator callback function
+ * @param iter_func_user_arg Optional argument to pass to callback function
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+);
+
+/**
+ * Release all entries and free the entries array and index
+ *
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_compact_destroy(hash_table* ht);
+
+#endif
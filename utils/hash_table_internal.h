@@ -0,0 +1,58 @@
+#ifndef __HASH_TABLE_INTERNAL_H__
+#define __HASH_TABLE_INTERNAL_H__
+
+/**
+ * hash_table internals shared with its backends and wrappers
+ */
+
+#include "hash_table.h"
+
+/**
+ * Free what the copy of an entry stored in a slot or node owns
+ * (the key and value of must_destroy entries, and the block holding them if
+ * the entry came from hash_table_init_entry())
+ *
+ * @param copy Stored copy of an entry set with hash_table_set_entry()
+ */
+void hash_table_release_entry_copy(const hash_table_entry* copy);
+
+/*
+ * Entry points taking a key hash computed beforehand with
+ * hash_table_hash_key(), for wrappers that hash keys themselves (e.g. to pick
+ * a shard) and shouldn't pay for hashing them twice
+ *
+ * Only for initialized chained, open addressing and compact tables (not RCU)
+ */
+
+/**
+ * Set value in hash table, like hash_table_set()
+ *
+ * @param ht Hash table
+ * @param key Pointer to key
+ * @param value Pointer to value
+ * @param hash Full hash of key
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_set_hashed(hash_table* ht, void* key, void* value, uint32_t hash);
+
+/**
+ * Get value from hash table without modifying it, like hash_table_lookup()
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @param hash Full hash of key
+ * @return Value pointer (or NULL if not found)
+ */
+void* hash_table_lookup_hashed(const hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Delete entry from hash table, like hash_table_del()
+ *
+ * @param ht Hash table
+ * @param key Entry key to delete
+ * @param hash Full hash of key
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_del_hashed(hash_table* ht, const void* key, uint32_t hash);
+
+#endif
@@ -0,0 +1,820 @@
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "hash_table_internal.h"
+#include "hash_table_open.h"
+#include "wyhash.h"
+
+/**
+ * Number of control bytes (slots) probed at a time
+ */
+#define GROUP_SIZE 16
+
+/**
+ * Control byte: slot has never been used (ends a probe sequence)
+ */
+#define CTRL_EMPTY ((int8_t)-128)
+
+/**
+ * Control byte: slot held an entry that was deleted (tombstone)
+ */
+#define CTRL_DELETED ((int8_t)-2)
+
+/**
+ * Number of slots migrated by every set/get/del during an incremental rehash
+ */
+#define REHASH_STEP_SLOTS GROUP_SIZE
+
+/**
+ * Seed for hashing fixed-size keys
+ * Picked when the first table is initialized, so threads sharing a table
+ * never race on it
+ */
+static uint32_t fixed_hash_seed;
+
+static pthread_once_t fixed_hash_seed_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Pick the seed for hashing fixed-size keys (once per process)
+ */
+static void init_fixed_hash_seed(void) {
+    fixed_hash_seed = rand();
+}
+
+/**
+ * Mix all bits of a 64-bit value into a 32-bit hash (murmur3 64-bit finalizer)
+ *
+ * @param k Value to mix
+ * @return Hash value
+ */
+static uint32_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+
+    return (uint32_t)k;
+}
+
+/**
+ * Hash a fixed-size key
+ * Common key sizes (IPv4 addresses, MAC addresses, 64-bit integers) are
+ * loaded as integers and mixed directly instead of going through wyhash
+ *
+ * @param key Key to hash
+ * @param key_size Size of key
+ * @return Hash value
+ */
+static uint32_t fixed_key_hash(const void* key, const size_t key_size) {
+    const uint64_t seed = fixed_hash_seed;
+
+    switch (key_size) {
+        case 4: {
+            uint32_t k;
+            memcpy(&k, key, sizeof(k));
+            return fmix64(k ^ seed);
+        }
+        case 6: {
+            uint32_t lo;
+            uint16_t hi;
+            memcpy(&lo, key, sizeof(lo));
+            memcpy(&hi, (const uint8_t *)key + sizeof(lo), sizeof(hi));
+            return fmix64(((uint64_t)hi << 32 | lo) ^ seed);
+        }
+        case 8: {
+            uint64_t k;
+            memcpy(&k, key, sizeof(k));
+            return fmix64(k ^ seed);
+        }
+        default:
+            return (uint32_t)wyhash(key, key_size, seed);
+    }
+}
+
+/**
+ * Compare two fixed-size keys
+ *
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_size Size of both keys
+ * @return 1 if equal, 0 if not
+ */
+static int fixed_key_equals(const void* key_a, const void* key_b, const size_t key_size) {
+    switch (key_size) {
+        case 4: {
+            uint32_t a, b;
+            memcpy(&a, key_a, sizeof(a));
+            memcpy(&b, key_b, sizeof(b));
+            return a == b;
+        }
+        case 6: {
+            uint32_t a_lo, b_lo;
+            uint16_t a_hi, b_hi;
+            memcpy(&a_lo, key_a, sizeof(a_lo));
+            memcpy(&b_lo, key_b, sizeof(b_lo));
+            memcpy(&a_hi, (const uint8_t *)key_a + sizeof(a_lo), sizeof(a_hi));
+            memcpy(&b_hi, (const uint8_t *)key_b + sizeof(b_lo), sizeof(b_hi));
+            return a_lo == b_lo && a_hi == b_hi;
+        }
+        case 8: {
+            uint64_t a, b;
+            memcpy(&a, key_a, sizeof(a));
+            memcpy(&b, key_b, sizeof(b));
+            return a == b;
+        }
+        default:
+            return memcmp(key_a, key_b, key_size) == 0;
+    }
+}
+
+/**
+ * Compute the full hash of a key
+ * The slot position comes from the high bits and the control byte tag from
+ * the low 7 bits
+ *
+ * @param ht Hash table
+ * @param key Key to hash
+ * @return Hash value
+ */
+static uint32_t full_hash(const hash_table* ht, const void* key) {
+    if (ht->key_size != 0) {
+        return fixed_key_hash(key, ht->key_size);
+    }
+
+    return (*ht->key_hash)(key);
+}
+
+/**
+ * Get a slot of a slot array
+ *
+ * @param ht Hash table (for slot size)
+ * @param slots Slot array
+ * @param slot Slot index
+ * @return Slot (a hash_table_entry, or hash + key + value for fixed-size keys)
+ */
+static uint8_t* slot_at(const hash_table* ht, void* slots, const size_t slot) {
+    return (uint8_t *)slots + slot * ht->slot_size;
+}
+
+/**
+ * Get the full hash stored in a slot
+ *
+ * @param ht Hash table
+ * @param p_slot Slot
+ * @return Hash value
+ */
+static uint32_t slot_hash(const hash_table* ht, const uint8_t* p_slot) {
+    if (ht->key_size != 0) {
+        return *(const uint32_t *)p_slot;
+    }
+
+    return ((const hash_table_entry *)p_slot)->hash;
+}
+
+/**
+ * Check if a slot holds a key
+ *
+ * @param ht Hash table
+ * @param p_slot Slot
+ * @param key Key to compare
+ * @return 1 if the slot holds key, 0 if not
+ */
+static int slot_key_equals(const hash_table* ht, const uint8_t* p_slot, const void* key) {
+    if (ht->key_size != 0) {
+        return fixed_key_equals(p_slot + ht->key_offset, key, ht->key_size);
+    }
+
+    return (*ht->key_cmp)(((const hash_table_entry *)p_slot)->key, key) == 0;
+}
+
+/**
+ * Control byte tag for a hash (H2)
+ *
+ * @param hash Hash value
+ * @return Tag stored in ctrl for an occupied slot (0-127)
+ */
+static int8_t hash_tag(const uint32_t hash) {
+    return (int8_t)(hash & 0x7F);
+}
+
+/**
+ * First group to probe for a hash (H1)
+ *
+ * @param capacity Number of slots
+ * @param hash Hash value
+ * @return Group index
+ */
+static size_t hash_group(const size_t capacity, const uint32_t hash) {
+    return (hash >> 7) & (capacity / GROUP_SIZE - 1);
+}
+
+#ifdef __SSE2__
+
+/**
+ * Match control bytes in a group against a tag
+ *
+ * @param ctrl First control byte of group
+ * @param tag Tag to match
+ * @return Bit mask of matching slots
+ */
+static uint32_t group_match(const int8_t* ctrl, const int8_t tag) {
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), group));
+}
+
+/**
+ * Match empty or deleted slots in a group
+ * Both have their sign bit set, unlike tags of occupied slots
+ *
+ * @param ctrl First control byte of group
+ * @return Bit mask of free slots
+ */
+static uint32_t group_match_free(const int8_t* ctrl) {
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#else
+
+static uint32_t group_match(const int8_t* ctrl, const int8_t tag) {
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; ++i) {
+        mask |= (uint32_t)(ctrl[i] == tag) << i;
+    }
+
+    return mask;
+}
+
+static uint32_t group_match_free(const int8_t* ctrl) {
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; ++i) {
+        mask |= (uint32_t)(ctrl[i] < 0) << i;
+    }
+
+    return mask;
+}
+
+#endif
+
+/**
+ * Round a requested slot count up to a power of 2 (minimum of one group)
+ *
+ * @param size Requested number of slots
+ * @return Slot count
+ */
+static size_t round_capacity(const size_t size) {
+    size_t capacity = GROUP_SIZE;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+/**
+ * Find the slot holding a key
+ *
+ * @param ht Hash table (for key comparator and slot layout)
+ * @param ctrl Control bytes to probe
+ * @param slots Slot array to probe
+ * @param capacity Number of slots
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @return Slot index (or -1 if not found)
+ */
+static size_t find_slot(
+    const hash_table* ht,
+    const int8_t* ctrl,
+    void* slots,
+    const size_t capacity,
+    const void* key,
+    const uint32_t hash
+) {
+    const size_t group_mask = capacity / GROUP_SIZE - 1;
+    const int8_t tag = hash_tag(hash);
+    size_t group = hash_group(capacity, hash);
+
+    // Triangular probing visits every group once when the group count is a power of 2
+    for (size_t step = 1; step <= group_mask + 1; ++step) {
+        const int8_t* p_ctrl = ctrl + group * GROUP_SIZE;
+
+        uint32_t match = group_match(p_ctrl, tag);
+        while (match != 0) {
+            const size_t slot = group * GROUP_SIZE + __builtin_ctz(match);
+            const uint8_t* p_slot = slot_at(ht, slots, slot);
+            if (slot_hash(ht, p_slot) == hash && slot_key_equals(ht, p_slot, key)) {
+                return slot;
+            }
+
+            match &= match - 1;
+        }
+
+        if (group_match(p_ctrl, CTRL_EMPTY) != 0) {
+            // An empty slot ends the probe sequence
+            return -1;
+        }
+
+        group = (group + step) & group_mask;
+    }
+
+    return -1;
+}
+
+/**
+ * Find the first empty or deleted slot in the probe sequence of a hash
+ *
+ * @param ctrl Control bytes to probe (must have at least one free slot)
+ * @param capacity Number of slots
+ * @param hash Full hash
+ * @return Slot index
+ */
+static size_t find_free_slot(const int8_t* ctrl, const size_t capacity, const uint32_t hash) {
+    const size_t group_mask = capacity / GROUP_SIZE - 1;
+    size_t group = hash_group(capacity, hash);
+
+    for (size_t step = 1;; ++step) {
+        const uint32_t match = group_match_free(ctrl + group * GROUP_SIZE);
+        if (match != 0) {
+            return group * GROUP_SIZE + __builtin_ctz(match);
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+/**
+ * Free the key/value copies owned by a slot
+ * Slots of fixed-size key tables own nothing outside the slot array
+ *
+ * @param ht Hash table
+ * @param p_slot Slot
+ */
+static void release_slot(const hash_table* ht, const uint8_t* p_slot) {
+    if (ht->key_size == 0) {
+        hash_table_release_entry_copy((const hash_table_entry *)p_slot);
+    }
+}
+
+/**
+ * Allocate empty slot and control byte arrays
+ *
+ * @param ht Hash table (for slot size)
+ * @param capacity Number of slots
+ * @param ctrl Output control byte array
+ * @param slots Output slot array
+ * @return 0 on success, -1 on failure
+ */
+static int alloc_slots(const hash_table* ht, const size_t capacity, int8_t** ctrl, void** slots) {
+    *ctrl = malloc(capacity);
+    *slots = malloc(capacity * ht->slot_size);
+
+    if (*ctrl == NULL || *slots == NULL) {
+        perror("hash_table_open: malloc() failed");
+        free(*ctrl);
+        free(*slots);
+        return -1;
+    }
+
+    memset(*ctrl, CTRL_EMPTY, capacity);
+
+    return 0;
+}
+
+/**
+ * Round a size up to a multiple of an alignment
+ *
+ * @param size Size
+ * @param align Alignment (power of 2)
+ * @return Aligned size
+ */
+static size_t align_up(const size_t size, const size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+/**
+ * Alignment of a field stored inline in a slot
+ * Fields are aligned like the largest integer type that fits in them
+ *
+ * @param size Size of field
+ * @return Alignment (power of 2)
+ */
+static size_t field_align(const size_t size) {
+    size_t align = 1;
+    while (align * 2 <= size && align < _Alignof(max_align_t)) {
+        align <<= 1;
+    }
+
+    return align;
+}
+
+/**
+ * Compute the slot layout from the key and value sizes
+ * Fixed-size key slots hold the hash, then the key, then the value
+ *
+ * @param ht Hash table
+ */
+static void init_slot_layout(hash_table* ht) {
+    if (ht->key_size == 0) {
+        ht->slot_size = sizeof(hash_table_entry);
+        return;
+    }
+
+    const size_t key_align = field_align(ht->key_size);
+    const size_t value_align = field_align(ht->value_size);
+
+    size_t slot_align = _Alignof(uint32_t);
+    if (key_align > slot_align) {
+        slot_align = key_align;
+    }
+    if (value_align > slot_align) {
+        slot_align = value_align;
+    }
+
+    ht->key_offset = align_up(sizeof(uint32_t), key_align);
+    ht->value_offset = align_up(ht->key_offset + ht->key_size, value_align);
+    ht->slot_size = align_up(ht->value_offset + ht->value_size, slot_align);
+}
+
+int hash_table_open_init(hash_table* ht, const size_t size) {
+    const size_t capacity = round_capacity(size);
+
+    pthread_once(&fixed_hash_seed_once, init_fixed_hash_seed);
+    init_slot_layout(ht);
+
+    if (alloc_slots(ht, capacity, &ht->ctrl, &ht->slots) != 0) {
+        return -1;
+    }
+
+    ht->index_size = capacity;
+    ht->entry_size = 0;
+    ht->tombstone_size = 0;
+
+    return 0;
+}
+
+/**
+ * Maximum number of occupied + deleted slots before the table must grow
+ *
+ * @param ht Hash table
+ * @param capacity Number of slots
+ * @return Max load (always leaves at least one empty slot)
+ */
+static size_t max_load(const hash_table* ht, const size_t capacity) {
+    const size_t load = (size_t)(capacity * ht->max_load_factor);
+    return load < capacity ? load : capacity - 1;
+}
+
+/**
+ * Move the entry in a slot of the previous slot array to the current one
+ * No keys are hashed or compared: the hash is stored in the slot and keys
+ * are already unique
+ *
+ * @param ht Hash table
+ * @param old_slot Slot index in previous slot array
+ */
+static void migrate_slot(hash_table* ht, const size_t old_slot) {
+    const uint8_t* p_old_slot = slot_at(ht, ht->rehash_slots, old_slot);
+    const uint32_t hash = slot_hash(ht, p_old_slot);
+    const size_t slot = find_free_slot(ht->ctrl, ht->index_size, hash);
+
+    if (ht->ctrl[slot] == CTRL_DELETED) {
+        --ht->tombstone_size;
+    }
+
+    ht->ctrl[slot] = hash_tag(hash);
+    memcpy(slot_at(ht, ht->slots, slot), p_old_slot, ht->slot_size);
+
+    // Keep probe sequences through the previous slot array intact
+    ht->rehash_ctrl[old_slot] = CTRL_DELETED;
+}
+
+/**
+ * Migrate a few slots of an in-progress incremental rehash
+ *
+ * @param ht Hash table
+ * @param slot_count Max number of slots to migrate
+ */
+static void rehash_step(hash_table* ht, size_t slot_count) {
+    if (ht->rehash_ctrl == NULL) {
+        return;
+    }
+
+    for (; slot_count > 0 && ht->rehash_pos < ht->rehash_index_size; --slot_count) {
+        const size_t old_slot = ht->rehash_pos++;
+        if (ht->rehash_ctrl[old_slot] >= 0) {
+            migrate_slot(ht, old_slot);
+        }
+    }
+
+    if (ht->rehash_pos == ht->rehash_index_size) {
+        // Done
+        free(ht->rehash_ctrl);
+        free(ht->rehash_slots);
+        ht->rehash_ctrl = NULL;
+        ht->rehash_slots = NULL;
+        ht->rehash_index_size = 0;
+        ht->rehash_pos = 0;
+    }
+}
+
+/**
+ * Start an incremental rehash into a new slot array
+ * Any rehash already in progress is completed first
+ *
+ * @param ht Hash table
+ * @param new_size Requested number of slots
+ * @return 0 on success, -1 on failure
+ */
+static int start_rehash(hash_table* ht, const size_t new_size) {
+    int8_t* new_ctrl;
+    void* new_slots;
+
+    rehash_step(ht, SIZE_MAX);
+
+    // Never shrink below what the current entries need
+    size_t capacity = round_capacity(new_size);
+    while (ht->entry_size >= max_load(ht, capacity)) {
+        capacity <<= 1;
+    }
+
+    if (alloc_slots(ht, capacity, &new_ctrl, &new_slots) != 0) {
+        return -1;
+    }
+
+    ht->rehash_ctrl = ht->ctrl;
+    ht->rehash_slots = ht->slots;
+    ht->rehash_index_size = ht->index_size;
+    ht->rehash_pos = 0;
+
+    ht->ctrl = new_ctrl;
+    ht->slots = new_slots;
+    ht->index_size = capacity;
+    ht->tombstone_size = 0;
+
+    return 0;
+}
+
+int hash_table_open_rehash(hash_table* ht, const size_t new_size) {
+    if (start_rehash(ht, new_size) != 0) {
+        return -1;
+    }
+
+    rehash_step(ht, SIZE_MAX);
+
+    return 0;
+}
+
+/**
+ * Make room for one more entry if the table reached its maximum load factor
+ * Rehashes at the same size when most of the load is tombstones, doubles otherwise
+ *
+ * The new slot array has room for at least twice the migrated entries, and
+ * every insert migrates a group of slots, so migration always completes
+ * before the new slot array fills up
+ *
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+static int reserve_slot(hash_table* ht) {
+    const size_t load = max_load(ht, ht->index_size);
+    if (ht->entry_size + ht->tombstone_size < load) {
+        return 0;
+    }
+
+    if (ht->entry_size < load / 2) {
+        return start_rehash(ht, ht->index_size);
+    }
+
+    return start_rehash(ht, ht->index_size * 2);
+}
+
+/**
+ * Find the slot holding a key in the current slot array, or in the
+ * previous one if a rehash is in progress
+ *
+ * @param ht Hash table
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @param p_ctrl Output control byte of slot
+ * @return Slot (or NULL if not found)
+ */
+static uint8_t* lookup(const hash_table* ht, const void* key, const uint32_t hash, int8_t** p_ctrl) {
+    size_t slot = find_slot(ht, ht->ctrl, ht->slots, ht->index_size, key, hash);
+    if (slot != -1) {
+        *p_ctrl = &ht->ctrl[slot];
+        return slot_at(ht, ht->slots, slot);
+    }
+
+    if (ht->rehash_ctrl != NULL) {
+        slot = find_slot(ht, ht->rehash_ctrl, ht->rehash_slots, ht->rehash_index_size, key, hash);
+        if (slot != -1) {
+            *p_ctrl = &ht->rehash_ctrl[slot];
+            return slot_at(ht, ht->rehash_slots, slot);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Store an entry in a slot
+ * Fixed-size key tables copy the key and value into the slot itself
+ *
+ * @param ht Hash table
+ * @param p_slot Slot
+ * @param entry Entry to store
+ * @param hash Full hash of key
+ */
+static void store_slot(const hash_table* ht, uint8_t* p_slot, const hash_table_entry* entry, const uint32_t hash) {
+    if (ht->key_size == 0) {
+        hash_table_entry* slot = (hash_table_entry *)p_slot;
+        *slot = *entry;
+        slot->hash = hash;
+        return;
+    }
+
+    *(uint32_t *)p_slot = hash;
+    memcpy(p_slot + ht->key_offset, entry->key, ht->key_size);
+
+    if (entry->value != NULL) {
+        memcpy(p_slot + ht->value_offset, entry->value, ht->value_size);
+    }
+    else {
+        memset(p_slot + ht->value_offset, 0, ht->value_size);
+    }
+}
+
+int hash_table_open_set_entry(hash_table* ht, const hash_table_entry* entry, const uint32_t hash) {
+    int8_t* p_ctrl;
+
+    rehash_step(ht, REHASH_STEP_SLOTS);
+
+    uint8_t* p_slot = lookup(ht, entry->key, hash, &p_ctrl);
+    if (p_slot != NULL) {
+        // Replace existing entry
+        release_slot(ht, p_slot);
+        store_slot(ht, p_slot, entry, hash);
+        return 0;
+    }
+
+    if (reserve_slot(ht) != 0) {
+        return -1;
+    }
+
+    const size_t slot = find_free_slot(ht->ctrl, ht->index_size, hash);
+    if (ht->ctrl[slot] == CTRL_DELETED) {
+        --ht->tombstone_size;
+    }
+
+    ht->ctrl[slot] = hash_tag(hash);
+    store_slot(ht, slot_at(ht, ht->slots, slot), entry, hash);
+    ++ht->entry_size;
+
+    return 0;
+}
+
+void* hash_table_open_get(hash_table* ht, const void* key, const uint32_t hash) {
+    rehash_step(ht, REHASH_STEP_SLOTS);
+
+    return hash_table_open_lookup(ht, key, hash);
+}
+
+void* hash_table_open_lookup(const hash_table* ht, const void* key, const uint32_t hash) {
+    int8_t* p_ctrl;
+
+    uint8_t* p_slot = lookup(ht, key, hash, &p_ctrl);
+    if (p_slot == NULL) {
+        return NULL;
+    }
+
+    if (ht->key_size != 0) {
+        return p_slot + ht->value_offset;
+    }
+
+    return ((hash_table_entry *)p_slot)->value;
+}
+
+void hash_table_open_prefetch_group(const hash_table* ht, const uint32_t hash) {
+    __builtin_prefetch(ht->ctrl + hash_group(ht->index_size, hash) * GROUP_SIZE);
+}
+
+void hash_table_open_prefetch_slot(const hash_table* ht, const uint32_t hash) {
+    const size_t group = hash_group(ht->index_size, hash);
+    const uint32_t match = group_match(ht->ctrl + group * GROUP_SIZE, hash_tag(hash));
+
+    if (match != 0) {
+        __builtin_prefetch(slot_at(ht, ht->slots, group * GROUP_SIZE + __builtin_ctz(match)));
+    }
+}
+
+uint32_t hash_table_open_hash_key(const hash_table* ht, const void* key) {
+    return full_hash(ht, key);
+}
+
+int hash_table_open_del(hash_table* ht, const void* key, const uint32_t hash) {
+    int8_t* p_ctrl;
+
+    rehash_step(ht, REHASH_STEP_SLOTS);
+
+    const uint8_t* p_slot = lookup(ht, key, hash, &p_ctrl);
+    if (p_slot == NULL) {
+        return -1;
+    }
+
+    // Slots are marked deleted rather than emptied so probe sequences that
+    // pass through them stay intact
+    if (p_ctrl >= ht->ctrl && p_ctrl < ht->ctrl + ht->index_size) {
+        ++ht->tombstone_size;
+    }
+
+    *p_ctrl = CTRL_DELETED;
+    --ht->entry_size;
+
+    release_slot(ht, p_slot);
+
+    return 0;
+}
+
+/**
+ * Get the entry held by an occupied slot
+ *
+ * @param ht Hash table
+ * @param p_slot Slot
+ * @param scratch Entry to present inline keys and values with (fixed-size keys)
+ * @return Entry
+ */
+static const hash_table_entry* slot_entry(const hash_table* ht, uint8_t* p_slot, hash_table_entry* scratch) {
+    if (ht->key_size == 0) {
+        return (const hash_table_entry *)p_slot;
+    }
+
+    // Present inline keys and values as a regular entry
+    scratch->key = p_slot + ht->key_offset;
+    scratch->value = p_slot + ht->value_offset;
+    scratch->hash = slot_hash(ht, p_slot);
+    scratch->must_destroy = 0;
+    scratch->pooled = 0;
+
+    return scratch;
+}
+
+void hash_table_open_finish_rehash(hash_table* ht) {
+    rehash_step(ht, SIZE_MAX);
+}
+
+const hash_table_entry* hash_table_open_next(const hash_table* ht, size_t* pos, hash_table_entry* scratch) {
+    while (*pos < ht->index_size) {
+        const size_t slot = (*pos)++;
+        if (ht->ctrl[slot] >= 0) {
+            return slot_entry(ht, slot_at(ht, ht->slots, slot), scratch);
+        }
+    }
+
+    return NULL;
+}
+
+int hash_table_open_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+) {
+    hash_table_entry entry;
+
+    // Iterate a single, stable slot array
+    rehash_step(ht, SIZE_MAX);
+
+    for (size_t i = 0; i < ht->index_size; ++i) {
+        if (ht->ctrl[i] >= 0) {
+            iter_func(slot_entry(ht, slot_at(ht, ht->slots, i), &entry), i, iter_func_user_arg);
+        }
+    }
+
+    return 0;
+}
+
+int hash_table_open_destroy(hash_table* ht) {
+    rehash_step(ht, SIZE_MAX);
+
+    for (size_t i = 0; i < ht->index_size; ++i) {
+        if (ht->ctrl[i] >= 0) {
+            release_slot(ht, slot_at(ht, ht->slots, i));
+        }
+    }
+
+    free(ht->ctrl);
+    free(ht->slots);
+    ht->ctrl = NULL;
+    ht->slots = NULL;
+
+    ht->entry_size = 0;
+    ht->tombstone_size = 0;
+
+    return 0;
+}
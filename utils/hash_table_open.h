@@ -0,0 +1,138 @@
+#ifndef __HASH_TABLE_OPEN_H__
+#define __HASH_TABLE_OPEN_H__
+
+/**
+ * Open addressing backend for hash_table (HASH_TABLE_OPEN)
+ *
+ * Not meant to be used directly: the hash_table_* functions dispatch here
+ * when the table was created with hash_table_init_open()
+ */
+
+#include "hash_table.h"
+
+/**
+ * Allocate the slot and control byte arrays
+ *
+ * @param ht Hash table (with key_cmp/key_hash already set)
+ * @param size Requested number of slots
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_init(hash_table* ht, size_t size);
+
+/**
+ * Resize the slot array and reinsert all entries
+ * Completes before returning (automatic growth is incremental instead)
+ *
+ * @param ht Hash table
+ * @param new_size Requested number of slots
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_rehash(hash_table* ht, size_t new_size);
+
+/**
+ * Copy an entry into its slot, replacing any entry with the same key
+ *
+ * @param ht Hash table
+ * @param entry Entry to copy (key/value ownership moves to the table)
+ * @param hash Full hash of entry key (hash_table_open_hash_key())
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_set_entry(hash_table* ht, const hash_table_entry* entry, uint32_t hash);
+
+/**
+ * Get value from hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @param hash Full hash of key
+ * @return Value pointer (or NULL if not found)
+ */
+void* hash_table_open_get(hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Get value from hash table without migrating any slots
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @param hash Full hash of key
+ * @return Value pointer (or NULL if not found)
+ */
+void* hash_table_open_lookup(const hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Prefetch the first control byte group probed for a hash
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ */
+void hash_table_open_prefetch_group(const hash_table* ht, uint32_t hash);
+
+/**
+ * Prefetch the first slot of the first group probed for a hash whose tag
+ * matches (best after hash_table_open_prefetch_group() had time to complete)
+ *
+ * @param ht Hash table
+ * @param hash Full hash of key
+ */
+void hash_table_open_prefetch_slot(const hash_table* ht, uint32_t hash);
+
+/**
+ * Compute the full hash of a key
+ *
+ * @param ht Hash table
+ * @param key Key to hash
+ * @return Hash value
+ */
+uint32_t hash_table_open_hash_key(const hash_table* ht, const void* key);
+
+/**
+ * Delete entry from hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to delete
+ * @param hash Full hash of key
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_del(hash_table* ht, const void* key, uint32_t hash);
+
+/**
+ * Complete any in-progress incremental rehash
+ *
+ * @param ht Hash table
+ */
+void hash_table_open_finish_rehash(hash_table* ht);
+
+/**
+ * Get the entry of the next occupied slot
+ * Only sees the current slot array: finish any rehash first
+ *
+ * @param ht Hash table
+ * @param pos Slot to start at (updated to after the returned slot)
+ * @param scratch Entry to present inline keys and values with (fixed-size keys)
+ * @return Entry (or NULL if there are no more)
+ */
+const hash_table_entry* hash_table_open_next(const hash_table* ht, size_t* pos, hash_table_entry* scratch);
+
+/**
+ * Iterate all occupied slots
+ *
+ * @param ht Hash table
+ * @param iter_func Iterator callback function
+ * @param iter_func_user_arg Optional argument to pass to callback function
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+);
+
+/**
+ * Release all entries and free the slot and control byte arrays
+ *
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_open_destroy(hash_table* ht);
+
+#endif
@@ -0,0 +1,428 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hash_table_internal.h"
+#include "hash_table_rcu.h"
+#include "epoch.h"
+
+/**
+ * Node of a bucket chain
+ * Nodes are immutable once published: writers replace them instead
+ */
+typedef struct rcu_node {
+    hash_table_entry entry;
+    struct rcu_node* next;
+} rcu_node;
+
+/**
+ * Version of the bucket array
+ * Buckets are swapped in place by writers, the array itself only when the
+ * table is rehashed
+ */
+typedef struct rcu_index {
+    size_t size;
+    _Atomic(rcu_node*) buckets[];
+} rcu_index;
+
+/**
+ * RCU state of a hash table
+ */
+struct hash_table_rcu {
+    /**
+     * Current bucket array (read by readers without any lock)
+     */
+    _Atomic(rcu_index*) index;
+
+    /**
+     * Serializes writers
+     */
+    pthread_mutex_t write_lock;
+};
+
+/**
+ * Round a bucket count up to a power of 2
+ *
+ * @param size Requested bucket count
+ * @return Bucket count
+ */
+static size_t round_index_size(const size_t size) {
+    size_t index_size = 1;
+    while (index_size < size) {
+        index_size <<= 1;
+    }
+
+    return index_size;
+}
+
+/**
+ * Allocate an empty bucket array
+ *
+ * @param size Bucket count (power of 2)
+ * @return Bucket array (or NULL on failure)
+ */
+static rcu_index* alloc_index(const size_t size) {
+    rcu_index* p_index = calloc(1, sizeof(rcu_index) + size * sizeof(p_index->buckets[0]));
+    if (p_index == NULL) {
+        perror("hash_table_rcu: calloc() failed");
+        return NULL;
+    }
+
+    p_index->size = size;
+
+    return p_index;
+}
+
+/**
+ * Get the bucket of a hash
+ *
+ * @param p_index Bucket array
+ * @param hash Full hash of key
+ * @return Bucket
+ */
+static _Atomic(rcu_node*)* bucket_at(rcu_index* p_index, const uint32_t hash) {
+    return &p_index->buckets[hash & (p_index->size - 1)];
+}
+
+/**
+ * Free a node that was replaced by a copy (the copy now owns the entry)
+ *
+ * @param node Node
+ */
+static void free_node(void* node) {
+    free(node);
+}
+
+/**
+ * Free a node along with the key/value copies owned by its entry
+ *
+ * @param node Node
+ */
+static void free_node_entry(void* node) {
+    const rcu_node* p_node = node;
+
+    hash_table_release_entry_copy(&p_node->entry);
+    free(node);
+}
+
+/**
+ * Free all nodes of a chain, but not their entries
+ *
+ * @param p_node First node of chain
+ */
+static void free_chain(rcu_node* p_node) {
+    while (p_node != NULL) {
+        rcu_node* p_next = p_node->next;
+        free(p_node);
+        p_node = p_next;
+    }
+}
+
+/**
+ * Free a bucket array and all nodes in it
+ * Nodes are copies whose entries are owned by the next version
+ *
+ * @param index Bucket array
+ */
+static void free_index(void* index) {
+    rcu_index* p_index = index;
+
+    for (size_t i = 0; i < p_index->size; ++i) {
+        free_chain(atomic_load_explicit(&p_index->buckets[i], memory_order_relaxed));
+    }
+
+    free(p_index);
+}
+
+/**
+ * Find the node holding a key in a chain
+ *
+ * @param ht Hash table
+ * @param p_head First node of chain
+ * @param key Key to find
+ * @param hash Full hash of key
+ * @return Node (or NULL if not found)
+ */
+static rcu_node* find_node(const hash_table* ht, rcu_node* p_head, const void* key, const uint32_t hash) {
+    for (rcu_node* p_node = p_head; p_node != NULL; p_node = p_node->next) {
+        if (p_node->entry.hash == hash && (*ht->key_cmp)(p_node->entry.key, key) == 0) {
+            return p_node;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Build a new version of a chain, without one of its nodes
+ * Nodes before the removed node are copied, nodes after it are shared with
+ * the current version
+ *
+ * @param p_head First node of chain
+ * @param p_target Node to remove
+ * @param p_replacement Node to put in place of p_target (or NULL)
+ * @param p_new_head Output first node of new chain
+ * @return 0 on success, -1 on failure
+ */
+static int rebuild_chain(
+    rcu_node* p_head,
+    const rcu_node* p_target,
+    rcu_node* p_replacement,
+    rcu_node** p_new_head
+) {
+    rcu_node** p_next = p_new_head;
+
+    for (const rcu_node* p_node = p_head; p_node != p_target; p_node = p_node->next) {
+        rcu_node* p_copy = malloc(sizeof(rcu_node));
+        if (p_copy == NULL) {
+            perror("hash_table_rcu: malloc() failed");
+            *p_next = NULL;
+            free_chain(*p_new_head);
+            return -1;
+        }
+
+        p_copy->entry = p_node->entry;
+        *p_next = p_copy;
+        p_next = &p_copy->next;
+    }
+
+    if (p_replacement != NULL) {
+        p_replacement->next = p_target->next;
+        *p_next = p_replacement;
+    }
+    else {
+        *p_next = p_target->next;
+    }
+
+    return 0;
+}
+
+/**
+ * Retire the nodes of the previous version of a chain up to a removed node
+ *
+ * @param p_head First node of previous chain
+ * @param p_target Removed node (released along with its entry)
+ */
+static void retire_chain(rcu_node* p_head, rcu_node* p_target) {
+    while (p_head != p_target) {
+        rcu_node* p_next = p_head->next;
+        epoch_retire(p_head, free_node);
+        p_head = p_next;
+    }
+
+    epoch_retire(p_target, free_node_entry);
+}
+
+/**
+ * Build and publish a new bucket array holding copies of all nodes
+ * Must be called with the write lock held
+ *
+ * @param ht Hash table
+ * @param new_size Bucket count (power of 2)
+ * @return 0 on success, -1 on failure
+ */
+static int publish_index(hash_table* ht, const size_t new_size) {
+    rcu_index* p_old_index = atomic_load_explicit(&ht->rcu->index, memory_order_relaxed);
+    rcu_index* p_new_index = alloc_index(new_size);
+    if (p_new_index == NULL) {
+        return -1;
+    }
+
+    // Readers may still be walking the old chains, so nodes are copied rather than relinked
+    for (size_t i = 0; i < p_old_index->size; ++i) {
+        const rcu_node* p_node = atomic_load_explicit(&p_old_index->buckets[i], memory_order_relaxed);
+        for (; p_node != NULL; p_node = p_node->next) {
+            rcu_node* p_copy = malloc(sizeof(rcu_node));
+            if (p_copy == NULL) {
+                perror("hash_table_rcu: malloc() failed");
+                free_index(p_new_index);
+                return -1;
+            }
+
+            _Atomic(rcu_node*)* p_bucket = bucket_at(p_new_index, p_node->entry.hash);
+            p_copy->entry = p_node->entry;
+            p_copy->next = atomic_load_explicit(p_bucket, memory_order_relaxed);
+            atomic_store_explicit(p_bucket, p_copy, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&ht->rcu->index, p_new_index, memory_order_release);
+    ht->index_size = new_size;
+
+    epoch_retire(p_old_index, free_index);
+
+    return 0;
+}
+
+int hash_table_rcu_init(hash_table* ht, const size_t size) {
+    ht->rcu = malloc(sizeof(struct hash_table_rcu));
+    if (ht->rcu == NULL) {
+        perror("hash_table_rcu: malloc() failed");
+        return -1;
+    }
+
+    rcu_index* p_index = alloc_index(round_index_size(size));
+    if (p_index == NULL) {
+        free(ht->rcu);
+        ht->rcu = NULL;
+        return -1;
+    }
+
+    atomic_init(&ht->rcu->index, p_index);
+    pthread_mutex_init(&ht->rcu->write_lock, NULL);
+
+    ht->index_size = p_index->size;
+    ht->entry_size = 0;
+
+    return 0;
+}
+
+int hash_table_rcu_rehash(hash_table* ht, const size_t new_size) {
+    pthread_mutex_lock(&ht->rcu->write_lock);
+    const int ret = publish_index(ht, round_index_size(new_size));
+    pthread_mutex_unlock(&ht->rcu->write_lock);
+
+    return ret;
+}
+
+int hash_table_rcu_set_entry(hash_table* ht, const hash_table_entry* entry) {
+    const uint32_t hash = (*ht->key_hash)(entry->key);
+    rcu_node* p_new_head;
+
+    rcu_node* p_new_node = malloc(sizeof(rcu_node));
+    if (p_new_node == NULL) {
+        perror("hash_table_rcu: malloc() failed");
+        return -1;
+    }
+
+    p_new_node->entry = *entry;
+    p_new_node->entry.hash = hash;
+    p_new_node->entry.pooled = 0;
+
+    pthread_mutex_lock(&ht->rcu->write_lock);
+
+    rcu_index* p_index = atomic_load_explicit(&ht->rcu->index, memory_order_relaxed);
+    _Atomic(rcu_node*)* p_bucket = bucket_at(p_index, hash);
+    rcu_node* p_head = atomic_load_explicit(p_bucket, memory_order_relaxed);
+
+    rcu_node* p_old_node = find_node(ht, p_head, entry->key, hash);
+    if (p_old_node != NULL) {
+        // Replace existing entry
+        if (rebuild_chain(p_head, p_old_node, p_new_node, &p_new_head) != 0) {
+            pthread_mutex_unlock(&ht->rcu->write_lock);
+            free(p_new_node);
+            return -1;
+        }
+
+        atomic_store_explicit(p_bucket, p_new_head, memory_order_release);
+        retire_chain(p_head, p_old_node);
+
+        pthread_mutex_unlock(&ht->rcu->write_lock);
+        return 0;
+    }
+
+    // New nodes go first, so the rest of the chain is shared with the current version
+    p_new_node->next = p_head;
+    atomic_store_explicit(p_bucket, p_new_node, memory_order_release);
+
+    ++ht->entry_size;
+
+    if (ht->max_load_factor != 0 && ht->entry_size > p_index->size * ht->max_load_factor) {
+        // Failing to grow only makes chains longer
+        publish_index(ht, p_index->size * 2);
+    }
+
+    pthread_mutex_unlock(&ht->rcu->write_lock);
+
+    return 0;
+}
+
+void* hash_table_rcu_get(const hash_table* ht, const void* key) {
+    const uint32_t hash = (*ht->key_hash)(key);
+    void* value = NULL;
+
+    epoch_enter();
+
+    rcu_index* p_index = atomic_load_explicit(&ht->rcu->index, memory_order_acquire);
+    rcu_node* p_head = atomic_load_explicit(bucket_at(p_index, hash), memory_order_acquire);
+
+    const rcu_node* p_node = find_node(ht, p_head, key, hash);
+    if (p_node != NULL) {
+        value = p_node->entry.value;
+    }
+
+    epoch_exit();
+
+    return value;
+}
+
+int hash_table_rcu_del(hash_table* ht, const void* key) {
+    const uint32_t hash = (*ht->key_hash)(key);
+    rcu_node* p_new_head;
+
+    pthread_mutex_lock(&ht->rcu->write_lock);
+
+    rcu_index* p_index = atomic_load_explicit(&ht->rcu->index, memory_order_relaxed);
+    _Atomic(rcu_node*)* p_bucket = bucket_at(p_index, hash);
+    rcu_node* p_head = atomic_load_explicit(p_bucket, memory_order_relaxed);
+
+    rcu_node* p_node = find_node(ht, p_head, key, hash);
+    if (p_node == NULL || rebuild_chain(p_head, p_node, NULL, &p_new_head) != 0) {
+        pthread_mutex_unlock(&ht->rcu->write_lock);
+        return -1;
+    }
+
+    atomic_store_explicit(p_bucket, p_new_head, memory_order_release);
+    retire_chain(p_head, p_node);
+
+    --ht->entry_size;
+
+    pthread_mutex_unlock(&ht->rcu->write_lock);
+
+    return 0;
+}
+
+int hash_table_rcu_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+) {
+    // Writers (including iter_func) never modify the snapshot, and can't free it while we're in it
+    epoch_enter();
+
+    rcu_index* p_index = atomic_load_explicit(&ht->rcu->index, memory_order_acquire);
+    for (size_t i = 0; i < p_index->size; ++i) {
+        const rcu_node* p_node = atomic_load_explicit(&p_index->buckets[i], memory_order_acquire);
+        for (; p_node != NULL; p_node = p_node->next) {
+            iter_func(&p_node->entry, i, iter_func_user_arg);
+        }
+    }
+
+    epoch_exit();
+
+    return 0;
+}
+
+int hash_table_rcu_destroy(hash_table* ht) {
+    rcu_index* p_index = atomic_load_explicit(&ht->rcu->index, memory_order_relaxed);
+
+    for (size_t i = 0; i < p_index->size; ++i) {
+        rcu_node* p_node = atomic_load_explicit(&p_index->buckets[i], memory_order_relaxed);
+        while (p_node != NULL) {
+            rcu_node* p_next = p_node->next;
+            free_node_entry(p_node);
+            p_node = p_next;
+        }
+    }
+
+    free(p_index);
+
+    pthread_mutex_destroy(&ht->rcu->write_lock);
+    free(ht->rcu);
+    ht->rcu = NULL;
+
+    ht->entry_size = 0;
+
+    return 0;
+}
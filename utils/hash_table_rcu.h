@@ -0,0 +1,82 @@
+#ifndef __HASH_TABLE_RCU_H__
+#define __HASH_TABLE_RCU_H__
+
+/**
+ * Read-copy-update backend for hash_table (HASH_TABLE_RCU)
+ *
+ * Not meant to be used directly: the hash_table_* functions dispatch here
+ * when the table was created with hash_table_init_rcu()
+ */
+
+#include "hash_table.h"
+
+/**
+ * Allocate the bucket array and writer lock
+ *
+ * @param ht Hash table (with key_cmp/key_hash already set)
+ * @param size Requested number of buckets
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_init(hash_table* ht, size_t size);
+
+/**
+ * Publish a new bucket array holding all entries
+ *
+ * @param ht Hash table
+ * @param new_size Requested number of buckets
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_rehash(hash_table* ht, size_t new_size);
+
+/**
+ * Copy an entry into a new node, replacing any entry with the same key
+ *
+ * @param ht Hash table
+ * @param entry Entry to copy (key/value ownership moves to the table)
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_set_entry(hash_table* ht, const hash_table_entry* entry);
+
+/**
+ * Get value from hash table without taking any lock
+ *
+ * @param ht Hash table
+ * @param key Entry key to get value for
+ * @return Value pointer (or NULL if not found)
+ */
+void* hash_table_rcu_get(const hash_table* ht, const void* key);
+
+/**
+ * Delete entry from hash table
+ *
+ * @param ht Hash table
+ * @param key Entry key to delete
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_del(hash_table* ht, const void* key);
+
+/**
+ * Iterate a snapshot of all entries
+ *
+ * @param ht Hash table
+ * @param iter_func Iterator callback function
+ * @param iter_func_user_arg Optional argument to pass to callback function
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_iter(
+    hash_table* ht,
+    ht_iter_func iter_func,
+    void* iter_func_user_arg
+);
+
+/**
+ * Release all entries and free the bucket array
+ * Entries that were already replaced or deleted are freed by the epoch
+ * reclaimer
+ *
+ * @param ht Hash table
+ * @return 0 on success, -1 on failure
+ */
+int hash_table_rcu_destroy(hash_table* ht);
+
+#endif
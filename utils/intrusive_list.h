@@ -0,0 +1,291 @@
+#ifndef __INTRUSIVE_LIST_H__
+#define __INTRUSIVE_LIST_H__
+
+/**
+ * Intrusive doubly-linked list (header-only)
+ *
+ * Unlike linked_list, the list doesn't allocate anything: the node is a
+ * member of the caller's struct, and INTRUSIVE_LIST_ENTRY() gets back from a
+ * node to the struct containing it. Any node can be unlinked, or have nodes
+ * inserted next to it, in O(1) through its handle.
+ *
+ * The list is circular around a sentinel node embedded in it, so it must not
+ * be copied or moved once initialized.
+ *
+ * Example:
+ *
+ *     typedef struct conn {
+ *         int fd;
+ *         intrusive_list_node link;
+ *     } conn;
+ *
+ *     intrusive_list conns;
+ *     intrusive_list_init(&conns);
+ *     intrusive_list_push_tail(&conns, &p_conn->link);
+ *
+ *     intrusive_list_node *p_node, *p_next;
+ *     INTRUSIVE_LIST_FOREACH_SAFE(&conns, p_node, p_next) {
+ *         conn* p_conn = INTRUSIVE_LIST_ENTRY(p_node, conn, link);
+ *         if (p_conn->fd < 0) {
+ *             intrusive_list_unlink(&conns, p_node);
+ *             free(p_conn);
+ *         }
+ *     }
+ */
+
+#include <stddef.h>
+
+/**
+ * Intrusive list node (to embed in the listed struct)
+ */
+typedef struct intrusive_list_node {
+    struct intrusive_list_node *prev, *next;
+} intrusive_list_node;
+
+/**
+ * Intrusive list
+ */
+typedef struct intrusive_list {
+    /**
+     * Sentinel: next is the head and prev the tail (itself when empty)
+     */
+    intrusive_list_node sentinel;
+
+    size_t size;
+} intrusive_list;
+
+/**
+ * Get the struct containing a node
+ *
+ * @param node Node
+ * @param type Type of the containing struct
+ * @param member Name of the node member in the struct
+ */
+#define INTRUSIVE_LIST_ENTRY(node, type, member) \
+    ((type *)((char *)(node) - offsetof(type, member)))
+
+/**
+ * Iterate the nodes of a list from head to tail
+ * The current node must not be unlinked (see INTRUSIVE_LIST_FOREACH_SAFE)
+ *
+ * @param lst List
+ * @param node Node variable to iterate with
+ */
+#define INTRUSIVE_LIST_FOREACH(lst, node) \
+    for ((node) = (lst)->sentinel.next; (node) != &(lst)->sentinel; (node) = (node)->next)
+
+/**
+ * Iterate the nodes of a list from head to tail, allowing the current node
+ * to be unlinked (or freed)
+ *
+ * @param lst List
+ * @param node Node variable to iterate with
+ * @param next_node Node variable holding the next node
+ */
+#define INTRUSIVE_LIST_FOREACH_SAFE(lst, node, next_node)                      \
+    for ((node) = (lst)->sentinel.next, (next_node) = (node)->next;            \
+         (node) != &(lst)->sentinel;                                           \
+         (node) = (next_node), (next_node) = (node)->next)
+
+/**
+ * Initialize list
+ *
+ * @param lst Empty list to initialize
+ */
+static inline void intrusive_list_init(intrusive_list* lst) {
+    lst->sentinel.prev = &lst->sentinel;
+    lst->sentinel.next = &lst->sentinel;
+    lst->size = 0;
+}
+
+/**
+ * Mark a node as not being in any list
+ *
+ * @param node Node
+ */
+static inline void intrusive_list_node_init(intrusive_list_node* node) {
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+/**
+ * Check if a node is in a list
+ * (only for nodes initialized with intrusive_list_node_init(), or unlinked)
+ *
+ * @param node Node
+ * @return 1 if linked, 0 otherwise
+ */
+static inline int intrusive_list_is_linked(const intrusive_list_node* node) {
+    return node->next != NULL;
+}
+
+/**
+ * Check if list is empty
+ *
+ * @param lst List
+ * @return 1 if empty, 0 otherwise
+ */
+static inline int intrusive_list_is_empty(const intrusive_list* lst) {
+    return lst->sentinel.next == &lst->sentinel;
+}
+
+/**
+ * Get first (head) node of list
+ *
+ * @param lst List
+ * @return Head node (or NULL if empty)
+ */
+static inline intrusive_list_node* intrusive_list_head(const intrusive_list* lst) {
+    return lst->sentinel.next != &lst->sentinel ? lst->sentinel.next : NULL;
+}
+
+/**
+ * Get last (tail) node of list
+ *
+ * @param lst List
+ * @return Tail node (or NULL if empty)
+ */
+static inline intrusive_list_node* intrusive_list_tail(const intrusive_list* lst) {
+    return lst->sentinel.prev != &lst->sentinel ? lst->sentinel.prev : NULL;
+}
+
+/**
+ * Get the node after a node
+ *
+ * @param lst List containing node
+ * @param node Node
+ * @return Next node (or NULL if node is the tail)
+ */
+static inline intrusive_list_node* intrusive_list_next(const intrusive_list* lst, const intrusive_list_node* node) {
+    return node->next != &lst->sentinel ? node->next : NULL;
+}
+
+/**
+ * Get the node before a node
+ *
+ * @param lst List containing node
+ * @param node Node
+ * @return Previous node (or NULL if node is the head)
+ */
+static inline intrusive_list_node* intrusive_list_prev(const intrusive_list* lst, const intrusive_list_node* node) {
+    return node->prev != &lst->sentinel ? node->prev : NULL;
+}
+
+/**
+ * Insert a node after a node of list
+ *
+ * @param lst List containing pos
+ * @param pos Node to insert after
+ * @param node Node to insert (not in any list)
+ */
+static inline void intrusive_list_insert_after(intrusive_list* lst, intrusive_list_node* pos, intrusive_list_node* node) {
+    node->prev = pos;
+    node->next = pos->next;
+    pos->next->prev = node;
+    pos->next = node;
+
+    ++lst->size;
+}
+
+/**
+ * Insert a node before a node of list
+ *
+ * @param lst List containing pos
+ * @param pos Node to insert before
+ * @param node Node to insert (not in any list)
+ */
+static inline void intrusive_list_insert_before(intrusive_list* lst, intrusive_list_node* pos, intrusive_list_node* node) {
+    intrusive_list_insert_after(lst, pos->prev, node);
+}
+
+/**
+ * Push node to head of list (prepend)
+ *
+ * @param lst List
+ * @param node Node (not in any list)
+ */
+static inline void intrusive_list_push_head(intrusive_list* lst, intrusive_list_node* node) {
+    intrusive_list_insert_after(lst, &lst->sentinel, node);
+}
+
+/**
+ * Push node to tail of list (append)
+ *
+ * @param lst List
+ * @param node Node (not in any list)
+ */
+static inline void intrusive_list_push_tail(intrusive_list* lst, intrusive_list_node* node) {
+    intrusive_list_insert_after(lst, lst->sentinel.prev, node);
+}
+
+/**
+ * Unlink a node from list
+ * The node can then be freed, or inserted into a list again
+ *
+ * @param lst List containing node
+ * @param node Node
+ */
+static inline void intrusive_list_unlink(intrusive_list* lst, intrusive_list_node* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+
+    --lst->size;
+}
+
+/**
+ * Unlink the head node of list
+ *
+ * @param lst List
+ * @return Unlinked node (or NULL if empty)
+ */
+static inline intrusive_list_node* intrusive_list_pop_head(intrusive_list* lst) {
+    intrusive_list_node* p_node = intrusive_list_head(lst);
+
+    if (p_node != NULL) {
+        intrusive_list_unlink(lst, p_node);
+    }
+
+    return p_node;
+}
+
+/**
+ * Unlink the tail node of list
+ *
+ * @param lst List
+ * @return Unlinked node (or NULL if empty)
+ */
+static inline intrusive_list_node* intrusive_list_pop_tail(intrusive_list* lst) {
+    intrusive_list_node* p_node = intrusive_list_tail(lst);
+
+    if (p_node != NULL) {
+        intrusive_list_unlink(lst, p_node);
+    }
+
+    return p_node;
+}
+
+/**
+ * Move a node of list to its head
+ *
+ * @param lst List containing node
+ * @param node Node
+ */
+static inline void intrusive_list_move_to_head(intrusive_list* lst, intrusive_list_node* node) {
+    intrusive_list_unlink(lst, node);
+    intrusive_list_push_head(lst, node);
+}
+
+/**
+ * Move a node of list to its tail
+ *
+ * @param lst List containing node
+ * @param node Node
+ */
+static inline void intrusive_list_move_to_tail(intrusive_list* lst, intrusive_list_node* node) {
+    intrusive_list_unlink(lst, node);
+    intrusive_list_push_tail(lst, node);
+}
+
+#endif
@@ -7,11 +7,12 @@
 /**
  * Create a new list node
  *
+ * @param lst List to allocate node for
  * @param value Value of node
  * @return List node
  */
-static list_node* make_node(void* value) {
-    list_node* item = malloc(sizeof(list_node));
+static list_node* make_node(list* lst, void* value) {
+    list_node* item = allocator_alloc(lst->allocator, sizeof(list_node));
     if (item == NULL) {
         perror("make_node: malloc() failed");
         return NULL;
@@ -27,67 +28,142 @@ static list_node* make_node(void* value) {
 /**
  * Find list node at a given position
  *
- * This needs to traverse the entire list, so it's not very efficient for
- * large lists
+ * Walks from whichever end of the list is closer, so this visits at most
+ * half of the nodes
  *
- * @param list List
+ * @param lst List
  * @param pos Position
  * @return List node (or NULL if not found)
  */
-static list_node* find_node_at(list_node* list, const size_t pos) {
-    list_node* p_iter = list;
+static list_node* find_node_at(const list* lst, const size_t pos) {
+    if (pos >= lst->size) {
+        return NULL;
+    }
+
+    list_node* p_iter;
 
-    for (int i = 0; p_iter != NULL; ++i) {
-        if (i == pos) {
-            return p_iter;
+    if (pos < lst->size / 2) {
+        p_iter = lst->head;
+        for (size_t i = 0; i < pos; ++i) {
+            p_iter = p_iter->next;
+        }
+    }
+    else {
+        p_iter = lst->tail;
+        for (size_t i = lst->size - 1; i > pos; --i) {
+            p_iter = p_iter->prev;
         }
+    }
 
-        p_iter = p_iter->next;
+    return p_iter;
+}
+
+/**
+ * Link a chain of nodes into list before a node
+ *
+ * @param lst List
+ * @param before Node to link the chain before (or NULL to append it)
+ * @param first First node of the chain
+ * @param last Last node of the chain
+ * @param count Number of nodes in the chain
+ */
+static void link_chain(list* lst, list_node* before, list_node* first, list_node* last, const size_t count) {
+    list_node* p_prev = before != NULL ? before->prev : lst->tail;
+
+    first->prev = p_prev;
+    last->next = before;
+
+    if (p_prev != NULL) {
+        p_prev->next = first;
+    }
+    else {
+        lst->head = first;
     }
 
-    return NULL;
+    if (before != NULL) {
+        before->prev = last;
+    }
+    else {
+        lst->tail = last;
+    }
+
+    lst->size += count;
+}
+
+/**
+ * Check that nodes can be moved between two lists
+ * (they must be released through the same allocator, and that allocator must
+ * not be reset by either list: it holds the nodes of both)
+ *
+ * @param func Name of the calling function (for error messages)
+ * @param dst List to move nodes to
+ * @param src List to move nodes from
+ * @return 0 if they can, -1 otherwise
+ */
+static int check_movable(const char* func, const list* dst, const list* src) {
+    if (dst == src) {
+        fprintf(stderr, "%s: can't move nodes within the same list\n", func);
+        return -1;
+    }
+
+    if (dst->allocator != src->allocator) {
+        fprintf(stderr, "%s: lists don't share an allocator\n", func);
+        return -1;
+    }
+
+    if (dst->owns_allocator || src->owns_allocator) {
+        fprintf(stderr, "%s: a list owning its allocator can't share nodes\n", func);
+        return -1;
+    }
+
+    return 0;
 }
 
 int linked_list_init(list* lst) {
+    return linked_list_init_with_allocator(lst, NULL);
+}
+
+int linked_list_init_with_allocator(list* lst, allocator* alloc) {
     lst->head = NULL;
     lst->tail = NULL;
     lst->size = 0;
+    lst->allocator = alloc;
+    lst->owns_allocator = 0;
 
     return 0;
 }
 
-int linked_list_insert_at(list* lst, void* value, const size_t pos) {
-    list_node* p_head = lst->head;
-    list_node* p_existing = find_node_at(p_head, pos);
-
-    if (p_existing == NULL) {
-        fprintf(stderr, "list_insert_at: node does not exist at index %zu\n", pos);
+int linked_list_init_with_own_allocator(list* lst, allocator* alloc) {
+    if (linked_list_init_with_allocator(lst, alloc) != 0) {
         return -1;
     }
 
-    list_node* p_node = make_node(value);
-    if (p_node == NULL) {
-        return -1;
-    }
+    lst->owns_allocator = alloc != NULL;
 
-    if (p_head == NULL) {
-        lst->head = p_node;
+    return 0;
+}
+
+int linked_list_insert_at(list* lst, void* value, const size_t pos) {
+    if (pos > lst->size) {
+        fprintf(stderr, "list_insert_at: index %zu is out of bounds %zu\n", pos, lst->size);
+        return -1;
     }
 
-    p_node->prev = p_existing->prev;
-    p_node->next = p_existing;
+    // (NULL when appending)
+    list_node* p_existing = find_node_at(lst, pos);
 
-    if (p_node->next == NULL) {
-        lst->tail = p_node;
+    list_node* p_node = make_node(lst, value);
+    if (p_node == NULL) {
+        return -1;
     }
 
-    ++lst->size;
+    link_chain(lst, p_existing, p_node, p_node, 1);
 
     return 0;
 }
 
 void* linked_list_get_at(const list* lst, const size_t pos) {
-    list_node* p_node = find_node_at(lst->head, pos);
+    list_node* p_node = find_node_at(lst, pos);
 
     if (p_node == NULL) {
         return NULL;
@@ -98,18 +174,25 @@ void* linked_list_get_at(const list* lst, const size_t pos) {
 
 int linked_list_del_at(list* lst, const size_t pos) {
     if (lst->head == NULL) {
-        fprintf(stderr, "list_del_at: list is empty");
+        fprintf(stderr, "list_del_at: list is empty\n");
         return -1;
     }
 
-    list_node* p_node = find_node_at(lst->head, pos);
+    list_node* p_node = find_node_at(lst, pos);
     if (p_node == NULL) {
-        fprintf(stderr, "list_del_at: node does not exist at index %zu", pos);
+        fprintf(stderr, "list_del_at: node does not exist at index %zu\n", pos);
         return -1;
     }
 
-    list_node* p_before = p_node->prev;
-    list_node* p_after = p_node->next;
+    linked_list_unlink_node(lst, p_node);
+    allocator_free(lst->allocator, p_node);
+
+    return 0;
+}
+
+void linked_list_unlink_node(list* lst, list_node* node) {
+    list_node* p_before = node->prev;
+    list_node* p_after = node->next;
 
     if (p_before != NULL) {
         p_before->next = p_after;
@@ -125,13 +208,10 @@ int linked_list_del_at(list* lst, const size_t pos) {
         lst->tail = p_before;
     }
 
-    p_node->prev = NULL;
-    p_node->next = NULL;
+    node->prev = NULL;
+    node->next = NULL;
 
-    free(p_node);
     --lst->size;
-
-    return 0;
 }
 
 void* linked_list_head(const list* lst) {
@@ -145,7 +225,7 @@ void* linked_list_head(const list* lst) {
 int linked_list_push_head(list* lst, void* value) {
     list_node* p_head = lst->head;
 
-    list_node* p_node = make_node(value);
+    list_node* p_node = make_node(lst, value);
     if (p_node == NULL) {
         return -1;
     }
@@ -169,20 +249,40 @@ int linked_list_push_head(list* lst, void* value) {
 }
 
 void* linked_list_pop_head(list* lst) {
-    list_node* p_node = lst->head;
+    list_node* p_node = linked_list_pop_head_node(lst);
 
     if (p_node == NULL) {
         return NULL;
     }
 
     void* value = p_node->value;
+
+    allocator_free(lst->allocator, p_node);
+
+    return value;
+}
+
+list_node* linked_list_pop_head_node(list* lst) {
+    list_node* p_node = lst->head;
+
+    if (p_node == NULL) {
+        return NULL;
+    }
+
     lst->head = p_node->next;
-    p_node->next = NULL;
 
-    free(p_node);
+    if (lst->head == NULL) {
+        // List is now empty
+        lst->tail = NULL;
+    }
+    else {
+        lst->head->prev = NULL;
+    }
+
+    p_node->next = NULL;
     --lst->size;
 
-    return value;
+    return p_node;
 }
 
 void* linked_list_tail(const list* lst) {
@@ -194,26 +294,32 @@ void* linked_list_tail(const list* lst) {
 }
 
 int linked_list_push_tail(list* lst, void* value) {
-    list_node* p_tail = lst->tail;
-
-    list_node* p_node = make_node(value);
+    list_node* p_node = make_node(lst, value);
     if (p_node == NULL) {
         return -1;
     }
 
+    linked_list_push_tail_node(lst, p_node);
+
+    return 0;
+}
+
+void linked_list_push_tail_node(list* lst, list_node* node) {
+    list_node* p_tail = lst->tail;
+
+    node->prev = p_tail;
+    node->next = NULL;
+
     if (p_tail != NULL) {
-        p_tail->next = p_node;
-        p_node->prev = p_tail;
+        p_tail->next = node;
     }
     else {
-        lst->head = p_node;
+        lst->head = node;
     }
 
-    lst->tail = p_node;
+    lst->tail = node;
 
     ++lst->size;
-
-    return 0;
 }
 
 void* linked_list_pop_tail(list* lst) {
@@ -239,12 +345,82 @@ void* linked_list_pop_tail(list* lst) {
 
     void* value = p_node->value;
 
-    free(p_node);
+    allocator_free(lst->allocator, p_node);
     --lst->size;
 
     return value;
 }
 
+int linked_list_concat(list* dst, list* src) {
+    if (check_movable("list_concat", dst, src) != 0) {
+        return -1;
+    }
+
+    if (src->head != NULL) {
+        link_chain(dst, NULL, src->head, src->tail, src->size);
+
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+    }
+
+    return 0;
+}
+
+int linked_list_splice(list* dst, const size_t pos, list* src) {
+    if (check_movable("list_splice", dst, src) != 0) {
+        return -1;
+    }
+
+    if (pos > dst->size) {
+        fprintf(stderr, "list_splice: index %zu is out of bounds %zu\n", pos, dst->size);
+        return -1;
+    }
+
+    if (src->head != NULL) {
+        link_chain(dst, find_node_at(dst, pos), src->head, src->tail, src->size);
+
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+    }
+
+    return 0;
+}
+
+int linked_list_split(list* lst, const size_t pos, list* tail_out) {
+    if (check_movable("list_split", tail_out, lst) != 0) {
+        return -1;
+    }
+
+    if (pos > lst->size) {
+        fprintf(stderr, "list_split: index %zu is out of bounds %zu\n", pos, lst->size);
+        return -1;
+    }
+
+    list_node* p_first = find_node_at(lst, pos);
+    if (p_first == NULL) {
+        // Nothing to move
+        return 0;
+    }
+
+    list_node* p_last = lst->tail;
+    const size_t count = lst->size - pos;
+
+    lst->tail = p_first->prev;
+    if (lst->tail != NULL) {
+        lst->tail->next = NULL;
+    }
+    else {
+        lst->head = NULL;
+    }
+    lst->size = pos;
+
+    link_chain(tail_out, NULL, p_first, p_last, count);
+
+    return 0;
+}
+
 int linked_list_iter(
     const list* lst,
     list_iter_func iter_func,
@@ -252,7 +428,7 @@ int linked_list_iter(
 ) {
     list_node* p_node = lst->head;
     if (p_node == NULL) {
-        fprintf(stderr, "list_iter: list is empty");
+        fprintf(stderr, "list_iter: list is empty\n");
         return -1;
     }
 
@@ -288,23 +464,17 @@ void linked_list_dump(const list* lst) {
     printf(" ]\n");
 }
 
-/**
- * Iterator callback function that destroys all list nodes
- *
- * @param item Iterated list node
- * @param _index Iteration index
- * @param _user_arg Ignored
- */
-static void destroy_iter_func(
-    const list_node* item,
-    size_t _index,
-    void* _user_arg
-) {
-    free((void *)item);
-}
-
 int linked_list_destroy(list* lst) {
-    linked_list_iter(lst, destroy_iter_func, NULL);
+    // Resetting a shared allocator would release the nodes of other lists too
+    if (!lst->owns_allocator || allocator_reset(lst->allocator) != 0) {
+        // Free nodes one at a time
+        list_node* p_node = lst->head;
+        while (p_node != NULL) {
+            list_node* p_next = p_node->next;
+            allocator_free(lst->allocator, p_node);
+            p_node = p_next;
+        }
+    }
 
     lst->head = NULL;
     lst->tail = NULL;
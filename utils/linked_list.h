@@ -1,6 +1,9 @@
 #ifndef __LIST_H_DEFINED__
 #define __LIST_H_DEFINED__
 
+#include <inttypes.h>
+#include "allocator.h"
+
 /**
  * Doubly-linked list node
  */
@@ -15,6 +18,17 @@ typedef struct linked_list_node {
 typedef struct linked_list {
     list_node *head, *tail;
     size_t size;
+
+    /**
+     * Allocator for list nodes (NULL: malloc)
+     */
+    allocator* allocator;
+
+    /**
+     * Set if the allocator serves this list only, so that
+     * linked_list_destroy() may release all of it at once
+     */
+    uint8_t owns_allocator;
 } list;
 
 /**
@@ -25,18 +39,43 @@ typedef struct linked_list {
  */
 int linked_list_init(list* lst);
 
+/**
+ * Initialize list that allocates its nodes from an allocator
+ * The allocator may be shared with other lists: linked_list_destroy()
+ * releases this list's nodes one at a time.
+ *
+ * @param lst Empty list to initialize
+ * @param alloc Node allocator
+ * @return 0 on success, -1 on failure
+ */
+int linked_list_init_with_allocator(list* lst, allocator* alloc);
+
+/**
+ * Initialize list that allocates its nodes from an allocator dedicated to it
+ * If the allocator supports bulk release (e.g. a slab), linked_list_destroy()
+ * releases all nodes at once by resetting it, along with anything else
+ * allocated from it.
+ *
+ * @param lst Empty list to initialize
+ * @param alloc Node allocator, used by no other list
+ * @return 0 on success, -1 on failure
+ */
+int linked_list_init_with_own_allocator(list* lst, allocator* alloc);
+
 /**
  * Insert value into list at position
+ * Seeks from whichever end of the list is closer
  *
  * @param lst List
  * @param value Value to insert
- * @param pos Position to insert at
+ * @param pos Position to insert at (at most the size of the list)
  * @return 0 on success, -1 on failure
  */
 int linked_list_insert_at(list* lst, void* value, size_t pos);
 
 /**
  * Get value at position in list
+ * Seeks from whichever end of the list is closer
  *
  * @param lst List
  * @param pos Position to get item at
@@ -46,6 +85,7 @@ void* linked_list_get_at(const list* lst, size_t pos);
 
 /**
  * Delete value at position in list
+ * Seeks from whichever end of the list is closer
  *
  * @param lst List
  * @param pos Position to delete at
@@ -103,6 +143,62 @@ int linked_list_push_tail(list* lst, void* value);
  */
 void* linked_list_pop_tail(list* lst);
 
+/**
+ * Detach the head node from list without freeing it
+ * Used to move nodes between lists without reallocating them
+ *
+ * @param lst List
+ * @return Detached node (or NULL if empty)
+ */
+list_node* linked_list_pop_head_node(list* lst);
+
+/**
+ * Attach a detached node to the tail of list
+ *
+ * @param lst List
+ * @param node Node previously detached with linked_list_pop_head_node()
+ */
+void linked_list_push_tail_node(list* lst, list_node* node);
+
+/**
+ * Detach a node from anywhere in list without freeing it
+ *
+ * @param lst List containing node
+ * @param node Node to detach
+ */
+void linked_list_unlink_node(list* lst, list_node* node);
+
+/**
+ * Move all nodes of src to the tail of dst in O(1), leaving src empty
+ *
+ * @param dst List to append to
+ * @param src List to move nodes from (sharing the allocator of dst, neither owning it)
+ * @return 0 on success, -1 on failure
+ */
+int linked_list_concat(list* dst, list* src);
+
+/**
+ * Move all nodes of src into dst at position, leaving src empty
+ * Only seeks to pos: the nodes are moved in O(1)
+ *
+ * @param dst List to insert into
+ * @param pos Position to insert at (at most the size of dst)
+ * @param src List to move nodes from (sharing the allocator of dst, neither owning it)
+ * @return 0 on success, -1 on failure
+ */
+int linked_list_splice(list* dst, size_t pos, list* src);
+
+/**
+ * Move the nodes of list from position to its tail to the tail of another list
+ * Only seeks to pos: the nodes are moved in O(1)
+ *
+ * @param lst List to split
+ * @param pos Position of the first node to move (at most the size of lst)
+ * @param tail_out List to append the nodes to (sharing the allocator of lst, neither owning it)
+ * @return 0 on success, -1 on failure
+ */
+int linked_list_split(list* lst, size_t pos, list* tail_out);
+
 /**
  * List iterator callback function
  *
@@ -140,6 +236,7 @@ void linked_list_dump(const list* lst);
 
 /**
  * Destroy list
+ * Nodes are released in bulk if the list's allocator supports it
  *
  * @param lst List
  * @return 0 on success, -1 on failure
@@ -0,0 +1,144 @@
+#include <stdio.h>
+
+#include "lru_cache.h"
+
+/**
+ * Cache entry
+ */
+typedef struct lru_cache_entry {
+    entry_index_entry kv;
+    intrusive_list_node link;
+} lru_cache_entry;
+
+/**
+ * Unlink an entry from the recency list and drop it from the index
+ *
+ * @param cache Cache
+ * @param p_entry Entry
+ */
+static void drop_entry(lru_cache* cache, lru_cache_entry* p_entry) {
+    intrusive_list_unlink(&cache->recency, &p_entry->link);
+    entry_index_drop(&cache->index, p_entry);
+}
+
+/**
+ * Evict least recently used entries until the cache holds at most a number
+ * of entries
+ *
+ * @param cache Cache
+ * @param size Maximum number of entries to keep
+ */
+static void evict_to(lru_cache* cache, const size_t size) {
+    while (cache->recency.size > size) {
+        drop_entry(cache, INTRUSIVE_LIST_ENTRY(intrusive_list_tail(&cache->recency), lru_cache_entry, link));
+        ++cache->evictions;
+    }
+}
+
+int lru_cache_init(
+    lru_cache* cache,
+    const size_t capacity,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    if (capacity == 0 || capacity > UINT32_MAX / 4) {
+        fprintf(stderr, "lru_cache_init: capacity %zu is out of range\n", capacity);
+        return -1;
+    }
+
+    // Twice the capacity: deletes leave tombstones, and the table only
+    // rehashes in place (rather than growing) while it's at most half full
+    if (entry_index_init(&cache->index, (uint32_t)capacity * 2, sizeof(lru_cache_entry), key_cmp, key_hash) != 0) {
+        return -1;
+    }
+
+    intrusive_list_init(&cache->recency);
+    cache->capacity = capacity;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+
+    return 0;
+}
+
+void lru_cache_set_release_func(lru_cache* cache, const lru_cache_release_func release_func, void* user_arg) {
+    entry_index_set_release_func(&cache->index, release_func, user_arg);
+}
+
+void* lru_cache_get(lru_cache* cache, const void* key) {
+    lru_cache_entry* p_entry = entry_index_get(&cache->index, key);
+    if (p_entry == NULL) {
+        ++cache->misses;
+        return NULL;
+    }
+
+    ++cache->hits;
+    intrusive_list_move_to_head(&cache->recency, &p_entry->link);
+
+    return p_entry->kv.value;
+}
+
+void* lru_cache_peek(lru_cache* cache, const void* key) {
+    const lru_cache_entry* p_entry = entry_index_get(&cache->index, key);
+
+    return p_entry != NULL ? p_entry->kv.value : NULL;
+}
+
+int lru_cache_put(lru_cache* cache, void* key, void* value) {
+    lru_cache_entry* p_entry = entry_index_get(&cache->index, key);
+
+    if (p_entry != NULL) {
+        if (entry_index_replace(&cache->index, p_entry, key, value) != 0) {
+            return -1;
+        }
+
+        intrusive_list_move_to_head(&cache->recency, &p_entry->link);
+
+        return 0;
+    }
+
+    // Make room first, so the entry pool and index never hold more than capacity
+    evict_to(cache, cache->capacity - 1);
+
+    p_entry = entry_index_add(&cache->index, key, value);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    intrusive_list_push_head(&cache->recency, &p_entry->link);
+
+    return 0;
+}
+
+int lru_cache_del(lru_cache* cache, const void* key) {
+    lru_cache_entry* p_entry = entry_index_get(&cache->index, key);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    drop_entry(cache, p_entry);
+
+    return 0;
+}
+
+size_t lru_cache_size(const lru_cache* cache) {
+    return cache->recency.size;
+}
+
+int lru_cache_set_capacity(lru_cache* cache, const size_t capacity) {
+    if (capacity == 0 || capacity > UINT32_MAX / 4) {
+        fprintf(stderr, "lru_cache_set_capacity: capacity %zu is out of range\n", capacity);
+        return -1;
+    }
+
+    cache->capacity = capacity;
+    evict_to(cache, capacity);
+
+    return 0;
+}
+
+int lru_cache_destroy(lru_cache* cache) {
+    intrusive_list_init(&cache->recency);
+
+    return entry_index_destroy(&cache->index);
+}
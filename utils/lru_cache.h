@@ -0,0 +1,156 @@
+#ifndef __LRU_CACHE_H__
+#define __LRU_CACHE_H__
+
+/**
+ * Bounded least-recently-used cache
+ *
+ * Holds at most capacity entries: adding one more evicts the entry that was
+ * used least recently. Lookups, insertions and evictions are O(1): an open
+ * addressing hash_table indexes the entries by key, and an intrusive_list
+ * keeps them in order of use. Entries are allocated from a slab, so memory
+ * stays flat once the cache is full.
+ *
+ * Key and value pointers are stored as is. The release function gets them
+ * back when their entry is evicted, replaced, deleted, or left over at
+ * destroy time, as described in entry_index.h.
+ *
+ * Not thread-safe.
+ */
+
+#include <inttypes.h>
+
+#include "entry_index.h"
+#include "intrusive_list.h"
+
+/**
+ * Release function, called with the key and value of each dropped entry
+ *
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param user_arg User argument given to lru_cache_set_release_func()
+ */
+typedef void (*lru_cache_release_func)(void* key, void* value, void* user_arg);
+
+/**
+ * LRU cache
+ */
+typedef struct lru_cache {
+    /**
+     * Key to entry index, and entry allocator
+     */
+    entry_index index;
+
+    /**
+     * Entries from most (head) to least (tail) recently used
+     */
+    intrusive_list recency;
+
+    /**
+     * Maximum number of entries
+     */
+    size_t capacity;
+
+    /**
+     * Number of lookups that found / didn't find their key
+     */
+    uint64_t hits;
+    uint64_t misses;
+
+    /**
+     * Number of entries evicted to stay within capacity
+     */
+    uint64_t evictions;
+} lru_cache;
+
+/**
+ * Initialize LRU cache
+ *
+ * @param cache Cache
+ * @param capacity Maximum number of entries (at least 1)
+ * @param key_cmp Key comparator (or NULL to use the hash_table default)
+ * @param key_hash Key hash function (or NULL to use the hash_table default)
+ * @return 0 on success, -1 on failure
+ */
+int lru_cache_init(
+    lru_cache* cache,
+    size_t capacity,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Set the function called with the key and value of each dropped entry
+ *
+ * @param cache Cache
+ * @param release_func Release function (or NULL)
+ * @param user_arg Optional argument to pass to the release function
+ */
+void lru_cache_set_release_func(lru_cache* cache, lru_cache_release_func release_func, void* user_arg);
+
+/**
+ * Get value from cache, marking its entry as the most recently used
+ * Counts a hit or a miss
+ *
+ * @param cache Cache
+ * @param key Key to get value for
+ * @return Value (or NULL if not cached)
+ */
+void* lru_cache_get(lru_cache* cache, const void* key);
+
+/**
+ * Get value from cache without marking it used or counting a hit or miss
+ *
+ * @param cache Cache
+ * @param key Key to get value for
+ * @return Value (or NULL if not cached)
+ */
+void* lru_cache_peek(lru_cache* cache, const void* key);
+
+/**
+ * Add value to cache as the most recently used entry
+ * Replaces (and releases) the entry with the same key if there's one, and
+ * evicts the least recently used entry if the cache is full otherwise
+ *
+ * @param cache Cache
+ * @param key Key (must stay valid while cached)
+ * @param value Value
+ * @return 0 on success, -1 on failure
+ */
+int lru_cache_put(lru_cache* cache, void* key, void* value);
+
+/**
+ * Delete (and release) entry from cache
+ *
+ * @param cache Cache
+ * @param key Key of entry to delete
+ * @return 0 on success, -1 if not cached
+ */
+int lru_cache_del(lru_cache* cache, const void* key);
+
+/**
+ * Get number of entries in cache
+ *
+ * @param cache Cache
+ * @return Number of entries
+ */
+size_t lru_cache_size(const lru_cache* cache);
+
+/**
+ * Change the capacity of cache, evicting least recently used entries if it
+ * holds more than the new capacity
+ *
+ * @param cache Cache
+ * @param capacity Maximum number of entries (at least 1)
+ * @return 0 on success, -1 on failure
+ */
+int lru_cache_set_capacity(lru_cache* cache, size_t capacity);
+
+/**
+ * Destroy cache, releasing all entries
+ *
+ * @param cache Cache
+ * @return 0 on success, -1 on failure
+ */
+int lru_cache_destroy(lru_cache* cache);
+
+#endif
@@ -9,6 +9,40 @@ static uint32_t murmur3_scramble(uint32_t k) {
     return k;
 }
 
+/**
+ * Mix a complete 4 byte block into the hash
+ *
+ * @param h Hash
+ * @param k Block
+ * @return Hash
+ */
+static uint32_t murmur3_block(uint32_t h, const uint32_t k) {
+    h ^= murmur3_scramble(k);
+    h = (h << 13) | (h >> 19);
+    return h * 5 + 0xe6546b64;
+}
+
+/**
+ * Mix the incomplete block and length into the hash
+ *
+ * @param h Hash
+ * @param tail Bytes of incomplete block (little-endian)
+ * @param len Total number of bytes hashed
+ * @return Hash value
+ */
+static uint32_t murmur3_finalize(uint32_t h, const uint32_t tail, const size_t len) {
+    h ^= murmur3_scramble(tail);
+
+    h ^= len;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+
+    return h;
+}
+
 uint32_t murmur3(const uint8_t* key, const size_t len, const uint32_t seed) {
     uint32_t h = seed;
     uint32_t k;
@@ -17,9 +51,7 @@ uint32_t murmur3(const uint8_t* key, const size_t len, const uint32_t seed) {
     for (size_t i = len >> 2; i; --i) {
         memcpy(&k, key, sizeof(uint32_t));
         key += sizeof(uint32_t);
-        h ^= murmur3_scramble(k);
-        h = (h << 13) | (h >> 19);
-        h = h * 5 + 0xe6546b64;
+        h = murmur3_block(h, k);
     }
 
     // Read the rest
@@ -29,15 +61,155 @@ uint32_t murmur3(const uint8_t* key, const size_t len, const uint32_t seed) {
         k |= key[i - 1];
     }
 
-    h ^= murmur3_scramble(k);
+    return murmur3_finalize(h, k, len);
+}
+
+uint32_t murmur3_str(const char* str, const uint32_t seed) {
+    const uint8_t* p = (const uint8_t *)str;
+    uint32_t h = seed;
+
+    // Blocks only need the length at the end, so the string is read once
+    for (;;) {
+        if (p[0] == 0) {
+            return murmur3_finalize(h, 0, p - (const uint8_t *)str);
+        }
+        if (p[1] == 0) {
+            return murmur3_finalize(h, p[0], p + 1 - (const uint8_t *)str);
+        }
+        if (p[2] == 0) {
+            return murmur3_finalize(h, p[0] | (uint32_t)p[1] << 8, p + 2 - (const uint8_t *)str);
+        }
+        if (p[3] == 0) {
+            return murmur3_finalize(h, p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16, p + 3 - (const uint8_t *)str);
+        }
+
+        uint32_t k;
+        memcpy(&k, p, sizeof(uint32_t));
+        h = murmur3_block(h, k);
+        p += sizeof(uint32_t);
+    }
+}
+
+void murmur3_init(murmur3_state* state, const uint32_t seed) {
+    state->h = seed;
+    state->tail = 0;
+    state->tail_size = 0;
+    state->len = 0;
+}
+
+void murmur3_update(murmur3_state* state, const void* data, size_t len) {
+    const uint8_t* p = data;
+
+    state->len += len;
+
+    // Complete the pending block first
+    while (state->tail_size != 0 && len != 0) {
+        state->tail |= (uint32_t)*p++ << (8 * state->tail_size);
+        --len;
+
+        if (++state->tail_size == sizeof(uint32_t)) {
+            state->h = murmur3_block(state->h, state->tail);
+            state->tail = 0;
+            state->tail_size = 0;
+        }
+    }
+
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        uint32_t k;
+        memcpy(&k, p, sizeof(uint32_t));
+        state->h = murmur3_block(state->h, k);
+        p += sizeof(uint32_t);
+    }
+
+    for (; len != 0; --len) {
+        state->tail |= (uint32_t)*p++ << (8 * state->tail_size++);
+    }
+}
+
+uint32_t murmur3_final(const murmur3_state* state) {
+    return murmur3_finalize(state->h, state->tail, state->len);
+}
+
+static uint64_t rotl64(const uint64_t x, const int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+void murmur3_x64_128(const void* key, const size_t len, const uint32_t seed, uint64_t out[2]) {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    const uint8_t* p = key;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+    uint64_t k1, k2;
+
+    // Read in groups of 16
+    for (size_t i = len >> 4; i; --i) {
+        memcpy(&k1, p, sizeof(uint64_t));
+        memcpy(&k2, p + sizeof(uint64_t), sizeof(uint64_t));
+        p += 2 * sizeof(uint64_t);
+
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Read the rest
+    const size_t rest = len & 15;
+    k1 = 0;
+    k2 = 0;
+    for (size_t i = rest; i > 8; --i) {
+        k2 <<= 8;
+        k2 |= p[i - 1];
+    }
+    for (size_t i = rest < 8 ? rest : 8; i; --i) {
+        k1 <<= 8;
+        k1 |= p[i - 1];
+    }
+
+    if (rest > 8) {
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if (rest > 0) {
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
 
     // Finalize
-    h ^= len;
-    h ^= h >> 16;
-    h *= 0x85ebca6b;
-    h ^= h >> 13;
-    h *= 0xc2b2ae35;
-    h ^= h >> 16;
+    h1 ^= len;
+    h2 ^= len;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
 
-    return h;
+    out[0] = h1;
+    out[1] = h2;
 }
@@ -1,7 +1,90 @@
 #ifndef __MURMUR3_H__
 #define __MURMUR3_H__
+#include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * Incremental MurmurHash3_x86_32 state
+ * Lets a key made of several fields be hashed without copying the fields
+ * into a single buffer first
+ */
+typedef struct murmur3_state {
+    /**
+     * Hash of all complete 4 byte blocks so far
+     */
+    uint32_t h;
+
+    /**
+     * Bytes of the incomplete block (little-endian)
+     */
+    uint32_t tail;
+
+    /**
+     * Number of bytes in tail (0-3)
+     */
+    size_t tail_size;
+
+    /**
+     * Total number of bytes hashed
+     */
+    size_t len;
+} murmur3_state;
+
+/**
+ * MurmurHash3_x86_32
+ *
+ * @param key Key to hash
+ * @param len Size of key
+ * @param seed Seed
+ * @return Hash value
+ */
 uint32_t murmur3(const uint8_t* key, size_t len, uint32_t seed);
 
+/**
+ * MurmurHash3_x86_32 of a NUL-terminated string, in a single pass
+ * Same as murmur3(str, strlen(str), seed)
+ *
+ * @param str String to hash
+ * @param seed Seed
+ * @return Hash value
+ */
+uint32_t murmur3_str(const char* str, uint32_t seed);
+
+/**
+ * Start an incremental MurmurHash3_x86_32
+ *
+ * @param state Hash state
+ * @param seed Seed
+ */
+void murmur3_init(murmur3_state* state, uint32_t seed);
+
+/**
+ * Hash more bytes
+ * Hashing a key in several pieces gives the same hash as hashing it at once
+ *
+ * @param state Hash state
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ */
+void murmur3_update(murmur3_state* state, const void* data, size_t len);
+
+/**
+ * Get the hash of all bytes passed to murmur3_update()
+ * The state is left unchanged, so more bytes may still be added
+ *
+ * @param state Hash state
+ * @return Hash value
+ */
+uint32_t murmur3_final(const murmur3_state* state);
+
+/**
+ * MurmurHash3_x64_128
+ *
+ * @param key Key to hash
+ * @param len Size of key
+ * @param seed Seed
+ * @param out Output hash (low 64 bits first)
+ */
+void murmur3_x64_128(const void* key, size_t len, uint32_t seed, uint64_t out[2]);
+
 #endif
@@ -1,82 +1,166 @@
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "net_utils.h"
 
-uint32_t net_utils_ip2long(char* ip_addr) {
+int net_utils_ip_parse(const char* ip_addr, uint32_t* long_addr_out) {
+    const unsigned char* p_char = (const unsigned char *)ip_addr;
     uint32_t long_addr = 0;
 
-    char* ip_buffer = strdup(ip_addr);
-    if (ip_buffer == NULL) {
-        perror("net_utils_ip2long: strdup() failed");
-        return -1;
-    }
+    for (int i = 0; i < 4; ++i) {
+        // Unsigned subtraction maps every non-digit above 9
+        unsigned int digit = p_char[0] - '0';
+        if (digit > 9) {
+            return -1;
+        }
 
-    char* token = strtok(ip_buffer, ".");
-    if (token == NULL) {
-        return -1;
+        unsigned int octet = digit;
+        ++p_char;
+
+        if ((digit = p_char[0] - '0') <= 9) {
+            if (octet == 0) {
+                // Leading zero (inet_pton rejects these rather than reading them as octal)
+                return -1;
+            }
+
+            octet = octet * 10 + digit;
+            ++p_char;
+
+            if ((digit = p_char[0] - '0') <= 9) {
+                octet = octet * 10 + digit;
+                ++p_char;
+
+                if (octet > 255) {
+                    return -1;
+                }
+            }
+        }
+
+        long_addr = long_addr << 8 | octet;
+
+        // Octets are followed by a dot, the last one by the end of the string
+        if (p_char[0] != (i < 3 ? '.' : '\0')) {
+            return -1;
+        }
+
+        ++p_char;
     }
 
-    while (token != NULL) {
-        long_addr <<= 8;
-        long_addr |= atoi(token) & 0xFF;
+    *long_addr_out = long_addr;
+
+    return 0;
+}
 
-        token = strtok(NULL, "."); // get next token
+size_t net_utils_ip_format(const uint32_t long_addr, char* ip_addr_out) {
+    char* p_out = ip_addr_out;
+
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        const unsigned int octet = (long_addr >> shift) & 0xFF;
+        const unsigned int len = 1 + (octet >= 10) + (octet >= 100);
+
+        // Compute all three digits, then keep the last len of them
+        const char digits[3] = {
+            '0' + octet / 100,
+            '0' + octet / 10 % 10,
+            '0' + octet % 10,
+        };
+        memcpy(p_out, digits + 3 - len, len);
+        p_out[len] = '.';
+        p_out += len + 1;
     }
 
-    free(ip_buffer);
+    // Replace the dot after the last octet
+    *--p_out = 0;
+
+    return p_out - ip_addr_out;
+}
+
+uint32_t net_utils_ip2long(const char* ip_addr) {
+    uint32_t long_addr;
+
+    if (net_utils_ip_parse(ip_addr, &long_addr) != 0) {
+        return -1;
+    }
 
     return long_addr;
 }
 
 char* net_utils_long2ip(const uint32_t long_addr, char* ip_addr_out) {
-    char octet[4];
+    net_utils_ip_format(long_addr, ip_addr_out);
 
-    ip_addr_out[0] = 0;
+    return ip_addr_out;
+}
+
+int net_utils_ip_matches(char* test_ip_addr, char* match_ip_addr, const uint8_t net_bits) {
+    // Shifting a 32-bit value by 32 is undefined
+    const uint32_t mask = net_bits == 0 ? 0 : ~0U << (32 - net_bits);
+    return (net_utils_ip2long(test_ip_addr) & mask) == (net_utils_ip2long(match_ip_addr) & mask);
+}
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        const int ret = snprintf(
-            (char *)&octet, 4, "%d",
-            (long_addr >> (24 - 8 * i)) & 0xFF
-        );
+/**
+ * Lowercase hex digits of every byte value ("00" to "ff"), two per byte
+ */
+static const char hex_pairs[512] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/**
+ * Value of every hex digit plus one (0 for characters that aren't hex digits)
+ */
+static const uint8_t hex_values[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+    ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+char* net_utils_ether_format(const uint8_t* ether_addr, char* ether_str_out) {
+    for (int i = 0; i < 6; ++i) {
+        memcpy(&ether_str_out[i * 3], &hex_pairs[ether_addr[i] * 2], 2);
+        ether_str_out[i * 3 + 2] = ':';
+    }
 
-        if (ret < 0) {
-            perror("net_utils_long2ip: snprintf() failed");
-            return NULL;
-        }
+    // Replace the colon after the last byte
+    ether_str_out[17] = 0;
 
-        strcat(ip_addr_out, (char *)&octet);
+    return ether_str_out;
+}
 
-        if (i < 3) {
-            strcat(ip_addr_out, ".");
+int net_utils_ether_parse(const char* ether_str, uint8_t* ether_addr_out) {
+    const unsigned char* p_char = (const unsigned char *)ether_str;
+    uint8_t ether_addr[6];
+
+    for (int i = 0; i < 6; ++i, p_char += 3) {
+        // The terminator isn't a hex digit, so nothing past it is read
+        const unsigned int high = hex_values[p_char[0]];
+        if (high == 0) {
+            return -1;
+        }
+
+        const unsigned int low = hex_values[p_char[1]];
+        if (low == 0 || p_char[2] != (i < 5 ? ':' : '\0')) {
+            return -1;
         }
+
+        ether_addr[i] = (high - 1) << 4 | (low - 1);
     }
 
-    return ip_addr_out;
-}
+    memcpy(ether_addr_out, ether_addr, sizeof(ether_addr));
 
-int net_utils_ip_matches(char* test_ip_addr, char* match_ip_addr, const uint8_t net_bits) {
-    const uint32_t mask = ~0UL << (32 - net_bits);
-    return (net_utils_ip2long(test_ip_addr) & mask) == (net_utils_ip2long(match_ip_addr) & mask);
+    return 0;
 }
 
 char* net_utils_ether_ntoa(const uint8_t* ether_addr) {
-    static char addr_buf[18];
-    addr_buf[17] = 0;
-
-    snprintf(
-        addr_buf,
-        sizeof(addr_buf),
-        "%02x:%02x:%02x:%02x:%02x:%02x",
-        ether_addr[0],
-        ether_addr[1],
-        ether_addr[2],
-        ether_addr[3],
-        ether_addr[4],
-        ether_addr[5]
-    );
-
-    return addr_buf;
+    static _Thread_local char addr_buf[NET_UTILS_ETHER_STR_SIZE];
+
+    return net_utils_ether_format(ether_addr, addr_buf);
 }
 
 void maybe_print_libnet_stats(
@@ -3,24 +3,60 @@
 
 #include "../context.h"
 
+/**
+ * Size of a buffer that holds any IPv4 address string (including terminator)
+ */
+#define NET_UTILS_IP_STR_SIZE 16
+
+/**
+ * Size of a buffer that holds an ethernet address string (including terminator)
+ */
+#define NET_UTILS_ETHER_STR_SIZE 18
+
+/**
+ * Parse a dotted-quad IPv4 address string
+ * Accepts exactly what inet_pton(AF_INET) does: four decimal octets (0-255)
+ * separated by dots, without leading zeros, signs or surrounding whitespace.
+ * Doesn't allocate and is safe to call from several threads.
+ *
+ * @param ip_addr IPv4 address string to parse
+ * @param long_addr_out Output for the address in host byte order
+ * @return 0 on success, -1 if ip_addr isn't a valid IPv4 address
+ */
+int net_utils_ip_parse(const char* ip_addr, uint32_t* long_addr_out);
+
+/**
+ * Format an IPv4 address as a dotted-quad string
+ * Doesn't allocate and is safe to call from several threads.
+ *
+ * @param long_addr Address in host byte order
+ * @param ip_addr_out Output buffer of at least NET_UTILS_IP_STR_SIZE bytes
+ * @return Length of the string written (excluding terminator)
+ */
+size_t net_utils_ip_format(uint32_t long_addr, char* ip_addr_out);
+
 /**
  * Convert an IPv4 address string into a long
+ * Prefer net_utils_ip_parse(): the error value is also a valid address
  *
  * @param ip_addr IPv4 address string to convert
  * @return Long representation of IP address (or -1 if failed)
  */
-uint32_t net_utils_ip2long(char* ip_addr);
+uint32_t net_utils_ip2long(const char* ip_addr);
 
 /**
  * Convert a long into an IPv4 address string
  *
  * @param long_addr Long to convert to IPv4 address
- * @param ip_addr_out Output buffer for IPv4 address string
+ * @param ip_addr_out Output buffer of at least NET_UTILS_IP_STR_SIZE bytes
+ * @return ip_addr_out
  */
 char* net_utils_long2ip(uint32_t long_addr, char* ip_addr_out);
 
 /**
  * Matches IP addresses using net_bits significant bits.
+ * Parses both strings on every call: to match addresses against many
+ * networks, build a prefix_set instead.
  *
  * @param test_ip_addr IPv4 address to test
  * @param match_ip_addr Matching IPv4 address or network
@@ -29,8 +65,32 @@ char* net_utils_long2ip(uint32_t long_addr, char* ip_addr_out);
  */
 int net_utils_ip_matches(char* test_ip_addr, char* match_ip_addr, uint8_t net_bits);
 
+/**
+ * Format an ethernet address as a lowercase colon-separated string
+ * (e.g. "ab:57:d8:36:da:88")
+ * Doesn't allocate and is safe to call from several threads.
+ *
+ * @param ether_addr 6-byte ethernet address
+ * @param ether_str_out Output buffer of at least NET_UTILS_ETHER_STR_SIZE bytes
+ * @return ether_str_out
+ */
+char* net_utils_ether_format(const uint8_t* ether_addr, char* ether_str_out);
+
+/**
+ * Parse an ethernet address string
+ * Accepts six pairs of hex digits (either case) separated by colons.
+ * Doesn't allocate and is safe to call from several threads.
+ *
+ * @param ether_str Ethernet address string
+ * @param ether_addr_out Output for the 6-byte address (untouched on failure)
+ * @return 0 on success, -1 if ether_str isn't a valid ethernet address
+ */
+int net_utils_ether_parse(const char* ether_str, uint8_t* ether_addr_out);
+
 /**
  * Convert ethernet address to human-readable string.
+ * The string is overwritten by the next call on the same thread: prefer
+ * net_utils_ether_format() when formatting several addresses at once.
  *
  * @param ether_addr ethernet address.
  * @return human-readable string.
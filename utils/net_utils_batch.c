@@ -0,0 +1,527 @@
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS
+#endif
+
+#include "net_utils_batch.h"
+
+/**
+ * Batch conversion functions of one implementation
+ */
+typedef struct batch_kernels {
+    size_t (*ip_parse_many)(const char* const* ip_addrs, size_t count, uint32_t* long_addrs_out);
+    void (*ip_format_many)(const uint32_t* long_addrs, size_t count, char (*ip_addrs_out)[NET_UTILS_IP_STR_SIZE]);
+    size_t (*ether_parse_many)(const char* const* ether_strs, size_t count, uint8_t* ether_addrs_out);
+    void (*ether_format_many)(const uint8_t* ether_addrs, size_t count, char (*ether_strs_out)[NET_UTILS_ETHER_STR_SIZE]);
+} batch_kernels;
+
+static size_t ip_parse_many_scalar(const char* const* ip_addrs, const size_t count, uint32_t* long_addrs_out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (net_utils_ip_parse(ip_addrs[i], &long_addrs_out[i]) != 0) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+static void ip_format_many_scalar(
+    const uint32_t* long_addrs,
+    const size_t count,
+    char (*ip_addrs_out)[NET_UTILS_IP_STR_SIZE]
+) {
+    for (size_t i = 0; i < count; ++i) {
+        net_utils_ip_format(long_addrs[i], ip_addrs_out[i]);
+    }
+}
+
+static size_t ether_parse_many_scalar(const char* const* ether_strs, const size_t count, uint8_t* ether_addrs_out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (net_utils_ether_parse(ether_strs[i], &ether_addrs_out[i * 6]) != 0) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+static void ether_format_many_scalar(
+    const uint8_t* ether_addrs,
+    const size_t count,
+    char (*ether_strs_out)[NET_UTILS_ETHER_STR_SIZE]
+) {
+    for (size_t i = 0; i < count; ++i) {
+        net_utils_ether_format(&ether_addrs[i * 6], ether_strs_out[i]);
+    }
+}
+
+static const batch_kernels scalar_kernels = {
+    ip_parse_many_scalar,
+    ip_format_many_scalar,
+    ether_parse_many_scalar,
+    ether_format_many_scalar,
+};
+
+#ifdef HAVE_X86_KERNELS
+
+/**
+ * Smallest page size: a 16-byte load from p can only fault if it crosses a
+ * multiple of this
+ */
+#define MIN_PAGE_SIZE 4096
+
+/**
+ * Lowercase hex digits (as a 16-byte shuffle table)
+ */
+static const char hex_digits[] = "0123456789abcdef";
+
+/**
+ * Number of combinations of four octet lengths (1-3 digits each)
+ */
+#define OCTET_PATTERN_COUNT 81
+
+/**
+ * How to parse an IPv4 address with a given combination of octet lengths
+ */
+typedef struct ip_parse_pattern {
+    /**
+     * Moves the digits of octet i into bytes 4i..4i+2 of a lane, right-aligned
+     * (missing leading digits become 0)
+     */
+    _Alignas(16) uint8_t shuffle[16];
+
+    /**
+     * Smallest value of each octet without a leading zero
+     */
+    _Alignas(16) uint32_t min[4];
+} ip_parse_pattern;
+
+static ip_parse_pattern ip_parse_patterns[OCTET_PATTERN_COUNT];
+
+/**
+ * Shuffles that pick the digits of an IPv4 address with a given combination
+ * of octet lengths, add the dots and pad with terminators (see ip_format_sse41())
+ */
+static _Alignas(16) uint8_t ip_format_patterns[OCTET_PATTERN_COUNT][16];
+
+/**
+ * Get the pattern index of a combination of octet lengths
+ *
+ * @param len0 Length of the first octet (1-3)
+ * @param len1 Length of the second octet (1-3)
+ * @param len2 Length of the third octet (1-3)
+ * @param len3 Length of the fourth octet (1-3)
+ * @return Index
+ */
+static inline unsigned int octet_pattern_index(
+    const unsigned int len0,
+    const unsigned int len1,
+    const unsigned int len2,
+    const unsigned int len3
+) {
+    return (len0 - 1) + (len1 - 1) * 3 + (len2 - 1) * 9 + (len3 - 1) * 27;
+}
+
+/**
+ * Fill in the IPv4 parse and format patterns
+ */
+static void init_octet_patterns(void) {
+    for (unsigned int index = 0; index < OCTET_PATTERN_COUNT; ++index) {
+        ip_parse_pattern* p_parse = &ip_parse_patterns[index];
+        uint8_t* p_format = ip_format_patterns[index];
+        unsigned int lens[4];
+        unsigned int start = 0;
+        unsigned int pos = 0;
+
+        for (unsigned int i = 0, rest = index; i < 4; ++i, rest /= 3) {
+            lens[i] = rest % 3 + 1;
+        }
+
+        for (unsigned int i = 0; i < 4; ++i) {
+            memset(&p_parse->shuffle[i * 4], 0x80, 4);
+            for (unsigned int k = 0; k < lens[i]; ++k) {
+                p_parse->shuffle[i * 4 + 3 - lens[i] + k] = start + k;
+            }
+
+            p_parse->min[i] = lens[i] == 1 ? 0 : lens[i] == 2 ? 10 : 100;
+            start += lens[i] + 1;
+
+            // Formatting source bytes: hundreds at i, tens at 4 + i, ones at 8 + i
+            for (unsigned int k = 3 - lens[i]; k < 3; ++k) {
+                p_format[pos++] = k * 4 + i;
+            }
+
+            if (i < 3) {
+                p_format[pos++] = 12;
+            }
+        }
+
+        // Terminator
+        memset(&p_format[pos], 13, 16 - pos);
+    }
+}
+
+/**
+ * Load 16 bytes, which may extend past the end of a string
+ * Callers make sure the load stays within the string's page
+ *
+ * @param p Pointer
+ * @return Bytes
+ */
+__attribute__((target("sse4.1"), no_sanitize("address", "thread")))
+static inline __m128i load_str16(const char* p) {
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+/**
+ * Check if a 16-byte load from p could cross into the next page
+ *
+ * @param p Pointer
+ * @return 1 if it could, 0 otherwise
+ */
+static inline int may_cross_page(const char* p) {
+    return ((uintptr_t)p & (MIN_PAGE_SIZE - 1)) > MIN_PAGE_SIZE - 16;
+}
+
+/**
+ * Parse an IPv4 address string (see net_utils_ip_parse())
+ *
+ * @param ip_addr IPv4 address string
+ * @param long_addr_out Output for the address
+ * @return 0 on success, -1 if ip_addr is invalid
+ */
+__attribute__((target("sse4.1")))
+static inline int ip_parse_sse41(const char* ip_addr, uint32_t* long_addr_out) {
+    if (may_cross_page(ip_addr)) {
+        return net_utils_ip_parse(ip_addr, long_addr_out);
+    }
+
+    const __m128i chars = load_str16(ip_addr);
+
+    // Valid addresses are at most 15 characters, so the terminator is loaded
+    const unsigned int terminators = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_setzero_si128()));
+    if (terminators == 0) {
+        return -1;
+    }
+
+    const unsigned int len = __builtin_ctz(terminators);
+    const unsigned int in_str = (1U << len) - 1;
+
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const unsigned int digit_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+    unsigned int dot_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))) & in_str;
+
+    if (((digit_mask | dot_mask) & in_str) != in_str || __builtin_popcount(dot_mask) != 3) {
+        return -1;
+    }
+
+    const unsigned int dot0 = __builtin_ctz(dot_mask);
+    dot_mask &= dot_mask - 1;
+    const unsigned int dot1 = __builtin_ctz(dot_mask);
+    dot_mask &= dot_mask - 1;
+    const unsigned int dot2 = __builtin_ctz(dot_mask);
+
+    const unsigned int len0 = dot0;
+    const unsigned int len1 = dot1 - dot0 - 1;
+    const unsigned int len2 = dot2 - dot1 - 1;
+    const unsigned int len3 = len - dot2 - 1;
+
+    // Empty octets wrap around
+    if (len0 - 1 > 2 || len1 - 1 > 2 || len2 - 1 > 2 || len3 - 1 > 2) {
+        return -1;
+    }
+
+    const ip_parse_pattern* p_pattern = &ip_parse_patterns[octet_pattern_index(len0, len1, len2, len3)];
+
+    // Each lane holds [hundreds, tens, ones, 0]: weigh the digits and sum them up per lane
+    const __m128i aligned = _mm_shuffle_epi8(digits, _mm_load_si128((const __m128i *)p_pattern->shuffle));
+    const __m128i octets = _mm_madd_epi16(
+        _mm_maddubs_epi16(aligned, _mm_set1_epi32(100 | 10 << 8 | 1 << 16)),
+        _mm_set1_epi16(1)
+    );
+
+    const __m128i invalid = _mm_or_si128(
+        _mm_cmpgt_epi32(octets, _mm_set1_epi32(255)),
+        _mm_cmplt_epi32(octets, _mm_load_si128((const __m128i *)p_pattern->min))
+    );
+    if (!_mm_testz_si128(invalid, invalid)) {
+        return -1;
+    }
+
+    // First octet is the most significant byte
+    const __m128i bytes = _mm_shuffle_epi8(octets, _mm_setr_epi8(12, 8, 4, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+    *long_addr_out = _mm_cvtsi128_si32(bytes);
+
+    return 0;
+}
+
+/**
+ * Format an IPv4 address
+ *
+ * @param long_addr Address
+ * @param ip_addr_out Output buffer of NET_UTILS_IP_STR_SIZE bytes (all are written)
+ */
+__attribute__((target("sse4.1")))
+static inline void ip_format_sse41(const uint32_t long_addr, char* ip_addr_out) {
+    // 16-bit lanes 0-3 hold the octets, most significant first
+    const __m128i octets = _mm_cvtepu8_epi16(_mm_cvtsi32_si128(__builtin_bswap32(long_addr)));
+
+    // Divide by 100 and 10 with multiplies (exact for values below 256)
+    const __m128i hundreds = _mm_mulhi_epu16(octets, _mm_set1_epi16(656));
+    const __m128i rest = _mm_sub_epi16(octets, _mm_mullo_epi16(hundreds, _mm_set1_epi16(100)));
+    const __m128i tens = _mm_mulhi_epu16(rest, _mm_set1_epi16(6554));
+    const __m128i ones = _mm_sub_epi16(rest, _mm_mullo_epi16(tens, _mm_set1_epi16(10)));
+
+    // Hundreds in bytes 0-3, tens in 4-7, ones in 8-11, then a dot and a terminator
+    const __m128i chars = _mm_add_epi8(
+        _mm_packus_epi16(_mm_unpacklo_epi64(hundreds, tens), ones),
+        _mm_setr_epi8('0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '.', 0, 0, 0)
+    );
+
+    // Octet lengths minus one, weighed into the pattern index
+    const __m128i extra_digits = _mm_sub_epi16(
+        _mm_setzero_si128(),
+        _mm_add_epi16(_mm_cmpgt_epi16(octets, _mm_set1_epi16(9)), _mm_cmpgt_epi16(octets, _mm_set1_epi16(99)))
+    );
+    const __m128i weighted = _mm_madd_epi16(extra_digits, _mm_setr_epi16(1, 3, 9, 27, 0, 0, 0, 0));
+    const unsigned int index = _mm_cvtsi128_si32(weighted) + _mm_extract_epi32(weighted, 1);
+
+    _mm_storeu_si128(
+        (__m128i *)ip_addr_out,
+        _mm_shuffle_epi8(chars, _mm_load_si128((const __m128i *)ip_format_patterns[index]))
+    );
+}
+
+/**
+ * Parse an ethernet address string
+ *
+ * @param ether_str Ethernet address string
+ * @param ether_addr_out Output for the 6-byte address
+ * @return 0 on success, -1 if ether_str is invalid
+ */
+__attribute__((target("sse4.1")))
+static inline int ether_parse_sse41(const char* ether_str, uint8_t* ether_addr_out) {
+    if (may_cross_page(ether_str)) {
+        return net_utils_ether_parse(ether_str, ether_addr_out);
+    }
+
+    const __m128i chars = load_str16(ether_str);
+
+    // Colons at 2, 5, 8, 11 and 14, and no terminator before the last two characters
+    // (which are only read once the string is known to reach them)
+    const unsigned int terminators = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_setzero_si128()));
+    const unsigned int colon_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(':')));
+    if (terminators != 0 || (colon_mask & 0x4924) != 0x4924 || ether_str[16] == 0 || ether_str[17] != 0) {
+        return -1;
+    }
+
+    // Gather the 12 hex digits
+    const __m128i hex = _mm_insert_epi8(
+        _mm_shuffle_epi8(chars, _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, -1, -1, -1, -1, -1)),
+        ether_str[16],
+        11
+    );
+
+    const __m128i digits = _mm_sub_epi8(hex, _mm_set1_epi8('0'));
+    const __m128i letters = _mm_sub_epi8(_mm_or_si128(hex, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+    if ((_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) & 0xFFF) != 0xFFF) {
+        return -1;
+    }
+
+    // Combine each pair of nibbles (high * 16 + low)
+    const __m128i nibbles = _mm_blendv_epi8(_mm_add_epi8(letters, _mm_set1_epi8(10)), digits, is_digit);
+    const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(nibbles, _mm_set1_epi16(16 | 1 << 8)), _mm_setzero_si128());
+
+    uint64_t addr;
+    _mm_storel_epi64((__m128i *)&addr, bytes);
+    memcpy(ether_addr_out, &addr, 6);
+
+    return 0;
+}
+
+/**
+ * Format an ethernet address
+ *
+ * @param ether_addr 6-byte address
+ * @param ether_str_out Output buffer of NET_UTILS_ETHER_STR_SIZE bytes
+ */
+__attribute__((target("sse4.1")))
+static inline void ether_format_sse41(const uint8_t* ether_addr, char* ether_str_out) {
+    // Load exactly 6 bytes (reading 8 would run past the last address)
+    uint32_t low;
+    uint16_t high;
+    memcpy(&low, ether_addr, 4);
+    memcpy(&high, &ether_addr[4], 2);
+
+    const __m128i bytes = _mm_insert_epi16(_mm_cvtsi32_si128(low), high, 2);
+    const __m128i low_nibble = _mm_set1_epi8(0xF);
+
+    // High and low nibble of each byte, in string order
+    const __m128i nibbles = _mm_unpacklo_epi8(
+        _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble),
+        _mm_and_si128(bytes, low_nibble)
+    );
+    const __m128i hex = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)hex_digits), nibbles);
+
+    // Make room for the colons (the last digit doesn't fit in 16 bytes)
+    const __m128i spread = _mm_shuffle_epi8(hex, _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10));
+    const __m128i colons = _mm_setr_epi8(0, 0, ':', 0, 0, ':', 0, 0, ':', 0, 0, ':', 0, 0, ':', 0);
+
+    _mm_storeu_si128((__m128i *)ether_str_out, _mm_or_si128(spread, colons));
+    ether_str_out[16] = (char)_mm_extract_epi8(hex, 11);
+    ether_str_out[17] = 0;
+}
+
+__attribute__((target("sse4.1")))
+static size_t ip_parse_many_sse41(const char* const* ip_addrs, const size_t count, uint32_t* long_addrs_out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (ip_parse_sse41(ip_addrs[i], &long_addrs_out[i]) != 0) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+__attribute__((target("sse4.1")))
+static void ip_format_many_sse41(
+    const uint32_t* long_addrs,
+    const size_t count,
+    char (*ip_addrs_out)[NET_UTILS_IP_STR_SIZE]
+) {
+    for (size_t i = 0; i < count; ++i) {
+        ip_format_sse41(long_addrs[i], ip_addrs_out[i]);
+    }
+}
+
+__attribute__((target("sse4.1")))
+static size_t ether_parse_many_sse41(const char* const* ether_strs, const size_t count, uint8_t* ether_addrs_out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (ether_parse_sse41(ether_strs[i], &ether_addrs_out[i * 6]) != 0) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+__attribute__((target("sse4.1")))
+static void ether_format_many_sse41(
+    const uint8_t* ether_addrs,
+    const size_t count,
+    char (*ether_strs_out)[NET_UTILS_ETHER_STR_SIZE]
+) {
+    for (size_t i = 0; i < count; ++i) {
+        ether_format_sse41(&ether_addrs[i * 6], ether_strs_out[i]);
+    }
+}
+
+static const batch_kernels sse41_kernels = {
+    ip_parse_many_sse41,
+    ip_format_many_sse41,
+    ether_parse_many_sse41,
+    ether_format_many_sse41,
+};
+
+#endif
+
+/**
+ * Kernels in use
+ */
+static const batch_kernels* kernels = &scalar_kernels;
+static net_utils_batch_impl kernels_impl = NET_UTILS_BATCH_SCALAR;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Check if the CPU supports an implementation
+ *
+ * @param impl Implementation
+ * @return 1 if supported, 0 otherwise
+ */
+static int impl_supported(const net_utils_batch_impl impl) {
+    switch (impl) {
+        case NET_UTILS_BATCH_SCALAR:
+            return 1;
+
+#ifdef HAVE_X86_KERNELS
+        case NET_UTILS_BATCH_SSE41:
+            return __builtin_cpu_supports("sse4.1");
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Pick the fastest implementation the CPU supports (once per process)
+ */
+static void init_kernels(void) {
+#ifdef HAVE_X86_KERNELS
+    init_octet_patterns();
+
+    if (impl_supported(NET_UTILS_BATCH_SSE41)) {
+        kernels = &sse41_kernels;
+        kernels_impl = NET_UTILS_BATCH_SSE41;
+    }
+#endif
+}
+
+net_utils_batch_impl net_utils_batch_get_impl(void) {
+    pthread_once(&kernels_once, init_kernels);
+
+    return kernels_impl;
+}
+
+int net_utils_batch_set_impl(const net_utils_batch_impl impl) {
+    pthread_once(&kernels_once, init_kernels);
+
+    if (!impl_supported(impl)) {
+        return -1;
+    }
+
+#ifdef HAVE_X86_KERNELS
+    kernels = impl == NET_UTILS_BATCH_SSE41 ? &sse41_kernels : &scalar_kernels;
+#endif
+    kernels_impl = impl;
+
+    return 0;
+}
+
+size_t net_utils_ip_parse_many(const char* const* ip_addrs, const size_t count, uint32_t* long_addrs_out) {
+    pthread_once(&kernels_once, init_kernels);
+
+    return kernels->ip_parse_many(ip_addrs, count, long_addrs_out);
+}
+
+void net_utils_ip_format_many(
+    const uint32_t* long_addrs,
+    const size_t count,
+    char (*ip_addrs_out)[NET_UTILS_IP_STR_SIZE]
+) {
+    pthread_once(&kernels_once, init_kernels);
+
+    kernels->ip_format_many(long_addrs, count, ip_addrs_out);
+}
+
+size_t net_utils_ether_parse_many(const char* const* ether_strs, const size_t count, uint8_t* ether_addrs_out) {
+    pthread_once(&kernels_once, init_kernels);
+
+    return kernels->ether_parse_many(ether_strs, count, ether_addrs_out);
+}
+
+void net_utils_ether_format_many(
+    const uint8_t* ether_addrs,
+    const size_t count,
+    char (*ether_strs_out)[NET_UTILS_ETHER_STR_SIZE]
+) {
+    pthread_once(&kernels_once, init_kernels);
+
+    kernels->ether_format_many(ether_addrs, count, ether_strs_out);
+}
@@ -0,0 +1,99 @@
+#ifndef __NET_UTILS_BATCH_H__
+#define __NET_UTILS_BATCH_H__
+
+/**
+ * Batch conversion of IPv4 and ethernet addresses between text and binary
+ *
+ * Meant for bulk input such as address lists: each call converts a whole
+ * array, using SIMD kernels when the CPU supports them (picked on first use)
+ * and the scalar net_utils functions otherwise. All implementations accept
+ * exactly the same input and produce the same output.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net_utils.h"
+
+/**
+ * Batch conversion implementations
+ */
+typedef enum net_utils_batch_impl {
+    /**
+     * Portable, one address at a time
+     */
+    NET_UTILS_BATCH_SCALAR,
+
+    /**
+     * x86 SSE4.1 kernels
+     */
+    NET_UTILS_BATCH_SSE41,
+} net_utils_batch_impl;
+
+/**
+ * Get the implementation batch conversions currently use
+ *
+ * @return Implementation
+ */
+net_utils_batch_impl net_utils_batch_get_impl(void);
+
+/**
+ * Force batch conversions to use an implementation (for tests and benchmarks)
+ * Must not be called while another thread is converting
+ *
+ * @param impl Implementation
+ * @return 0 on success, -1 if the CPU doesn't support impl
+ */
+int net_utils_batch_set_impl(net_utils_batch_impl impl);
+
+/**
+ * Parse an array of IPv4 address strings (see net_utils_ip_parse())
+ * Stops at the first invalid string: to skip it, call again from the index
+ * after it
+ *
+ * @param ip_addrs IPv4 address strings to parse
+ * @param count Number of strings
+ * @param long_addrs_out Output for count addresses in host byte order
+ * @return Index of the first invalid string (or count if all were valid)
+ */
+size_t net_utils_ip_parse_many(const char* const* ip_addrs, size_t count, uint32_t* long_addrs_out);
+
+/**
+ * Format an array of IPv4 addresses as dotted-quad strings
+ *
+ * @param long_addrs Addresses in host byte order
+ * @param count Number of addresses
+ * @param ip_addrs_out Output for count strings
+ */
+void net_utils_ip_format_many(
+    const uint32_t* long_addrs,
+    size_t count,
+    char (*ip_addrs_out)[NET_UTILS_IP_STR_SIZE]
+);
+
+/**
+ * Parse an array of ethernet address strings
+ * Each string must be six pairs of hex digits (either case) separated by
+ * colons, e.g. "ab:57:d8:36:da:88". Stops at the first invalid string.
+ *
+ * @param ether_strs Ethernet address strings to parse
+ * @param count Number of strings
+ * @param ether_addrs_out Output for count 6-byte addresses, stored back to back
+ * @return Index of the first invalid string (or count if all were valid)
+ */
+size_t net_utils_ether_parse_many(const char* const* ether_strs, size_t count, uint8_t* ether_addrs_out);
+
+/**
+ * Format an array of ethernet addresses as lowercase colon-separated strings
+ *
+ * @param ether_addrs count 6-byte addresses, stored back to back
+ * @param count Number of addresses
+ * @param ether_strs_out Output for count strings
+ */
+void net_utils_ether_format_many(
+    const uint8_t* ether_addrs,
+    size_t count,
+    char (*ether_strs_out)[NET_UTILS_ETHER_STR_SIZE]
+);
+
+#endif
@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "prefix_set.h"
+#include "net_utils.h"
+
+/**
+ * Number of root table entries (indexed by the 16 most significant bits)
+ */
+#define ROOT_SIZE (1 << 16)
+
+/**
+ * Number of entries per chunk (indexed by 8 bits)
+ */
+#define CHUNK_SIZE (1 << 8)
+
+/**
+ * Number of addresses whose table reads are overlapped by prefix_set_lookup_many()
+ */
+#define LOOKUP_BATCH 16
+
+/**
+ * Tables being compiled by prefix_set_build()
+ */
+typedef struct prefix_tables {
+    uint32_t* root;
+    uint32_t* chunks;
+    size_t chunk_count;
+    size_t chunk_capacity;
+} prefix_tables;
+
+/**
+ * Prefix with the position it was added at (so sorting keeps the last
+ * duplicate last)
+ */
+typedef struct sorted_prefix {
+    const prefix_set_prefix* prefix;
+    size_t order;
+} sorted_prefix;
+
+/**
+ * Order prefixes by length, then by when they were added
+ */
+static int sorted_prefix_cmp(const void* a, const void* b) {
+    const sorted_prefix* p_a = a;
+    const sorted_prefix* p_b = b;
+
+    if (p_a->prefix->net_bits != p_b->prefix->net_bits) {
+        return p_a->prefix->net_bits < p_b->prefix->net_bits ? -1 : 1;
+    }
+
+    return p_a->order < p_b->order ? -1 : p_a->order > p_b->order;
+}
+
+/**
+ * Get the chunk an entry points to, replacing the entry with a new chunk
+ * filled with the entry's value if it doesn't point to one yet
+ *
+ * @param tables Tables being compiled
+ * @param entry Entry (an index, as the chunk array may move)
+ * @param in_chunks 1 if entry indexes the chunk array, 0 if the root table
+ * @return Chunk index (or -1 on failure)
+ */
+static long ensure_chunk(prefix_tables* tables, const size_t entry, const int in_chunks) {
+    uint32_t value = in_chunks ? tables->chunks[entry] : tables->root[entry];
+
+    if (value & PREFIX_SET_CHUNK) {
+        return value & ~PREFIX_SET_CHUNK;
+    }
+
+    if (tables->chunk_count == tables->chunk_capacity) {
+        const size_t new_capacity = tables->chunk_capacity * 2;
+
+        uint32_t* new_chunks = realloc(tables->chunks, new_capacity * CHUNK_SIZE * sizeof(uint32_t));
+        if (new_chunks == NULL) {
+            perror("prefix_set_build: realloc() failed");
+            return -1;
+        }
+
+        tables->chunks = new_chunks;
+        tables->chunk_capacity = new_capacity;
+    }
+
+    const size_t chunk = tables->chunk_count++;
+
+    // The whole chunk inherits the value of the shorter prefix it was split from
+    uint32_t* p_chunk = &tables->chunks[chunk * CHUNK_SIZE];
+    for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+        p_chunk[i] = value;
+    }
+
+    value = PREFIX_SET_CHUNK | chunk;
+    if (in_chunks) {
+        tables->chunks[entry] = value;
+    }
+    else {
+        tables->root[entry] = value;
+    }
+
+    return chunk;
+}
+
+/**
+ * Set a run of entries
+ *
+ * @param entries First entry
+ * @param count Number of entries
+ * @param value_index Value index to store
+ */
+static void fill_entries(uint32_t* entries, const size_t count, const uint32_t value_index) {
+    for (size_t i = 0; i < count; ++i) {
+        entries[i] = value_index;
+    }
+}
+
+/**
+ * Insert a prefix into the tables
+ * Prefixes must be inserted shortest first: entries are overwritten without
+ * checking for chunks, which only longer prefixes create
+ *
+ * @param tables Tables being compiled
+ * @param prefix Prefix
+ * @param value_index Value index of the prefix
+ * @return 0 on success, -1 on failure
+ */
+static int insert_prefix(prefix_tables* tables, const prefix_set_prefix* prefix, const uint32_t value_index) {
+    const uint32_t network = prefix->network;
+    const uint8_t net_bits = prefix->net_bits;
+
+    if (net_bits <= 16) {
+        fill_entries(&tables->root[network >> 16], (size_t)1 << (16 - net_bits), value_index);
+        return 0;
+    }
+
+    const long chunk = ensure_chunk(tables, network >> 16, 0);
+    if (chunk < 0) {
+        return -1;
+    }
+
+    const size_t entry = (size_t)chunk * CHUNK_SIZE + (network >> 8 & 0xFF);
+
+    if (net_bits <= 24) {
+        fill_entries(&tables->chunks[entry], (size_t)1 << (24 - net_bits), value_index);
+        return 0;
+    }
+
+    const long last_chunk = ensure_chunk(tables, entry, 1);
+    if (last_chunk < 0) {
+        return -1;
+    }
+
+    fill_entries(
+        &tables->chunks[(size_t)last_chunk * CHUNK_SIZE + (network & 0xFF)],
+        (size_t)1 << (32 - net_bits),
+        value_index
+    );
+
+    return 0;
+}
+
+int prefix_set_init(prefix_set* set) {
+    memset(set, 0, sizeof(prefix_set));
+
+    // An empty set is built right away, so lookups never need to check
+    return prefix_set_build(set);
+}
+
+int prefix_set_add(prefix_set* set, const uint32_t network, const uint8_t net_bits, void* value) {
+    if (net_bits > 32) {
+        fprintf(stderr, "prefix_set_add: invalid prefix length %u\n", net_bits);
+        return -1;
+    }
+
+    if (value == NULL) {
+        fprintf(stderr, "prefix_set_add: value can't be NULL\n");
+        return -1;
+    }
+
+    if (set->prefix_count == set->prefix_capacity) {
+        const size_t new_capacity = set->prefix_capacity > 0 ? set->prefix_capacity * 2 : 16;
+
+        prefix_set_prefix* new_prefixes = realloc(set->prefixes, new_capacity * sizeof(prefix_set_prefix));
+        if (new_prefixes == NULL) {
+            perror("prefix_set_add: realloc() failed");
+            return -1;
+        }
+
+        set->prefixes = new_prefixes;
+        set->prefix_capacity = new_capacity;
+    }
+
+    prefix_set_prefix* prefix = &set->prefixes[set->prefix_count++];
+    prefix->network = net_bits == 0 ? 0 : network & ~0U << (32 - net_bits);
+    prefix->net_bits = net_bits;
+    prefix->value = value;
+
+    return 0;
+}
+
+int prefix_set_add_cidr(prefix_set* set, const char* cidr, void* value) {
+    char ip_addr[NET_UTILS_IP_STR_SIZE];
+    uint32_t network;
+    unsigned int net_bits = 32;
+
+    const char* slash = strchr(cidr, '/');
+    const size_t ip_len = slash != NULL ? (size_t)(slash - cidr) : strlen(cidr);
+
+    if (ip_len >= sizeof(ip_addr)) {
+        return -1;
+    }
+
+    memcpy(ip_addr, cidr, ip_len);
+    ip_addr[ip_len] = 0;
+
+    if (net_utils_ip_parse(ip_addr, &network) != 0) {
+        return -1;
+    }
+
+    if (slash != NULL) {
+        // One or two digits, without a leading zero
+        const char* p_bits = slash + 1;
+        if (p_bits[0] < '0' || p_bits[0] > '9' || (p_bits[0] == '0' && p_bits[1] != 0)) {
+            return -1;
+        }
+
+        net_bits = p_bits[0] - '0';
+        if (p_bits[1] != 0) {
+            if (p_bits[1] < '0' || p_bits[1] > '9' || p_bits[2] != 0) {
+                return -1;
+            }
+
+            net_bits = net_bits * 10 + (p_bits[1] - '0');
+        }
+
+        if (net_bits > 32) {
+            return -1;
+        }
+    }
+
+    return prefix_set_add(set, network, net_bits, value);
+}
+
+int prefix_set_build(prefix_set* set) {
+    prefix_tables tables = {0};
+    sorted_prefix* sorted = NULL;
+    void** values = NULL;
+
+    tables.root = calloc(ROOT_SIZE, sizeof(uint32_t));
+    tables.chunk_capacity = 16;
+    tables.chunks = malloc(tables.chunk_capacity * CHUNK_SIZE * sizeof(uint32_t));
+    values = malloc((set->prefix_count + 1) * sizeof(void *));
+    sorted = malloc((set->prefix_count + 1) * sizeof(sorted_prefix));
+
+    if (tables.root == NULL || tables.chunks == NULL || values == NULL || sorted == NULL) {
+        perror("prefix_set_build: malloc() failed");
+        goto error;
+    }
+
+    for (size_t i = 0; i < set->prefix_count; ++i) {
+        sorted[i].prefix = &set->prefixes[i];
+        sorted[i].order = i;
+    }
+
+    qsort(sorted, set->prefix_count, sizeof(sorted_prefix), sorted_prefix_cmp);
+
+    // Longer prefixes overwrite the entries of the shorter ones containing them
+    values[0] = NULL;
+    for (size_t i = 0; i < set->prefix_count; ++i) {
+        values[i + 1] = sorted[i].prefix->value;
+
+        if (insert_prefix(&tables, sorted[i].prefix, i + 1) != 0) {
+            goto error;
+        }
+    }
+
+    free(sorted);
+
+    free(set->root);
+    free(set->chunks);
+    free(set->values);
+
+    set->root = tables.root;
+    set->chunks = tables.chunks;
+    set->chunk_count = tables.chunk_count;
+    set->chunk_capacity = tables.chunk_capacity;
+    set->values = values;
+
+    return 0;
+
+error:
+    free(tables.root);
+    free(tables.chunks);
+    free(values);
+    free(sorted);
+
+    return -1;
+}
+
+void* prefix_set_lookup(const prefix_set* set, const uint32_t addr) {
+    uint32_t entry = set->root[addr >> 16];
+
+    if (entry & PREFIX_SET_CHUNK) {
+        entry = set->chunks[(size_t)(entry & ~PREFIX_SET_CHUNK) * CHUNK_SIZE + (addr >> 8 & 0xFF)];
+
+        if (entry & PREFIX_SET_CHUNK) {
+            entry = set->chunks[(size_t)(entry & ~PREFIX_SET_CHUNK) * CHUNK_SIZE + (addr & 0xFF)];
+        }
+    }
+
+    return set->values[entry];
+}
+
+void prefix_set_lookup_many(const prefix_set* set, const uint32_t* addrs, const size_t count, void** values_out) {
+    size_t i = 0;
+
+    // Walk LOOKUP_BATCH addresses one level at a time, so their cache misses overlap.
+    // Addresses that already reached their value point at their own entry instead.
+    for (; i + LOOKUP_BATCH <= count; i += LOOKUP_BATCH) {
+        const uint32_t* p_entries[LOOKUP_BATCH];
+        uint32_t entries[LOOKUP_BATCH];
+
+        for (size_t k = 0; k < LOOKUP_BATCH; ++k) {
+            entries[k] = set->root[addrs[i + k] >> 16];
+        }
+
+        // Start loading the chunk entries of all addresses before using any
+        for (size_t k = 0; k < LOOKUP_BATCH; ++k) {
+            p_entries[k] = entries[k] & PREFIX_SET_CHUNK
+                ? &set->chunks[(size_t)(entries[k] & ~PREFIX_SET_CHUNK) * CHUNK_SIZE + (addrs[i + k] >> 8 & 0xFF)]
+                : &entries[k];
+            __builtin_prefetch(p_entries[k]);
+        }
+
+        for (size_t k = 0; k < LOOKUP_BATCH; ++k) {
+            entries[k] = *p_entries[k];
+            p_entries[k] = entries[k] & PREFIX_SET_CHUNK
+                ? &set->chunks[(size_t)(entries[k] & ~PREFIX_SET_CHUNK) * CHUNK_SIZE + (addrs[i + k] & 0xFF)]
+                : &entries[k];
+            __builtin_prefetch(p_entries[k]);
+        }
+
+        for (size_t k = 0; k < LOOKUP_BATCH; ++k) {
+            values_out[i + k] = set->values[*p_entries[k]];
+        }
+    }
+
+    for (; i < count; ++i) {
+        values_out[i] = prefix_set_lookup(set, addrs[i]);
+    }
+}
+
+int prefix_set_destroy(prefix_set* set) {
+    if (set->root == NULL) {
+        return -1;
+    }
+
+    free(set->prefixes);
+    free(set->root);
+    free(set->chunks);
+    free(set->values);
+
+    memset(set, 0, sizeof(prefix_set));
+
+    return 0;
+}
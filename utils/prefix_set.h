@@ -0,0 +1,147 @@
+#ifndef __PREFIX_SET_H__
+#define __PREFIX_SET_H__
+
+/**
+ * Set of IPv4 network prefixes with longest-prefix-match lookups
+ *
+ * Prefixes are added first, then compiled by prefix_set_build() into a
+ * multibit trie with strides of 16, 8 and 8 bits. Every lookup then reads at
+ * most three table entries, however many prefixes the set holds: one in a
+ * 65536-entry root table and up to two in 256-entry chunks that only exist
+ * below prefixes longer than /16. Values of shorter prefixes are pushed down
+ * into the chunks, so a lookup stops at the first entry that isn't a chunk.
+ *
+ * Lookups don't modify the set, so a built set may be shared by any number of
+ * reading threads.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Table entry bit marking a chunk index
+ */
+#define PREFIX_SET_CHUNK 0x80000000U
+
+/**
+ * Prefix waiting to be compiled
+ */
+typedef struct prefix_set_prefix {
+    /**
+     * Network address in host byte order (host bits cleared)
+     */
+    uint32_t network;
+
+    /**
+     * Number of network bits (0-32)
+     */
+    uint8_t net_bits;
+
+    /**
+     * Value returned by lookups matching the prefix
+     */
+    void* value;
+} prefix_set_prefix;
+
+/**
+ * Prefix set
+ */
+typedef struct prefix_set {
+    /**
+     * Added prefixes, in the order they were added
+     */
+    prefix_set_prefix* prefixes;
+    size_t prefix_count;
+    size_t prefix_capacity;
+
+    /**
+     * Root table indexed by the 16 most significant address bits
+     *
+     * Entries with the PREFIX_SET_CHUNK bit set hold the index of a chunk,
+     * others the index of a value (0 for no match).
+     */
+    uint32_t* root;
+
+    /**
+     * 256-entry chunks indexed by the next 8 address bits, back to back
+     */
+    uint32_t* chunks;
+    size_t chunk_count;
+    size_t chunk_capacity;
+
+    /**
+     * Values of the compiled prefixes (values[0] is NULL, for no match)
+     */
+    void** values;
+} prefix_set;
+
+/**
+ * Initialize prefix set (empty, but ready for lookups)
+ *
+ * @param set Prefix set
+ * @return 0 on success, -1 on failure
+ */
+int prefix_set_init(prefix_set* set);
+
+/**
+ * Add a prefix
+ * Host bits of network are ignored. If the same prefix is added again, the
+ * last value wins. Takes effect on the next prefix_set_build().
+ *
+ * @param set Prefix set
+ * @param network Network address in host byte order
+ * @param net_bits Number of network bits (0-32)
+ * @param value Value to return for addresses matching the prefix (not NULL)
+ * @return 0 on success, -1 on failure
+ */
+int prefix_set_add(prefix_set* set, uint32_t network, uint8_t net_bits, void* value);
+
+/**
+ * Add a prefix in CIDR notation
+ * Accepts "a.b.c.d/n", or "a.b.c.d" for a single address (/32)
+ *
+ * @param set Prefix set
+ * @param cidr Prefix string
+ * @param value Value to return for addresses matching the prefix (not NULL)
+ * @return 0 on success, -1 on failure (including an invalid cidr)
+ */
+int prefix_set_add_cidr(prefix_set* set, const char* cidr, void* value);
+
+/**
+ * Compile all prefixes added so far into the lookup tables
+ * Lookups only see the prefixes added before the last build
+ *
+ * @param set Prefix set
+ * @return 0 on success, -1 on failure (the previous tables are kept)
+ */
+int prefix_set_build(prefix_set* set);
+
+/**
+ * Find the longest prefix containing an address
+ *
+ * @param set Prefix set
+ * @param addr Address in host byte order
+ * @return Value of the longest matching prefix (or NULL if none matches)
+ */
+void* prefix_set_lookup(const prefix_set* set, uint32_t addr);
+
+/**
+ * Find the longest prefix containing each of an array of addresses
+ * Faster than separate lookups: the table reads of several addresses overlap
+ *
+ * @param set Prefix set
+ * @param addrs Addresses in host byte order
+ * @param count Number of addresses
+ * @param values_out Output for count values (NULL where no prefix matches)
+ */
+void prefix_set_lookup_many(const prefix_set* set, const uint32_t* addrs, size_t count, void** values_out);
+
+/**
+ * Release all memory
+ *
+ * @param set Prefix set
+ * @return 0 on success, -1 on failure
+ */
+int prefix_set_destroy(prefix_set* set);
+
+#endif
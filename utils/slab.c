@@ -0,0 +1,155 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "slab.h"
+
+/**
+ * Default number of objects per chunk
+ */
+#define DEFAULT_CHUNK_OBJECTS 256
+
+/**
+ * Chunk header, followed by chunk_objects objects
+ */
+typedef struct slab_chunk {
+    struct slab_chunk* next;
+
+    /**
+     * Keeps objects aligned for any type
+     */
+    max_align_t _align[];
+} slab_chunk;
+
+/**
+ * allocator.alloc implementation
+ *
+ * @param self Slab
+ * @param size Number of bytes (must fit in an object)
+ * @return Object (or NULL on failure)
+ */
+static void* slab_base_alloc(allocator* self, const size_t size) {
+    slab* pool = (slab *)self;
+
+    if (size > pool->object_size) {
+        fprintf(stderr, "slab_alloc: %zu bytes requested from %zu byte slab\n", size, pool->object_size);
+        return NULL;
+    }
+
+    return slab_alloc(pool);
+}
+
+/**
+ * allocator.free implementation
+ *
+ * @param self Slab
+ * @param ptr Object
+ */
+static void slab_base_free(allocator* self, void* ptr) {
+    slab_free((slab *)self, ptr);
+}
+
+/**
+ * allocator.reset implementation
+ *
+ * @param self Slab
+ */
+static void slab_base_reset(allocator* self) {
+    slab_reset((slab *)self);
+}
+
+int slab_init(slab* pool, const size_t object_size, const size_t chunk_objects) {
+    const size_t align = sizeof(void *);
+
+    memset(pool, 0, sizeof(slab));
+
+    pool->base.alloc = slab_base_alloc;
+    pool->base.free = slab_base_free;
+    pool->base.reset = slab_base_reset;
+
+    // Free objects store the free list link in place
+    pool->object_size = object_size < sizeof(void *) ? sizeof(void *) : object_size;
+    pool->object_size = (pool->object_size + align - 1) / align * align;
+    pool->chunk_objects = chunk_objects == 0 ? DEFAULT_CHUNK_OBJECTS : chunk_objects;
+
+    return 0;
+}
+
+/**
+ * Allocate a new chunk and make it the bump allocation region
+ *
+ * @param pool Slab
+ * @return 0 on success, -1 on failure
+ */
+static int add_chunk(slab* pool) {
+    slab_chunk* p_chunk = malloc(sizeof(slab_chunk) + pool->chunk_objects * pool->object_size);
+    if (p_chunk == NULL) {
+        perror("slab_alloc: malloc() failed");
+        return -1;
+    }
+
+    p_chunk->next = pool->chunks;
+    pool->chunks = p_chunk;
+
+    pool->bump = (char *)p_chunk->_align;
+    pool->bump_end = pool->bump + pool->chunk_objects * pool->object_size;
+
+    return 0;
+}
+
+void* slab_alloc(slab* pool) {
+    void* object = pool->free_list;
+
+    if (object != NULL) {
+        // Reuse a freed object
+        memcpy(&pool->free_list, object, sizeof(void *));
+    }
+    else {
+        if (pool->bump == pool->bump_end && add_chunk(pool) != 0) {
+            return NULL;
+        }
+
+        object = pool->bump;
+        pool->bump += pool->object_size;
+    }
+
+    ++pool->size;
+
+    return object;
+}
+
+void slab_free(slab* pool, void* object) {
+    if (object == NULL) {
+        return;
+    }
+
+    memcpy(object, &pool->free_list, sizeof(void *));
+    pool->free_list = object;
+
+    --pool->size;
+}
+
+void slab_reset(slab* pool) {
+    slab_chunk* p_chunk = pool->chunks;
+
+    while (p_chunk != NULL) {
+        slab_chunk* p_next = p_chunk->next;
+        free(p_chunk);
+        p_chunk = p_next;
+    }
+
+    pool->chunks = NULL;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->size = 0;
+}
+
+int slab_destroy(slab* pool) {
+    slab_reset(pool);
+
+    pool->object_size = 0;
+    pool->chunk_objects = 0;
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#ifndef __SLAB_H__
+#define __SLAB_H__
+
+/**
+ * Slab allocator for fixed-size objects
+ *
+ * Objects are carved out of large chunks and recycled through a free list,
+ * so allocating and freeing an object is O(1) and never calls malloc()
+ * once the pool is warm. All objects are released at once by slab_reset()
+ * or slab_destroy(), without visiting them individually.
+ */
+
+#include "allocator.h"
+
+/**
+ * Slab
+ */
+typedef struct slab {
+    /**
+     * Allocator interface (so that a slab can be passed as an allocator*)
+     */
+    allocator base;
+
+    /**
+     * Size of each object (rounded up to pointer alignment)
+     */
+    size_t object_size;
+
+    /**
+     * Number of objects per chunk
+     */
+    size_t chunk_objects;
+
+    /**
+     * Allocated chunks, linked through their first word
+     */
+    void* chunks;
+
+    /**
+     * Free objects, linked through their first word
+     */
+    void* free_list;
+
+    /**
+     * Next never-used object in the newest chunk
+     */
+    char* bump;
+
+    /**
+     * End of the newest chunk
+     */
+    char* bump_end;
+
+    /**
+     * Number of objects currently allocated
+     */
+    size_t size;
+} slab;
+
+/**
+ * Initialize slab
+ *
+ * @param pool Slab
+ * @param object_size Size of each object
+ * @param chunk_objects Number of objects to allocate per chunk (0 for default)
+ * @return 0 on success, -1 on failure
+ */
+int slab_init(slab* pool, size_t object_size, size_t chunk_objects);
+
+/**
+ * Allocate an object
+ *
+ * @param pool Slab
+ * @return Object (or NULL on failure)
+ */
+void* slab_alloc(slab* pool);
+
+/**
+ * Return an object to the slab
+ *
+ * @param pool Slab
+ * @param object Object previously returned by slab_alloc()
+ */
+void slab_free(slab* pool, void* object);
+
+/**
+ * Release all objects at once
+ * The slab can still be used afterwards
+ *
+ * @param pool Slab
+ */
+void slab_reset(slab* pool);
+
+/**
+ * Destroy slab and release all objects
+ *
+ * @param pool Slab
+ * @return 0 on success, -1 on failure
+ */
+int slab_destroy(slab* pool);
+
+#endif
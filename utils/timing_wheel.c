@@ -0,0 +1,156 @@
+#include "timing_wheel.h"
+
+/**
+ * Put a timer in the bucket for its deadline, relative to the current tick
+ * The level is the one of the highest bit group in which the deadline and
+ * the current tick differ, so that the timer gets cascaded (or expires) when
+ * the current tick reaches its slot on that level.
+ *
+ * @param wheel Wheel
+ * @param timer Timer with a deadline after the current tick
+ */
+static void place_timer(timing_wheel* wheel, timing_wheel_timer* timer) {
+    const uint64_t diff = timer->deadline ^ wheel->now;
+    const uint32_t level = diff < TIMING_WHEEL_SLOTS ? 0 : (63 - __builtin_clzll(diff)) / TIMING_WHEEL_SLOT_BITS;
+    const uint32_t slot = (timer->deadline >> (level * TIMING_WHEEL_SLOT_BITS)) & (TIMING_WHEEL_SLOTS - 1);
+
+    timer->bucket = level * TIMING_WHEEL_SLOTS + slot;
+    intrusive_list_push_tail(&wheel->buckets[level][slot], &timer->link);
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+/**
+ * Get the next tick with a bucket to cascade or expire
+ * The first non-empty slot of the lowest non-empty level comes first: every
+ * slot of a level is before the current slot of the level above ends.
+ *
+ * @param wheel Non-empty wheel
+ * @return Next tick to process
+ */
+static uint64_t next_tick(const timing_wheel* wheel) {
+    for (uint32_t level = 0; level < TIMING_WHEEL_LEVELS; ++level) {
+        if (wheel->occupied[level] == 0) {
+            continue;
+        }
+
+        const uint32_t shift = level * TIMING_WHEEL_SLOT_BITS;
+        const uint32_t high_shift = shift + TIMING_WHEEL_SLOT_BITS;
+        const uint64_t high = high_shift < 64 ? wheel->now >> high_shift << high_shift : 0;
+
+        return high | (uint64_t)__builtin_ctzll(wheel->occupied[level]) << shift;
+    }
+
+    return UINT64_MAX;
+}
+
+/**
+ * Move the timers of a bucket down to lower levels
+ *
+ * @param wheel Wheel (at the tick the bucket's slot starts at)
+ * @param level Level of the bucket
+ * @param slot Slot of the bucket
+ */
+static void cascade(timing_wheel* wheel, const uint32_t level, const uint32_t slot) {
+    intrusive_list* p_bucket = &wheel->buckets[level][slot];
+    intrusive_list_node* p_node;
+
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+
+    while ((p_node = intrusive_list_pop_head(p_bucket)) != NULL) {
+        place_timer(wheel, INTRUSIVE_LIST_ENTRY(p_node, timing_wheel_timer, link));
+    }
+}
+
+void timing_wheel_init(timing_wheel* wheel, const uint64_t now) {
+    for (uint32_t level = 0; level < TIMING_WHEEL_LEVELS; ++level) {
+        for (uint32_t slot = 0; slot < TIMING_WHEEL_SLOTS; ++slot) {
+            intrusive_list_init(&wheel->buckets[level][slot]);
+        }
+
+        wheel->occupied[level] = 0;
+    }
+
+    wheel->now = now;
+    wheel->size = 0;
+}
+
+void timing_wheel_timer_init(timing_wheel_timer* timer) {
+    intrusive_list_node_init(&timer->link);
+    timer->deadline = 0;
+    timer->bucket = 0;
+}
+
+int timing_wheel_timer_is_pending(const timing_wheel_timer* timer) {
+    return intrusive_list_is_linked(&timer->link);
+}
+
+void timing_wheel_add(timing_wheel* wheel, timing_wheel_timer* timer, const uint64_t deadline) {
+    timer->deadline = deadline > wheel->now ? deadline : wheel->now + 1;
+    place_timer(wheel, timer);
+    ++wheel->size;
+}
+
+void timing_wheel_cancel(timing_wheel* wheel, timing_wheel_timer* timer) {
+    const uint32_t level = timer->bucket / TIMING_WHEEL_SLOTS;
+    const uint32_t slot = timer->bucket % TIMING_WHEEL_SLOTS;
+    intrusive_list* p_bucket = &wheel->buckets[level][slot];
+
+    intrusive_list_unlink(p_bucket, &timer->link);
+    if (intrusive_list_is_empty(p_bucket)) {
+        wheel->occupied[level] &= ~((uint64_t)1 << slot);
+    }
+
+    --wheel->size;
+}
+
+size_t timing_wheel_advance(
+    timing_wheel* wheel,
+    const uint64_t now,
+    const timing_wheel_expire_func expire_func,
+    void* user_arg
+) {
+    size_t expired = 0;
+
+    if (now <= wheel->now) {
+        return 0;
+    }
+
+    while (wheel->size > 0) {
+        const uint64_t tick = next_tick(wheel);
+        if (tick > now) {
+            break;
+        }
+
+        wheel->now = tick;
+
+        // Higher levels first, as they may cascade into the slots of lower
+        // levels starting at the same tick
+        for (uint32_t level = TIMING_WHEEL_LEVELS - 1; level > 0; --level) {
+            const uint32_t shift = level * TIMING_WHEEL_SLOT_BITS;
+            const uint32_t slot = (tick >> shift) & (TIMING_WHEEL_SLOTS - 1);
+
+            if ((tick & (((uint64_t)1 << shift) - 1)) == 0 && (wheel->occupied[level] & ((uint64_t)1 << slot))) {
+                cascade(wheel, level, slot);
+            }
+        }
+
+        // Everything left in the current slot of level 0 expires now. Timers
+        // added by the expire function can't land there (their deadline is
+        // after the current tick).
+        const uint32_t slot = tick & (TIMING_WHEEL_SLOTS - 1);
+        intrusive_list* p_bucket = &wheel->buckets[0][slot];
+        intrusive_list_node* p_node;
+
+        while ((p_node = intrusive_list_pop_head(p_bucket)) != NULL) {
+            --wheel->size;
+            ++expired;
+            expire_func(INTRUSIVE_LIST_ENTRY(p_node, timing_wheel_timer, link), user_arg);
+        }
+
+        wheel->occupied[0] &= ~((uint64_t)1 << slot);
+    }
+
+    wheel->now = now;
+
+    return expired;
+}
@@ -0,0 +1,141 @@
+#ifndef __TIMING_WHEEL_H__
+#define __TIMING_WHEEL_H__
+
+/**
+ * Hierarchical timing wheel
+ *
+ * Schedules intrusive timers on integer ticks (the unit is up to the caller).
+ * Each level has TIMING_WHEEL_SLOTS slots, covering TIMING_WHEEL_SLOTS times
+ * the range of the level below; a timer is put on the lowest level whose
+ * range reaches its deadline, and moved down (cascaded) as time gets closer
+ * to it. Adding and cancelling a timer are O(1), and advancing is amortized
+ * O(1) per expired timer: each level keeps a bitmap of its non-empty slots,
+ * so that advancing skips straight to the next tick with something to do
+ * rather than stepping through idle ticks.
+ *
+ * Timers embed their list node, so the wheel allocates nothing. The wheel
+ * must not be copied or moved once initialized.
+ *
+ * Not thread-safe.
+ */
+
+#include <inttypes.h>
+
+#include "intrusive_list.h"
+
+/**
+ * Number of bits of the deadline each level covers
+ */
+#define TIMING_WHEEL_SLOT_BITS 6
+
+#define TIMING_WHEEL_SLOTS (1 << TIMING_WHEEL_SLOT_BITS)
+
+/**
+ * Number of levels, enough to cover 64-bit deadlines
+ */
+#define TIMING_WHEEL_LEVELS ((64 + TIMING_WHEEL_SLOT_BITS - 1) / TIMING_WHEEL_SLOT_BITS)
+
+/**
+ * Timer (to embed in the struct to schedule)
+ */
+typedef struct timing_wheel_timer {
+    intrusive_list_node link;
+
+    /**
+     * Tick the timer expires at
+     */
+    uint64_t deadline;
+
+    /**
+     * Level * TIMING_WHEEL_SLOTS + slot the timer is in
+     */
+    uint32_t bucket;
+} timing_wheel_timer;
+
+/**
+ * Timing wheel
+ */
+typedef struct timing_wheel {
+    intrusive_list buckets[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS];
+
+    /**
+     * Bitmap of the non-empty slots of each level
+     */
+    uint64_t occupied[TIMING_WHEEL_LEVELS];
+
+    /**
+     * Current tick: all timers with an earlier or equal deadline have expired
+     */
+    uint64_t now;
+
+    /**
+     * Number of pending timers
+     */
+    size_t size;
+} timing_wheel;
+
+/**
+ * Expire function, called for each expired timer
+ * The timer is no longer pending: it may be freed, or added again
+ *
+ * @param timer Expired timer
+ * @param user_arg User argument given to timing_wheel_advance()
+ */
+typedef void (*timing_wheel_expire_func)(timing_wheel_timer* timer, void* user_arg);
+
+/**
+ * Initialize timing wheel
+ *
+ * @param wheel Wheel
+ * @param now Current tick
+ */
+void timing_wheel_init(timing_wheel* wheel, uint64_t now);
+
+/**
+ * Initialize a timer as not pending
+ *
+ * @param timer Timer
+ */
+void timing_wheel_timer_init(timing_wheel_timer* timer);
+
+/**
+ * Check if a timer is pending
+ * (only for timers initialized with timing_wheel_timer_init())
+ *
+ * @param timer Timer
+ * @return 1 if pending, 0 otherwise
+ */
+int timing_wheel_timer_is_pending(const timing_wheel_timer* timer);
+
+/**
+ * Schedule a timer
+ * A deadline that isn't after the current tick expires on the next tick
+ *
+ * @param wheel Wheel
+ * @param timer Timer (not pending)
+ * @param deadline Tick to expire at
+ */
+void timing_wheel_add(timing_wheel* wheel, timing_wheel_timer* timer, uint64_t deadline);
+
+/**
+ * Cancel a pending timer
+ *
+ * @param wheel Wheel
+ * @param timer Pending timer
+ */
+void timing_wheel_cancel(timing_wheel* wheel, timing_wheel_timer* timer);
+
+/**
+ * Advance the wheel to a tick, expiring every timer with a deadline up to it
+ * Timers expire in deadline order. The expire function may add and cancel
+ * timers, including ones expiring during this advance.
+ *
+ * @param wheel Wheel
+ * @param now Tick to advance to (ignored if not after the current tick)
+ * @param expire_func Function to call with each expired timer
+ * @param user_arg Optional argument to pass to the expire function
+ * @return Number of expired timers
+ */
+size_t timing_wheel_advance(timing_wheel* wheel, uint64_t now, timing_wheel_expire_func expire_func, void* user_arg);
+
+#endif
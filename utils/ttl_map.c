@@ -0,0 +1,168 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ttl_map.h"
+
+/**
+ * Map entry
+ */
+typedef struct ttl_map_entry {
+    entry_index_entry kv;
+    timing_wheel_timer timer;
+} ttl_map_entry;
+
+/**
+ * Default clock: monotonic milliseconds
+ *
+ * @param user_arg Unused
+ * @return Current time
+ */
+static uint64_t monotonic_ms(void* user_arg) {
+    struct timespec ts;
+
+    (void)user_arg;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Get the entry holding a timer
+ *
+ * @param timer Timer of the entry
+ * @return Entry
+ */
+static ttl_map_entry* timer_entry(timing_wheel_timer* timer) {
+    return (ttl_map_entry *)((char *)timer - offsetof(ttl_map_entry, timer));
+}
+
+/**
+ * Drop an entry whose timer expired
+ *
+ * @param timer Timer of the entry
+ * @param p_map Map
+ */
+static void expire_entry(timing_wheel_timer* timer, void* p_map) {
+    ttl_map* map = p_map;
+
+    // The timer is no longer pending: only the index still holds the entry
+    entry_index_drop(&map->index, timer_entry(timer));
+    ++map->expirations;
+}
+
+int ttl_map_init(
+    ttl_map* map,
+    const uint32_t size,
+    const hash_table_key_cmp_func key_cmp,
+    const hash_table_key_hash_func key_hash
+) {
+    if (entry_index_init(&map->index, size, sizeof(ttl_map_entry), key_cmp, key_hash) != 0) {
+        return -1;
+    }
+
+    map->clock_func = monotonic_ms;
+    map->clock_func_user_arg = NULL;
+    map->expirations = 0;
+
+    timing_wheel_init(&map->wheel, monotonic_ms(NULL));
+
+    return 0;
+}
+
+int ttl_map_set_clock(ttl_map* map, const ttl_map_clock_func clock_func, void* user_arg) {
+    if (map->wheel.size > 0) {
+        fprintf(stderr, "ttl_map_set_clock: map is not empty\n");
+        return -1;
+    }
+
+    map->clock_func = clock_func;
+    map->clock_func_user_arg = user_arg;
+    timing_wheel_init(&map->wheel, clock_func(user_arg));
+
+    return 0;
+}
+
+void ttl_map_set_release_func(ttl_map* map, const ttl_map_release_func release_func, void* user_arg) {
+    entry_index_set_release_func(&map->index, release_func, user_arg);
+}
+
+void* ttl_map_get(ttl_map* map, const void* key) {
+    ttl_map_expire(map);
+
+    const ttl_map_entry* p_entry = entry_index_get(&map->index, key);
+
+    return p_entry != NULL ? p_entry->kv.value : NULL;
+}
+
+int ttl_map_set(ttl_map* map, void* key, void* value, const uint64_t ttl) {
+    ttl_map_expire(map);
+
+    const uint64_t now = map->wheel.now;
+    const uint64_t deadline = ttl <= UINT64_MAX - now ? now + ttl : UINT64_MAX;
+    ttl_map_entry* p_entry = entry_index_get(&map->index, key);
+
+    if (p_entry != NULL) {
+        if (entry_index_replace(&map->index, p_entry, key, value) != 0) {
+            return -1;
+        }
+
+        timing_wheel_cancel(&map->wheel, &p_entry->timer);
+        timing_wheel_add(&map->wheel, &p_entry->timer, deadline);
+
+        return 0;
+    }
+
+    p_entry = entry_index_add(&map->index, key, value);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    timing_wheel_add(&map->wheel, &p_entry->timer, deadline);
+
+    return 0;
+}
+
+int ttl_map_get_ttl(ttl_map* map, const void* key, uint64_t* ttl) {
+    ttl_map_expire(map);
+
+    const ttl_map_entry* p_entry = entry_index_get(&map->index, key);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    *ttl = p_entry->timer.deadline - map->wheel.now;
+
+    return 0;
+}
+
+int ttl_map_del(ttl_map* map, const void* key) {
+    ttl_map_expire(map);
+
+    ttl_map_entry* p_entry = entry_index_get(&map->index, key);
+    if (p_entry == NULL) {
+        return -1;
+    }
+
+    timing_wheel_cancel(&map->wheel, &p_entry->timer);
+    entry_index_drop(&map->index, p_entry);
+
+    return 0;
+}
+
+size_t ttl_map_expire(ttl_map* map) {
+    return timing_wheel_advance(&map->wheel, map->clock_func(map->clock_func_user_arg), expire_entry, map);
+}
+
+size_t ttl_map_size(ttl_map* map) {
+    ttl_map_expire(map);
+
+    return map->wheel.size;
+}
+
+int ttl_map_destroy(ttl_map* map) {
+    // The wheel only links timers: resetting it leaves the entries to the index
+    timing_wheel_init(&map->wheel, map->wheel.now);
+
+    return entry_index_destroy(&map->index);
+}
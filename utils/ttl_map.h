@@ -0,0 +1,169 @@
+#ifndef __TTL_MAP_H__
+#define __TTL_MAP_H__
+
+/**
+ * Map with expiring entries
+ *
+ * Each entry is set with a time to live, and expires once the clock reaches
+ * its deadline. An open addressing hash_table indexes the entries by key, and
+ * a timing_wheel holds their deadlines, so that setting, deleting and expiring
+ * an entry are O(1): expired entries are found without scanning the table.
+ *
+ * Time comes from a clock function, in whatever unit it returns (monotonic
+ * milliseconds by default). It can be replaced, e.g. for tests to control
+ * time. Each operation reads the clock and expires the entries that are due
+ * first; ttl_map_expire() does only that, for maps that may sit idle.
+ *
+ * Key and value pointers are kept by an entry_index, which hands them to the
+ * release function as described in entry_index.h. Expired entries go through
+ * it like deleted ones.
+ *
+ * Not thread-safe.
+ */
+
+#include <inttypes.h>
+
+#include "entry_index.h"
+#include "timing_wheel.h"
+
+/**
+ * Clock function
+ *
+ * @param user_arg User argument given to ttl_map_set_clock()
+ * @return Current time (must never go backwards)
+ */
+typedef uint64_t (*ttl_map_clock_func)(void* user_arg);
+
+/**
+ * Release function, called with the key and value of each dropped entry
+ *
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param user_arg User argument given to ttl_map_set_release_func()
+ */
+typedef void (*ttl_map_release_func)(void* key, void* value, void* user_arg);
+
+/**
+ * TTL map
+ * Must not be copied or moved once initialized (see timing_wheel)
+ */
+typedef struct ttl_map {
+    /**
+     * Key to entry index, and entry allocator
+     */
+    entry_index index;
+
+    /**
+     * Entry deadlines
+     */
+    timing_wheel wheel;
+
+    ttl_map_clock_func clock_func;
+    void* clock_func_user_arg;
+
+    /**
+     * Number of entries dropped because they expired
+     */
+    uint64_t expirations;
+} ttl_map;
+
+/**
+ * Initialize TTL map, using a monotonic clock in milliseconds
+ *
+ * @param map Map
+ * @param size Initial size of the index
+ * @param key_cmp Key comparator (or NULL to use the hash_table default)
+ * @param key_hash Key hash function (or NULL to use the hash_table default)
+ * @return 0 on success, -1 on failure
+ */
+int ttl_map_init(
+    ttl_map* map,
+    uint32_t size,
+    hash_table_key_cmp_func key_cmp,
+    hash_table_key_hash_func key_hash
+);
+
+/**
+ * Replace the clock of an empty map
+ *
+ * @param map Empty map
+ * @param clock_func Clock function
+ * @param user_arg Optional argument to pass to the clock function
+ * @return 0 on success, -1 if the map isn't empty
+ */
+int ttl_map_set_clock(ttl_map* map, ttl_map_clock_func clock_func, void* user_arg);
+
+/**
+ * Set the function called with the key and value of each dropped entry
+ *
+ * @param map Map
+ * @param release_func Release function (or NULL)
+ * @param user_arg Optional argument to pass to the release function
+ */
+void ttl_map_set_release_func(ttl_map* map, ttl_map_release_func release_func, void* user_arg);
+
+/**
+ * Get value from map
+ *
+ * @param map Map
+ * @param key Key to get value for
+ * @return Value (or NULL if not set or expired)
+ */
+void* ttl_map_get(ttl_map* map, const void* key);
+
+/**
+ * Set value in map, expiring after a time to live
+ * Replaces (and releases) the entry with the same key if there's one
+ *
+ * @param map Map
+ * @param key Key (must stay valid while set)
+ * @param value Value
+ * @param ttl Time to live, in clock units (0 is treated as 1)
+ * @return 0 on success, -1 on failure
+ */
+int ttl_map_set(ttl_map* map, void* key, void* value, uint64_t ttl);
+
+/**
+ * Get the time an entry has left to live
+ *
+ * @param map Map
+ * @param key Key of entry
+ * @param ttl Time to live, in clock units
+ * @return 0 on success, -1 if not set or expired
+ */
+int ttl_map_get_ttl(ttl_map* map, const void* key, uint64_t* ttl);
+
+/**
+ * Delete (and release) entry from map
+ *
+ * @param map Map
+ * @param key Key of entry to delete
+ * @return 0 on success, -1 if not set or expired
+ */
+int ttl_map_del(ttl_map* map, const void* key);
+
+/**
+ * Drop (and release) the entries that expired
+ *
+ * @param map Map
+ * @return Number of expired entries
+ */
+size_t ttl_map_expire(ttl_map* map);
+
+/**
+ * Get number of entries in map
+ *
+ * @param map Map
+ * @return Number of entries
+ */
+size_t ttl_map_size(ttl_map* map);
+
+/**
+ * Destroy map, releasing all entries
+ *
+ * @param map Map
+ * @return 0 on success, -1 on failure
+ */
+int ttl_map_destroy(ttl_map* map);
+
+#endif
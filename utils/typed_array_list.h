@@ -0,0 +1,210 @@
+#ifndef __TYPED_ARRAY_LIST_H__
+#define __TYPED_ARRAY_LIST_H__
+
+/**
+ * Type-specialized array list (header-only)
+ *
+ * DECLARE_ARRAY_LIST(name, T) generates an array list type "name" that
+ * stores values of type T by value in a contiguous array, along with
+ * static inline name_* functions operating on it. Unlike array_list,
+ * values don't need to be allocated separately and every access compiles
+ * down to plain array indexing.
+ *
+ * Example:
+ *
+ *     DECLARE_ARRAY_LIST(u32_list, uint32_t)
+ *
+ *     u32_list lst;
+ *     u32_list_init(&lst, 16);
+ *     u32_list_push_tail(&lst, 42);
+ *     uint32_t* p_value = u32_list_get_at(&lst, 0);
+ *     u32_list_destroy(&lst);
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DECLARE_ARRAY_LIST(name, T)                                            \
+                                                                               \
+typedef struct name {                                                          \
+    size_t size;                                                               \
+    size_t capacity;                                                           \
+    T* array;                                                                  \
+} name;                                                                        \
+                                                                               \
+/**                                                                            \
+ * Resize array list                                                           \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param capacity New capacity (at least the current size)                    \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_resize(name* lst, const size_t capacity) {            \
+    if (capacity < lst->size) {                                                \
+        fprintf(stderr, #name "_resize: capacity is less than size\n");        \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    T* new_array = realloc(lst->array, (capacity > 0 ? capacity : 1) * sizeof(T)); \
+    if (new_array == NULL) {                                                   \
+        perror(#name "_resize: realloc() failed");                             \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    lst->array = new_array;                                                    \
+    lst->capacity = capacity;                                                  \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Initialize array list                                                       \
+ *                                                                             \
+ * @param lst Empty list to initialize                                         \
+ * @param capacity Initial capacity                                            \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_init(name* lst, const size_t capacity) {              \
+    lst->size = 0;                                                             \
+    lst->capacity = 0;                                                         \
+    lst->array = NULL;                                                         \
+                                                                               \
+    return name##_resize(lst, capacity);                                       \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Make room for one more value, doubling the capacity if needed               \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_grow(name* lst) {                                     \
+    if (lst->size < lst->capacity) {                                           \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    return name##_resize(lst, lst->capacity > 0 ? lst->capacity * 2 : 4);      \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Get value at position in array list                                         \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param pos Position to get value at                                         \
+ * @return Pointer to value (or NULL if out of bounds)                         \
+ */                                                                            \
+static inline T* name##_get_at(const name* lst, const size_t pos) {            \
+    if (pos >= lst->size) {                                                    \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    return &lst->array[pos];                                                   \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Insert value into array list at position                                    \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param value Value to insert                                                \
+ * @param pos Position to insert at (at most the size of the list)             \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_insert_at(name* lst, const T value, const size_t pos) { \
+    if (pos > lst->size || name##_grow(lst) != 0) {                            \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    memmove(&lst->array[pos + 1], &lst->array[pos], (lst->size - pos) * sizeof(T)); \
+    lst->array[pos] = value;                                                   \
+    ++lst->size;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Delete value at position in array list                                      \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param pos Position to delete at                                            \
+ * @param p_value Output deleted value (or NULL)                               \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_del_at(name* lst, const size_t pos, T* p_value) {     \
+    if (pos >= lst->size) {                                                    \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    if (p_value != NULL) {                                                     \
+        *p_value = lst->array[pos];                                            \
+    }                                                                          \
+                                                                               \
+    --lst->size;                                                               \
+    memmove(&lst->array[pos], &lst->array[pos + 1], (lst->size - pos) * sizeof(T)); \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Push value to tail of array list (append)                                   \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param value Value                                                          \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_push_tail(name* lst, const T value) {                 \
+    if (name##_grow(lst) != 0) {                                               \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    lst->array[lst->size++] = value;                                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Pop last (tail) value from array list                                       \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @param p_value Output popped value (or NULL)                                \
+ * @return 0 on success, -1 if empty                                           \
+ */                                                                            \
+static inline int name##_pop_tail(name* lst, T* p_value) {                     \
+    if (lst->size == 0) {                                                      \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    --lst->size;                                                               \
+    if (p_value != NULL) {                                                     \
+        *p_value = lst->array[lst->size];                                      \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Get number of values in array list                                          \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @return Number of values                                                    \
+ */                                                                            \
+static inline size_t name##_size(const name* lst) {                            \
+    return lst->size;                                                          \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Destroy array list                                                          \
+ *                                                                             \
+ * @param lst Array list                                                       \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_destroy(name* lst) {                                  \
+    free(lst->array);                                                          \
+    lst->array = NULL;                                                         \
+    lst->size = 0;                                                             \
+    lst->capacity = 0;                                                         \
+                                                                               \
+    return 0;                                                                  \
+}
+
+#endif
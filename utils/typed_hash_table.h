@@ -0,0 +1,362 @@
+#ifndef __TYPED_HASH_TABLE_H__
+#define __TYPED_HASH_TABLE_H__
+
+/**
+ * Type-specialized hash table (header-only)
+ *
+ * DECLARE_HASH_TABLE(name, K, V, hash_fn, eq_fn) generates an open
+ * addressing hash table type "name" that maps keys of type K to values of
+ * type V, both stored inline in its slot array, along with static inline
+ * name_* functions operating on it.
+ *
+ * hash_fn(key) must return a uint32_t hash of a K, and eq_fn(key_a, key_b)
+ * must return non-zero if two keys are equal. Both are called directly
+ * (they may also be function-like macros), so the compiler can inline them
+ * into every lookup instead of calling through hash_table's function pointers.
+ *
+ * Example:
+ *
+ *     #define u32_eq(a, b) ((a) == (b))
+ *     DECLARE_HASH_TABLE(ip_table, uint32_t, uint64_t, typed_hash_u32, u32_eq)
+ *
+ *     ip_table ht;
+ *     ip_table_init(&ht, 64);
+ *     ip_table_set(&ht, addr, 1);
+ *     uint64_t* p_value = ip_table_get(&ht, addr);
+ *     ip_table_destroy(&ht);
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Control byte: slot has never been used (ends a probe sequence)
+ */
+#define TYPED_HASH_TABLE_EMPTY 0
+
+/**
+ * Control byte: slot held an entry that was deleted (tombstone)
+ */
+#define TYPED_HASH_TABLE_DELETED 1
+
+/**
+ * Hash a 32-bit integer key (murmur3 32-bit finalizer)
+ *
+ * @param key Key
+ * @return Hash value
+ */
+static inline uint32_t typed_hash_u32(uint32_t key) {
+    key ^= key >> 16;
+    key *= 0x85ebca6b;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35;
+    key ^= key >> 16;
+
+    return key;
+}
+
+/**
+ * Hash a 64-bit integer key (murmur3 64-bit finalizer)
+ *
+ * @param key Key
+ * @return Hash value
+ */
+static inline uint32_t typed_hash_u64(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+
+    return (uint32_t)key;
+}
+
+/**
+ * Control byte of an occupied slot: the high bit is set, and the low 7 bits
+ * hold the low bits of the hash so most mismatching keys are never compared
+ *
+ * @param hash Hash value
+ * @return Control byte
+ */
+static inline uint8_t typed_hash_table_tag(const uint32_t hash) {
+    return 0x80 | (hash & 0x7F);
+}
+
+#define DECLARE_HASH_TABLE(name, K, V, hash_fn, eq_fn)                         \
+                                                                               \
+typedef struct name##_entry {                                                  \
+    K key;                                                                     \
+    V value;                                                                   \
+} name##_entry;                                                                \
+                                                                               \
+typedef struct name {                                                          \
+    /**                                                                        \
+     * Number of slots (always a power of 2)                                   \
+     */                                                                        \
+    size_t capacity;                                                           \
+                                                                               \
+    /**                                                                        \
+     * Number of stored entries                                                \
+     */                                                                        \
+    size_t size;                                                               \
+                                                                               \
+    /**                                                                        \
+     * Number of deleted slots that have not been reclaimed yet                \
+     */                                                                        \
+    size_t tombstones;                                                         \
+                                                                               \
+    /**                                                                        \
+     * Control bytes (one per slot): empty, deleted, or the tag of the key     \
+     */                                                                        \
+    uint8_t* ctrl;                                                             \
+                                                                               \
+    /**                                                                        \
+     * Slot array                                                              \
+     */                                                                        \
+    name##_entry* entries;                                                     \
+} name;                                                                        \
+                                                                               \
+/**                                                                            \
+ * Allocate empty slot and control byte arrays                                 \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param size Requested number of slots (rounded up to a power of 2)          \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_alloc(name* ht, const size_t size) {                  \
+    size_t capacity = 8;                                                       \
+    while (capacity < size) {                                                  \
+        capacity <<= 1;                                                        \
+    }                                                                          \
+                                                                               \
+    ht->ctrl = calloc(capacity, 1);                                            \
+    ht->entries = malloc(capacity * sizeof(name##_entry));                     \
+    if (ht->ctrl == NULL || ht->entries == NULL) {                             \
+        perror(#name "_alloc: malloc() failed");                               \
+        free(ht->ctrl);                                                        \
+        free(ht->entries);                                                     \
+        ht->ctrl = NULL;                                                       \
+        ht->entries = NULL;                                                    \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    ht->capacity = capacity;                                                   \
+    ht->size = 0;                                                              \
+    ht->tombstones = 0;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Initialize hash table                                                       \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param size Initial number of slots (rounded up to a power of 2, minimum 8) \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_init(name* ht, const size_t size) {                   \
+    return name##_alloc(ht, size);                                             \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Find the slot holding a key                                                 \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param key Key to find                                                      \
+ * @param hash Hash of key                                                     \
+ * @return Slot index (or -1 if not found)                                     \
+ */                                                                            \
+static inline size_t name##_find(const name* ht, const K key, const uint32_t hash) { \
+    const size_t mask = ht->capacity - 1;                                      \
+    const uint8_t tag = typed_hash_table_tag(hash);                            \
+                                                                               \
+    for (size_t slot = (hash >> 7) & mask;; slot = (slot + 1) & mask) {        \
+        const uint8_t ctrl = ht->ctrl[slot];                                   \
+        if (ctrl == tag && eq_fn(ht->entries[slot].key, key)) {                \
+            return slot;                                                       \
+        }                                                                      \
+                                                                               \
+        if (ctrl == TYPED_HASH_TABLE_EMPTY) {                                  \
+            return -1;                                                         \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Find the first empty or deleted slot in the probe sequence of a hash        \
+ *                                                                             \
+ * @param ht Hash table (must have at least one free slot)                     \
+ * @param hash Hash value                                                      \
+ * @return Slot index                                                          \
+ */                                                                            \
+static inline size_t name##_find_free(const name* ht, const uint32_t hash) {   \
+    const size_t mask = ht->capacity - 1;                                      \
+                                                                               \
+    size_t slot = (hash >> 7) & mask;                                          \
+    while (ht->ctrl[slot] & 0x80) {                                            \
+        slot = (slot + 1) & mask;                                              \
+    }                                                                          \
+                                                                               \
+    return slot;                                                               \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Resize the slot array and reinsert all entries                              \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param new_size Requested number of slots (rounded up to a power of 2)      \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_rehash(name* ht, const size_t new_size) {             \
+    name old = *ht;                                                            \
+                                                                               \
+    if (new_size < old.size + old.size / 4 + 1 || name##_alloc(ht, new_size) != 0) { \
+        *ht = old;                                                             \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    for (size_t i = 0; i < old.capacity; ++i) {                                \
+        if (old.ctrl[i] & 0x80) {                                              \
+            const uint32_t hash = hash_fn(old.entries[i].key);                 \
+            const size_t slot = name##_find_free(ht, hash);                    \
+            ht->ctrl[slot] = typed_hash_table_tag(hash);                       \
+            ht->entries[slot] = old.entries[i];                                \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    ht->size = old.size;                                                       \
+    free(old.ctrl);                                                            \
+    free(old.entries);                                                         \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Set value in hash table, replacing the value of an existing key             \
+ * The table grows once 7/8 of its slots are occupied or deleted               \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param key Key                                                              \
+ * @param value Value                                                          \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_set(name* ht, const K key, const V value) {           \
+    const uint32_t hash = hash_fn(key);                                        \
+                                                                               \
+    size_t slot = name##_find(ht, key, hash);                                  \
+    if (slot != -1) {                                                          \
+        ht->entries[slot].value = value;                                       \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    if (ht->size + ht->tombstones >= ht->capacity - ht->capacity / 8) {        \
+        /* Rehash at the same size when most of the load is tombstones */      \
+        const size_t new_size = ht->size < ht->capacity / 2 ? ht->capacity : ht->capacity * 2; \
+        if (name##_rehash(ht, new_size) != 0) {                                \
+            return -1;                                                         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    slot = name##_find_free(ht, hash);                                         \
+    if (ht->ctrl[slot] == TYPED_HASH_TABLE_DELETED) {                          \
+        --ht->tombstones;                                                      \
+    }                                                                          \
+                                                                               \
+    ht->ctrl[slot] = typed_hash_table_tag(hash);                               \
+    ht->entries[slot].key = key;                                               \
+    ht->entries[slot].value = value;                                           \
+    ++ht->size;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Get value from hash table                                                   \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param key Key to get value for                                             \
+ * @return Pointer to value, valid until the next set (or NULL if not found)   \
+ */                                                                            \
+static inline V* name##_get(const name* ht, const K key) {                     \
+    const size_t slot = name##_find(ht, key, hash_fn(key));                    \
+    if (slot == -1) {                                                          \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    return &ht->entries[slot].value;                                           \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Delete entry from hash table                                                \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param key Key to delete                                                    \
+ * @return 0 on success, -1 if not found                                       \
+ */                                                                            \
+static inline int name##_del(name* ht, const K key) {                          \
+    const size_t slot = name##_find(ht, key, hash_fn(key));                    \
+    if (slot == -1) {                                                          \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    /* Keep probe sequences that pass through this slot intact */              \
+    ht->ctrl[slot] = TYPED_HASH_TABLE_DELETED;                                 \
+    ++ht->tombstones;                                                          \
+    --ht->size;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Iterate entries                                                             \
+ * Entries may be deleted while iterating, but not added                       \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @param p_pos Iteration position (set to 0 before the first call)            \
+ * @return Next entry (or NULL when done)                                      \
+ */                                                                            \
+static inline name##_entry* name##_next(const name* ht, size_t* p_pos) {       \
+    for (; *p_pos < ht->capacity; ++*p_pos) {                                  \
+        if (ht->ctrl[*p_pos] & 0x80) {                                         \
+            return &ht->entries[(*p_pos)++];                                   \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Get number of entries in hash table                                         \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @return Number of entries                                                   \
+ */                                                                            \
+static inline size_t name##_size(const name* ht) {                             \
+    return ht->size;                                                           \
+}                                                                              \
+                                                                               \
+/**                                                                            \
+ * Destroy hash table                                                          \
+ *                                                                             \
+ * @param ht Hash table                                                        \
+ * @return 0 on success, -1 on failure                                         \
+ */                                                                            \
+static inline int name##_destroy(name* ht) {                                   \
+    if (ht->ctrl == NULL) {                                                    \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    free(ht->ctrl);                                                            \
+    free(ht->entries);                                                         \
+    ht->ctrl = NULL;                                                           \
+    ht->entries = NULL;                                                        \
+    ht->capacity = 0;                                                          \
+    ht->size = 0;                                                              \
+    ht->tombstones = 0;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}
+
+#endif
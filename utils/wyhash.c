@@ -0,0 +1,288 @@
+#include <string.h>
+
+#include "wyhash.h"
+
+/**
+ * Default secret
+ */
+static const uint64_t secret[4] = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL
+};
+
+/**
+ * Multiply two 64-bit values into a 128-bit result
+ *
+ * @param a Input value and output low 64 bits
+ * @param b Input value and output high 64 bits
+ */
+static void wymum(uint64_t* a, uint64_t* b) {
+    const __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+}
+
+/**
+ * Mix two 64-bit values
+ *
+ * @param a First value
+ * @param b Second value
+ * @return Mixed value
+ */
+static uint64_t wymix(uint64_t a, uint64_t b) {
+    wymum(&a, &b);
+    return a ^ b;
+}
+
+static uint64_t wyr8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t wyr4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * Read 1 to 3 bytes
+ *
+ * @param p Bytes
+ * @param k Number of bytes
+ * @return Value
+ */
+static uint64_t wyr3(const uint8_t* p, const size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+/**
+ * Mix the last block and length into the hash
+ *
+ * @param a First half of last block
+ * @param b Second half of last block
+ * @param seed Hash of previous blocks
+ * @param len Size of key
+ * @return Hash value
+ */
+static uint64_t wyfinal(uint64_t a, uint64_t b, const uint64_t seed, const size_t len) {
+    a ^= secret[1];
+    b ^= seed;
+    wymum(&a, &b);
+
+    return wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+uint64_t wyhash(const void* key, const size_t len, uint64_t seed) {
+    const uint8_t* p = key;
+    uint64_t a, b;
+
+    seed ^= wymix(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+            b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0) {
+            a = wyr3(p, len);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = len;
+
+        if (i >= 48) {
+            // Three independent lanes
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+
+            do {
+                seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+                see1 = wymix(wyr8(p + 16) ^ secret[2], wyr8(p + 24) ^ see1);
+                see2 = wymix(wyr8(p + 32) ^ secret[3], wyr8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            }
+            while (i >= 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        // Last 16 bytes (may overlap the previous block)
+        a = wyr8(p + i - 16);
+        b = wyr8(p + i - 8);
+    }
+
+    return wyfinal(a, b, seed, len);
+}
+
+/**
+ * Word-at-a-time reader of a NUL-terminated string
+ */
+typedef struct str_reader {
+    /**
+     * Next aligned word to load
+     */
+    const uint8_t* p;
+
+    /**
+     * Last loaded word
+     */
+    uint64_t cur;
+
+    /**
+     * Misalignment of the string in bits (0-56)
+     */
+    unsigned int shift;
+} str_reader;
+
+/**
+ * Flag zero bytes of a word
+ * The lowest flagged byte is always the first zero byte
+ *
+ * @param v Word
+ * @return Mask with the high bit of zero bytes set
+ */
+static uint64_t zero_bytes(const uint64_t v) {
+    return (v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL;
+}
+
+/**
+ * Keep the low bytes of a word
+ *
+ * @param v Word
+ * @param n Number of bytes to keep (0-7)
+ * @return Masked word
+ */
+static uint64_t low_bytes(const uint64_t v, const size_t n) {
+    return v & ((1ULL << (8 * n)) - 1);
+}
+
+/**
+ * Load an aligned word
+ * The word may extend past the end of the string, but never into another
+ * page, so this is safe even though sanitizers can't tell
+ *
+ * @param p Aligned pointer
+ * @return Word
+ */
+__attribute__((no_sanitize("address", "thread")))
+static uint64_t load_aligned(const uint8_t* p) {
+    return *(const uint64_t *)__builtin_assume_aligned(p, sizeof(uint64_t));
+}
+
+/**
+ * Start reading a string
+ *
+ * @param reader Reader
+ * @param str String
+ */
+static void str_reader_init(str_reader* reader, const char* str) {
+    const size_t off = (uintptr_t)str & (sizeof(uint64_t) - 1);
+
+    reader->p = (const uint8_t *)str - off;
+    reader->shift = 8 * off;
+    reader->cur = 0;
+
+    if (off != 0) {
+        reader->cur = load_aligned(reader->p);
+        reader->p += sizeof(uint64_t);
+    }
+}
+
+/**
+ * Read the next 8 bytes of a string, stopping at its terminator
+ *
+ * @param reader Reader
+ * @param n Output number of bytes read (less than 8 if the string ended)
+ * @return Bytes read (little-endian, zero padded)
+ */
+static inline __attribute__((always_inline)) uint64_t str_reader_next(str_reader* reader, size_t* n) {
+    if (reader->shift == 0) {
+        const uint64_t v = load_aligned(reader->p);
+        const uint64_t zero = zero_bytes(v);
+        reader->p += sizeof(uint64_t);
+
+        if (zero != 0) {
+            *n = __builtin_ctzll(zero) / 8;
+            return low_bytes(v, *n);
+        }
+
+        *n = 8;
+        return v;
+    }
+
+    // Bytes before the string (or already read) must not be taken as its terminator
+    const uint64_t zero = zero_bytes(reader->cur | ((1ULL << reader->shift) - 1));
+    if (zero != 0) {
+        *n = (__builtin_ctzll(zero) - reader->shift) / 8;
+        return low_bytes(reader->cur >> reader->shift, *n);
+    }
+
+    const uint64_t next = load_aligned(reader->p);
+    const uint64_t v = reader->cur >> reader->shift | next << (64 - reader->shift);
+    const uint64_t next_zero = zero_bytes(next);
+    reader->p += sizeof(uint64_t);
+    reader->cur = next;
+
+    *n = 8;
+    if (next_zero != 0) {
+        const size_t read = (64 - reader->shift + __builtin_ctzll(next_zero)) / 8;
+        if (read < 8) {
+            *n = read;
+            return low_bytes(v, read);
+        }
+    }
+
+    return v;
+}
+
+uint64_t wyhash_str(const char* str, uint64_t seed) {
+    str_reader reader;
+    size_t len = 0;
+    size_t n;
+
+    seed ^= wymix(seed ^ secret[0], secret[1]);
+    str_reader_init(&reader, str);
+
+    uint64_t a = str_reader_next(&reader, &n);
+    len += n;
+    if (n < 8) {
+        return wyfinal(a, 0, seed, len);
+    }
+
+    for (;;) {
+        const uint64_t b = str_reader_next(&reader, &n);
+        len += n;
+        if (n < 8) {
+            return wyfinal(a, b, seed, len);
+        }
+
+        const uint64_t next_a = str_reader_next(&reader, &n);
+        len += n;
+        if (n == 0) {
+            // Keep the last full block for wyfinal(), like wyhash does
+            return wyfinal(a, b, seed, len);
+        }
+
+        seed = wymix(a ^ secret[1], b ^ seed);
+        a = next_a;
+
+        if (n < 8) {
+            return wyfinal(a, 0, seed, len);
+        }
+    }
+}
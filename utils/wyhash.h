@@ -0,0 +1,36 @@
+#ifndef __WYHASH_H__
+#define __WYHASH_H__
+
+/**
+ * wyhash (final version 4)
+ *
+ * Hashes 16 or 48 bytes at a time with 64x64 => 128 bit multiplications,
+ * which makes it several times faster than murmur3 on long keys while still
+ * passing SMHasher.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * wyhash with the default secret
+ *
+ * @param key Key to hash
+ * @param len Size of key
+ * @param seed Seed
+ * @return Hash value
+ */
+uint64_t wyhash(const void* key, size_t len, uint64_t seed);
+
+/**
+ * wyhash-style hash of a NUL-terminated string, in a single pass
+ * Blocks are mixed like wyhash as they are read, so strlen() isn't needed
+ * first. This is NOT the same value as wyhash(str, strlen(str), seed).
+ *
+ * @param str String to hash
+ * @param seed Seed
+ * @return Hash value
+ */
+uint64_t wyhash_str(const char* str, uint64_t seed);
+
+#endif